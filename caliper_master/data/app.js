@@ -4,6 +4,9 @@ function showView(viewId) {
         view.classList.add('hidden');
     });
     document.getElementById(viewId + '-view').classList.remove('hidden');
+    if (viewId !== 'measurement' && liveTimer !== null) {
+        stopLive();
+    }
 }
 
 // Calibration functions
@@ -152,6 +155,8 @@ function measureSession() {
             document.getElementById('measurement-reference').textContent = 'No data';
             document.getElementById('battery').textContent = 'No data';
             document.getElementById('angle-z').textContent = 'No data';
+            document.getElementById('vibration').textContent = 'No data';
+            document.getElementById('settle-time').textContent = 'No data';
             document.getElementById('status').textContent = 'No fresh data (no response from device).';
             return;
         }
@@ -188,9 +193,106 @@ function measureSession() {
             ? angleZ.toFixed(2)
             : data.angleZ;
 
+        const vibration = Number(data.vibrationRms);
+        document.getElementById('vibration').textContent = Number.isFinite(vibration) && vibration > 0
+            ? vibration + ' mg RMS'
+            : 'No data';
+
+        const settleMs = Number(data.settleMs);
+        document.getElementById('settle-time').textContent = Number.isFinite(settleMs) && settleMs > 0
+            ? settleMs + ' ms'
+            : 'No data';
+
         document.getElementById('status').textContent = 'Updated: ' + new Date().toLocaleTimeString();
     })
     .catch(error => {
         document.getElementById('status').textContent = 'Error: ' + error.message;
     });
 }
+
+// Live feed
+// POST /api/stream/start subscribes the master to slave telemetry; the page
+// polls GET /api/stream?since=<seq> and shows the newest sample. The master
+// renews the subscription itself, so closing the page without "Stop" leaves
+// it running until stopped from here, Serial ('l 0') or a master reset.
+const LIVE_PERIOD_MS = 100;
+const LIVE_POLL_MS = 250;
+let liveTimer = null;
+let liveSeq = 0;
+
+function toggleLive() {
+    if (liveTimer !== null) {
+        stopLive();
+    } else {
+        startLive();
+    }
+}
+
+function startLive() {
+    fetch('/api/stream/start?period=' + LIVE_PERIOD_MS, { method: 'POST' })
+    .then(response => response.json())
+    .then(data => {
+        if (!data.success) {
+            throw new Error(data.error || 'Server error');
+        }
+        liveSeq = Number(data.seq) || 0;
+        liveTimer = setInterval(pollLive, LIVE_POLL_MS);
+        document.getElementById('live-button').textContent = 'Stop Live';
+        document.getElementById('status').textContent = 'Live feed every ' + data.periodMs + ' ms';
+    })
+    .catch(error => {
+        document.getElementById('status').textContent = 'Error: ' + error.message;
+    });
+}
+
+function stopLive() {
+    clearInterval(liveTimer);
+    liveTimer = null;
+    document.getElementById('live-button').textContent = 'Live';
+    fetch('/api/stream/stop', { method: 'POST' })
+    .then(() => {
+        document.getElementById('status').textContent = 'Live feed stopped';
+    })
+    .catch(error => {
+        document.getElementById('status').textContent = 'Error: ' + error.message;
+    });
+}
+
+function pollLive() {
+    fetch('/api/stream?since=' + liveSeq)
+    .then(response => response.json())
+    .then(data => {
+        liveSeq = Number(data.seq) || liveSeq;
+        if (!Array.isArray(data.samples) || data.samples.length === 0) {
+            return;
+        }
+
+        // [seq, slave ms, raw mm, angleZ, status]; status 0 = valid
+        const [, , raw, angleZ, status] = data.samples[data.samples.length - 1];
+        const offset = Number(data.calibrationOffset);
+        const ref = Number(data.reference);
+        if (status === 0 && Number.isFinite(raw)) {
+            const corrected = raw - (Number.isFinite(offset) ? offset : 0) + (Number.isFinite(ref) ? ref : 0);
+            document.getElementById('measurement-value').textContent = corrected.toFixed(3) + ' mm';
+            document.getElementById('measurement-raw').textContent = raw.toFixed(3) + ' mm';
+        } else {
+            document.getElementById('measurement-value').textContent = 'No data';
+            document.getElementById('measurement-raw').textContent = 'No data';
+        }
+        document.getElementById('angle-z').textContent = angleZ;
+
+        const batt = Number(data.batteryVoltage);
+        if (Number.isFinite(batt) && batt > 0) {
+            document.getElementById('battery').textContent = batt.toFixed(3) + ' V';
+        }
+
+        let text = 'Live: ' + new Date().toLocaleTimeString();
+        if (data.lostPackets > 0 || data.droppedSamples > 0) {
+            text += ' (lost packets: ' + data.lostPackets + ', dropped samples: ' + data.droppedSamples + ')';
+        }
+        document.getElementById('status').textContent = text;
+    })
+    .catch(error => {
+        document.getElementById('status').textContent = 'Error: ' + error.message;
+    });
+}
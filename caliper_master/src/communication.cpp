@@ -3,20 +3,44 @@
  * @brief ESP-NOW Communication Module Implementation
  * @author System Generated
  * @date 2025-11-30
- * @version 2.1
+ * @version 2.3
  *
  * @version 2.0 - Integrated comprehensive error code system
  * @version 2.1 - Refactored to use shared espnow_send_with_retry function
+ * @version 2.2 - Protocol v2 towards the slave, probed on init and re-pairing
+ * @version 2.3 - slaveWire under wireMutex (loop() and the receive callback),
+ *                v2 re-probed during the v1 fallback
  */
 
 #include "communication.h"
 #include <espnow_helper.h>
 
-CommunicationManager::CommunicationManager() : initialized(false), lastError(ERR_NONE)
+CommunicationManager::CommunicationManager()
+  : wireMutex(nullptr), initialized(false), lastError(ERR_NONE)
 {
   // Initialize with default values
   memset(slaveAddress, 0, 6);
   memset(&peerInfo, 0, sizeof(peerInfo));
+  wire_peer_reset(slaveWire, WIRE_VERSION);
+}
+
+/**
+ * @brief Take wireMutex (no-op before initialize(): nothing runs concurrently yet)
+ */
+void CommunicationManager::lockWire() const
+{
+  if (wireMutex != nullptr)
+  {
+    xSemaphoreTake(wireMutex, portMAX_DELAY);
+  }
+}
+
+void CommunicationManager::unlockWire() const
+{
+  if (wireMutex != nullptr)
+  {
+    xSemaphoreGive(wireMutex);
+  }
 }
 
 ErrorCode CommunicationManager::initialize(const uint8_t *slaveAddr)
@@ -28,6 +52,17 @@ ErrorCode CommunicationManager::initialize(const uint8_t *slaveAddr)
     return lastError;
   }
 
+  if (wireMutex == nullptr)
+  {
+    wireMutex = xSemaphoreCreateMutex();
+    if (wireMutex == nullptr)
+    {
+      RECORD_ERROR(ERR_SYSTEM_MEMORY_ALLOC_FAILED, "Protocol state mutex could not be created");
+      lastError = ERR_SYSTEM_MEMORY_ALLOC_FAILED;
+      return lastError;
+    }
+  }
+
   // Copy slave address
   memcpy(slaveAddress, slaveAddr, 6);
 
@@ -53,6 +88,11 @@ ErrorCode CommunicationManager::initialize(const uint8_t *slaveAddr)
     return lastError;
   }
 
+  // Probe v2; an old slave ignores it and wire_peer_no_reply() falls back to v1
+  lockWire();
+  wire_peer_reset(slaveWire, WIRE_VERSION);
+  unlockWire();
+
   DEBUG_I("Slave peer dodany: %02X:%02X:%02X:%02X:%02X:%02X",
     slaveAddress[0], slaveAddress[1], slaveAddress[2], slaveAddress[3], slaveAddress[4], slaveAddress[5]);
 
@@ -70,11 +110,24 @@ ErrorCode CommunicationManager::sendMessage(const MessageMaster &message, int re
     return lastError;
   }
 
-  // Use shared retry function for consistent behavior
+  // v2 frame or bare v1 struct, depending on what the slave speaks; only
+  // the encoding holds the mutex, the retries of the send do not
+  uint8_t frame[WIRE_MAX_FRAME_SIZE];
+  lockWire();
+  wire_peer_request(slaveWire);
+  const size_t frameLen = wire_encode(slaveWire, WIRE_MASTER, 0, &message, frame);
+  unlockWire();
+
+  if (frameLen == 0)
+  {
+    lastError = ERR_VALIDATION_INVALID_PARAM;
+    return lastError;
+  }
+
   ErrorCode result = espnow_send_with_retry(
       slaveAddress,
-      &message,
-      sizeof(message),
+      frame,
+      frameLen,
       retryCount,
       ESPNOW_RETRY_DELAY_MS
   );
@@ -83,6 +136,29 @@ ErrorCode CommunicationManager::sendMessage(const MessageMaster &message, int re
   return result;
 }
 
+bool CommunicationManager::acceptSlaveFrame(const WireFrame &frame)
+{
+  lockWire();
+  const bool accepted = wire_peer_accept(slaveWire, frame.version, frame.sequence);
+  unlockWire();
+  return accepted;
+}
+
+void CommunicationManager::noteNoReply()
+{
+  lockWire();
+  wire_peer_no_reply(slaveWire);
+  unlockWire();
+}
+
+uint8_t CommunicationManager::getSlaveProtocolVersion() const
+{
+  lockWire();
+  const uint8_t version = slaveWire.version;
+  unlockWire();
+  return version;
+}
+
 void CommunicationManager::setReceiveCallback(esp_now_recv_cb_t callback)
 {
   if (initialized && callback)
@@ -126,6 +202,10 @@ ErrorCode CommunicationManager::updatePeerAddress(const uint8_t *newAddr)
     return lastError;
   }
 
+  lockWire();
+  wire_peer_reset(slaveWire, WIRE_VERSION);
+  unlockWire();
+
   DEBUG_I("CommunicationManager: Updated slave peer to %02X:%02X:%02X:%02X:%02X:%02X",
     slaveAddress[0], slaveAddress[1], slaveAddress[2], slaveAddress[3], slaveAddress[4], slaveAddress[5]);
   lastError = ERR_NONE;
@@ -3,9 +3,11 @@
  * @brief ESP-NOW Communication Module Header
  * @author System Generated
  * @date 2025-11-30
- * @version 2.0
+ * @version 2.2
  *
  * @version 2.0 - Integrated comprehensive error code system
+ * @version 2.1 - Messages to the slave go through wire_protocol.h
+ * @version 2.2 - slaveWire guarded by a mutex
  */
 
 #ifndef COMMUNICATION_H
@@ -14,17 +16,24 @@
 #include "config.h"
 #include <shared_common.h>
 #include <error_handler.h>
+#include <wire_protocol.h>
 #include <esp_now.h>
 #include <WiFi.h>
+#include <freertos/semphr.h>
 
 class CommunicationManager
 {
 private:
   uint8_t slaveAddress[6];
   esp_now_peer_info_t peerInfo;
+  WirePeer slaveWire;           /**< Used by loop() and the ESP-NOW receive callback, guarded by wireMutex */
+  SemaphoreHandle_t wireMutex;  /**< Created by initialize(), before the receive callback is registered */
   bool initialized;
   ErrorCode lastError;
 
+  void lockWire() const;
+  void unlockWire() const;
+
 public:
   CommunicationManager();
 
@@ -50,6 +59,22 @@ public:
    */
   ErrorCode sendMessage(const MessageMaster &message, int retryCount = ESPNOW_MAX_RETRIES);
 
+  /**
+   * @brief Record a frame received from the slave (see wire_peer_accept)
+   * @return false if the frame repeats the previous one and must be dropped
+   */
+  bool acceptSlaveFrame(const WireFrame &frame);
+
+  /**
+   * @brief A request to the slave timed out (v2 probing falls back to v1)
+   */
+  void noteNoReply();
+
+  /**
+   * @brief Protocol version used towards the slave
+   */
+  uint8_t getSlaveProtocolVersion() const;
+
   ErrorCode updatePeerAddress(const uint8_t *newAddr);
 
   ErrorCode addRcPeer(const uint8_t *rcAddr);
@@ -3,16 +3,20 @@
  * @brief Configuration file for ESP32 Caliper Master
  * @author System Generated
  * @date 2025-12-26
- * @version 2.0
+ * @version 2.1
  * 
  * This file contains Master-specific configuration.
  * Common settings are inherited from shared/config_base.h
+ *
+ * @version 2.1 - Includes Arduino.h only in target builds (host unit tests)
  */
 
 #ifndef CONFIG_MASTER_H
 #define CONFIG_MASTER_H
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#endif
 
 // Include shared base configuration
 #include <shared_config.h>
@@ -47,6 +51,23 @@
 #define WEB_SERVER_PORT 80
 #define HTML_BUFFER_SIZE 2048
 #define WEB_UPDATE_INTERVAL_MS 10
+#define BURST_JSON_BUFFER_SIZE 2048   // /api/burst: up to BURST_MAX_SAMPLES samples
+
+// ============================================================================
+// Telemetry Streaming (CMD_STREAM)
+// ============================================================================
+#define STREAM_HISTORY_SIZE 256        // Newest telemetry samples kept for web clients (power of two)
+#define STREAM_WEB_MAX_SAMPLES 64      // Samples per /api/stream response
+#define STREAM_JSON_BUFFER_SIZE 3072
+#define STREAM_SERIAL_MAX_PER_LOOP 32  // Samples forwarded to Serial per loop() pass
+#define STREAM_DEFAULT_PERIOD_MS 100
+#define STREAM_DEFAULT_BATCH 5
+
+// ============================================================================
+// Request/Reply Correlation (MessageMaster::requestId)
+// ============================================================================
+#define REQUEST_TRACKER_SLOTS 8         // Newest requests remembered to classify late replies
+#define REQUEST_STATS_LOG_INTERVAL 50   // Log reply counters and RTT every N answered requests (0 = never)
 
 // ============================================================================
 // Master-specific Settings
@@ -2,15 +2,18 @@
 #include <WiFi.h>
 #include <WebServer.h>
 #include <LittleFS.h>
+#include <stdarg.h>
 #include "config.h"
 #include <shared_common.h>
 #include <error_handler.h>
 #include <MacroDebugger.h>
 #include <arduino-timer.h>
+#include <overwrite_ring.h>
 #include "communication.h"
 #include "serial_cli.h"
 #include "preferences_manager.h"
 #include "measurement_state.h"
+#include "request_tracker.h"
 
 // Slave device MAC address (defined in config.h)
 uint8_t slaveAddress[] = SLAVE_MAC_ADDR;
@@ -23,6 +26,10 @@ static uint8_t pairedRcAddress[6] = {};
 static bool hasPairedRc = false;
 static volatile bool rcTrigMeasPending = false;
 static volatile bool rcDropMeasPending = false;
+// Protocol state of the RC (sequence deduplication; the RC only sends)
+static WirePeer rcWire;
+// CMD_PAIR broadcasts alternate v1 and v2, so slaves and RCs of either firmware pair
+static WirePeer pairBroadcastWire;
 // TODO: Print Master MAC Address
 WebServer server(WEB_SERVER_PORT);
 CommunicationManager commManager;
@@ -34,12 +41,47 @@ static constexpr uint8_t DEFAULT_MOTOR_SPEED = 100;
 static constexpr uint8_t DEFAULT_MOTOR_TORQUE = 100;
 static constexpr MotorState DEFAULT_MOTOR_STATE = MOTOR_STOP;
 static constexpr uint32_t DEFAULT_TIMEOUT_MS = 1000;
+static constexpr uint16_t DEFAULT_RAMP_UP_MS = 100;
+static constexpr uint16_t DEFAULT_RAMP_DOWN_MS = 100;
+static constexpr uint8_t DEFAULT_HOLD_PERCENT = 100;
 
 auto timerWorker = timer_create_default();
 
 // Measurement state - encapsulation instead of global variables
 static MeasurementState measurementState;
 
+// requestId of the requests sent to the slave, matched against its replies
+static RequestTracker requestTracker;
+
+// Reassembly of the MessageSlaveBurst frames of one burst (OnDataRecv)
+static uint8_t burstRxId = 0;          // requestId of the burst
+static uint8_t burstRxFrames = 0;      // Bit per received frameIndex
+static bool burstRxActive = false;
+static_assert((BURST_MAX_SAMPLES + BURST_SAMPLES_PER_FRAME - 1) / BURST_SAMPLES_PER_FRAME <= 8,
+  "burstRxFrames has one bit per frame");
+
+/**
+ * @brief One received telemetry sample
+ */
+struct StreamRecord
+{
+  float measurement;     /**< mm, INVALID_MEASUREMENT_VALUE unless status is CHANNEL_OK */
+  uint32_t timestampMs;  /**< Slave millis() at capture */
+  uint8_t angleZ;
+  uint8_t status;        /**< ChannelStatus */
+};
+
+// Telemetry (CMD_STREAM): OnDataRecv pushes, loop() and /api/stream read
+static OverwriteRing<StreamRecord, STREAM_HISTORY_SIZE> streamHistory;
+static volatile float streamBatteryVoltage = 0.0f;
+static volatile uint32_t streamLostPackets = 0;     // Gaps in MessageSlaveStream::sequence
+static volatile uint32_t streamDroppedSamples = 0;  // Discarded by the slave's flow control
+static volatile uint16_t streamNextSequence = 0;
+static volatile bool streamSequenceValid = false;
+static volatile bool streamSubscribed = false;
+static uint32_t streamRenewMs = 0;
+static uint32_t streamForwardedSeq = 0;             // Newest sample forwarded to Serial
+
 static void requestMeasurement();
 
 static void enterPairingMode()
@@ -79,52 +121,233 @@ static bool isMacUnset(const uint8_t mac[6])
   return true;
 }
 
+/**
+ * @brief snprintf() at buffer + used, for JSON built in several steps
+ * @return New length, clamped to size - 1 when the output is truncated
+ */
+static size_t appendf(char *buffer, size_t size, size_t used, const char *format, ...)
+{
+  if (used + 1 >= size) return used;
+  va_list args;
+  va_start(args, format);
+  const int n = vsnprintf(buffer + used, size - used, format, args);
+  va_end(args);
+  if (n < 0) return used;
+  return (used + (size_t)n < size) ? used + (size_t)n : size - 1;
+}
+
+/**
+ * @brief Match a slave reply with its request (OnDataRecv)
+ * @param requestId requestId echoed by the slave
+ * @param finalReply false for a burst frame before the last one
+ * @return false if the reply must be dropped (duplicate or stale)
+ */
+static bool acceptReply(uint8_t requestId, bool finalReply)
+{
+  uint32_t rttUs = 0;
+  switch (requestTracker.onReply(requestId, finalReply, rttUs))
+  {
+  case ReplyMatch::MATCHED:
+  case ReplyMatch::LEGACY:
+    return true;
+  case ReplyMatch::DUPLICATE:
+    DEBUG_W("Duplicate reply to request %u dropped", (unsigned)requestId);
+    return false;
+  default:
+    DEBUG_W("Stale reply to request %u dropped", (unsigned)requestId);
+    return false;
+  }
+}
+
 void OnDataRecv(const esp_now_recv_info_t *recv_info, const uint8_t *incomingData, int len)
 {
   uint8_t src_addr[6];
   memcpy(src_addr, recv_info->src_addr, 6);
 
-  if (len == sizeof(MessageSlave))
+  // v2 header + CRC, or a bare v1 struct told apart by its length
+  WireFrame frame{};
+  if (wire_decode(incomingData, len, frame) != ERR_NONE)
   {
-    MessageSlave msg{};
-    memcpy(&msg, incomingData, sizeof(msg));
+    return;
+  }
 
-  if (rcTrigMeasPending)
+  const bool accepted = frame.type == WIRE_RC
+    ? wire_peer_accept(rcWire, frame.version, frame.sequence)
+    : commManager.acceptSlaveFrame(frame);
+  if (!accepted)
   {
-    rcTrigMeasPending = false;
-    DEBUG_I("RC command: R");
-    requestMeasurement();
+    DEBUG_W("Repeated frame %u (type %u) dropped", (unsigned)frame.sequence, (unsigned)frame.type);
+    return;
   }
 
-  if (rcDropMeasPending)
+  if (frame.type == WIRE_SLAVE)
   {
-    rcDropMeasPending = false;
-    DEBUG_I("RC: DROP_MEAS -> dropMeas:1");
-    DEBUG_PLOT("dropMeas:1");
-  }
+    MessageSlave msg{};
+    memcpy(&msg, frame.payload, frame.length);
 
-  if (pairingMode)
+    // The pairing response answers the CMD_PAIR broadcast, no measurement
+    if (msg.command == CMD_PAIR)
     {
-      commManager.updatePeerAddress(src_addr);
-      prefsManager.saveSlaveMac(src_addr);
-      memcpy(slaveAddress, src_addr, 6);
+      if (pairingMode)
+      {
+        commManager.updatePeerAddress(src_addr);
+        prefsManager.saveSlaveMac(src_addr);
+        memcpy(slaveAddress, src_addr, 6);
 
-      systemStatus.msgMaster.command = CMD_PAIR_ACK;
-      commManager.sendMessage(systemStatus.msgMaster);
+        systemStatus.msgMaster.command = CMD_PAIR_ACK;
+        commManager.sendMessage(systemStatus.msgMaster);
 
-      DEBUG_I("New Slave paired: %02X:%02X:%02X:%02X:%02X:%02X",
-        src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
+        DEBUG_I("New Slave paired: %02X:%02X:%02X:%02X:%02X:%02X",
+          src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
+      }
+      return;
+    }
+
+    if (!acceptReply(msg.requestId, true))
+    {
+      return;
     }
 
     systemStatus.msgSlave = msg;
+    systemStatus.msgSlaveMulti.channelCount = 0;
     measurementState.setMeasurement(systemStatus.msgSlave.measurement);
     measurementState.setBatteryVoltage(msg.batteryVoltage);
     measurementState.setReady(true);
   }
-  else if (len == sizeof(MessageRC))
+  else if (frame.type == WIRE_SLAVE_MULTI)
+  {
+    MessageSlaveMulti msg{};
+    memcpy(&msg, frame.payload, frame.length);
+
+    if (msg.channelCount > RS485_MAX_PROBES)
+    {
+      RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Multi-probe packet with %u channels (max %u)",
+        (unsigned)msg.channelCount, (unsigned)RS485_MAX_PROBES);
+      return;
+    }
+    if (!acceptReply(msg.requestId, true))
+    {
+      return;
+    }
+
+    // Channel 0 keeps the single-value paths (GUI, calibration, web) working
+    systemStatus.msgSlaveMulti = msg;
+    systemStatus.msgSlave.measurement = msg.measurement[0];
+    systemStatus.msgSlave.batteryVoltage = msg.batteryVoltage;
+    systemStatus.msgSlave.command = msg.command;
+    systemStatus.msgSlave.angleZ = msg.angleZ;
+    systemStatus.msgSlave.vibrationRms = msg.vibrationRms;
+    systemStatus.msgSlave.settleMs = msg.settleMs;
+    systemStatus.msgSlave.requestId = msg.requestId;
+    measurementState.setMeasurement(msg.measurement[0]);
+    measurementState.setBatteryVoltage(msg.batteryVoltage);
+    measurementState.setReady(true);
+  }
+  else if (frame.type == WIRE_SLAVE_BURST)
+  {
+    MessageSlaveBurst msg{};
+    memcpy(&msg, frame.payload, frame.length);
+
+    if (msg.totalSamples == 0 || msg.totalSamples > BURST_MAX_SAMPLES
+      || msg.sampleCount > BURST_SAMPLES_PER_FRAME
+      || (unsigned)msg.firstSample + msg.sampleCount > msg.totalSamples
+      || msg.frameIndex >= msg.frameCount
+      || msg.frameCount != (msg.totalSamples + BURST_SAMPLES_PER_FRAME - 1) / BURST_SAMPLES_PER_FRAME)
+    {
+      RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Burst frame %u/%u with samples %u+%u of %u",
+        (unsigned)msg.frameIndex, (unsigned)msg.frameCount, (unsigned)msg.firstSample,
+        (unsigned)msg.sampleCount, (unsigned)msg.totalSamples);
+      return;
+    }
+
+    // Frames of a timed-out burst are stale; the request stays in flight until the last frame
+    if (!acceptReply(msg.requestId, false))
+    {
+      return;
+    }
+
+    // A frame of another burst starts over (e.g. the rest of a timed-out one was lost)
+    if (!burstRxActive || msg.requestId != burstRxId)
+    {
+      burstRxActive = true;
+      burstRxId = msg.requestId;
+      burstRxFrames = 0;
+      systemStatus.burstCount = 0;
+    }
+
+    memcpy(&systemStatus.burst[msg.firstSample], msg.samples, msg.sampleCount * sizeof(BurstSample));
+    burstRxFrames |= (uint8_t)(1u << msg.frameIndex);
+    if (burstRxFrames != (uint8_t)((1u << msg.frameCount) - 1))
+    {
+      return;
+    }
+
+    // Last frame: the mean of the valid samples stands in for the single value
+    burstRxActive = false;
+    if (!acceptReply(msg.requestId, true))
+    {
+      return;
+    }
+    systemStatus.burstCount = msg.totalSamples;
+    float sum = 0.0f;
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < msg.totalSamples; i++)
+    {
+      if (systemStatus.burst[i].status == CHANNEL_OK)
+      {
+        sum += systemStatus.burst[i].measurement;
+        valid++;
+      }
+    }
+    systemStatus.msgSlave.measurement = valid ? sum / valid : INVALID_MEASUREMENT_VALUE;
+    systemStatus.msgSlave.batteryVoltage = msg.batteryVoltage;
+    systemStatus.msgSlave.command = msg.command;
+    systemStatus.msgSlave.angleZ = msg.angleZ;
+    systemStatus.msgSlave.vibrationRms = 0;
+    systemStatus.msgSlave.settleMs = 0;
+    systemStatus.msgSlave.requestId = msg.requestId;
+    systemStatus.msgSlaveMulti.channelCount = 0;
+    measurementState.setMeasurement(systemStatus.msgSlave.measurement);
+    measurementState.setBatteryVoltage(msg.batteryVoltage);
+    measurementState.setReady(true);
+  }
+  else if (frame.type == WIRE_SLAVE_STREAM)
+  {
+    MessageSlaveStream msg{};
+    memcpy(&msg, frame.payload, frame.length);
+
+    if (msg.sampleCount > STREAM_SAMPLES_PER_FRAME)
+    {
+      RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Telemetry packet with %u samples (max %u)",
+        (unsigned)msg.sampleCount, (unsigned)STREAM_SAMPLES_PER_FRAME);
+      return;
+    }
+    if (!streamSubscribed)
+    {
+      return; // in flight when the subscription ended
+    }
+
+    // Sequence restarts with every subscription (and after a slave reset)
+    const uint16_t gap = (uint16_t)(msg.sequence - streamNextSequence);
+    if (streamSequenceValid && gap != 0 && gap < 0x8000)
+    {
+      streamLostPackets += gap;
+    }
+    streamNextSequence = (uint16_t)(msg.sequence + 1);
+    streamSequenceValid = true;
+    streamDroppedSamples += msg.droppedSamples;
+    streamBatteryVoltage = msg.batteryVoltage;
+
+    for (uint8_t i = 0; i < msg.sampleCount; i++)
+    {
+      const StreamSample &sample = msg.samples[i];
+      streamHistory.push({sample.measurement, msg.firstTimestampMs + sample.offsetMs, sample.angleZ, sample.status});
+    }
+  }
+  else if (frame.type == WIRE_RC)
   {
     MessageRC msg{};
-    memcpy(&msg, incomingData, sizeof(msg));
+    memcpy(&msg, frame.payload, frame.length);
 
     if (pairingMode && msg.command == CMD_PAIR)
     {
@@ -160,7 +383,9 @@ void OnDataRecv(const esp_now_recv_info_t *recv_info, const uint8_t *incomingDat
   }
   else
   {
-    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Received packet length: %d, expected: %d (Slave) or %d (RC)", len, (int)sizeof(MessageSlave), (int)sizeof(MessageRC));
+    // MessageMaster, e.g. the pairing broadcast of another master
+    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Received message type %u, expected a Slave or RC message",
+      (unsigned)frame.type);
   }
 }
 
@@ -177,6 +402,16 @@ void OnDataSent(const wifi_tx_info_t *info, esp_now_send_status_t status)
   }
 }
 
+/**
+ * @brief Motion profile of the motor strokes (not stored in Preferences)
+ */
+static void initDefaultMotionProfile()
+{
+  systemStatus.msgMaster.rampUpMs = DEFAULT_RAMP_UP_MS;
+  systemStatus.msgMaster.rampDownMs = DEFAULT_RAMP_DOWN_MS;
+  systemStatus.msgMaster.holdPercent = DEFAULT_HOLD_PERCENT;
+}
+
 static void initDefaultTxMessage()
 {
   memset(&systemStatus.msgMaster, 0, sizeof(systemStatus.msgMaster));
@@ -184,6 +419,7 @@ static void initDefaultTxMessage()
   systemStatus.msgMaster.motorTorque = DEFAULT_MOTOR_TORQUE;
   systemStatus.msgMaster.motorState = DEFAULT_MOTOR_STATE;
   systemStatus.msgMaster.timeout = DEFAULT_TIMEOUT_MS;
+  initDefaultMotionProfile();
 }
 
 /**
@@ -194,16 +430,26 @@ static void initDefaultTxMessage()
  *
  * @details
  * - Timeout = msgMaster.timeout + MEASUREMENT_TIMEOUT_MARGIN_MS
+ * - CMD_BURST has no motor stroke: burstCount * (burstIntervalMs +
+ *   MEASUREMENT_TIMEOUT_MS) + MEASUREMENT_TIMEOUT_MARGIN_MS instead
  * - The MEASUREMENT_TIMEOUT_MARGIN_MS (1000ms) margin accounts for:
  *   - ESP-NOW transmission
  *   - data processing on the Slave side
  *   - communication delays
  * - In case of uint32_t overflow, the function returns UINT32_MAX
  *
+ * @param command Command waiting for the response
  * @return Timeout in milliseconds (maximum UINT32_MAX)
  */
-static uint32_t calcMeasurementWaitTimeoutMs()
+static uint32_t calcMeasurementWaitTimeoutMs(CommandType command)
 {
+  if (command == CMD_BURST)
+  {
+    // Worst case: every sample waits the interval plus a full read timeout
+    return (uint32_t)systemStatus.msgMaster.burstCount
+      * (systemStatus.msgMaster.burstIntervalMs + MEASUREMENT_TIMEOUT_MS) + MEASUREMENT_TIMEOUT_MARGIN_MS;
+  }
+
   // Requirement: timeout = systemStatus.msgMaster.timeout + MEASUREMENT_TIMEOUT_MARGIN_MS
   // (in case of overflow, saturate to UINT32_MAX)
   if (systemStatus.msgMaster.timeout > (UINT32_MAX - MEASUREMENT_TIMEOUT_MARGIN_MS))
@@ -238,6 +484,7 @@ static bool waitForMeasurementReady(uint32_t timeoutMs)
     if (elapsedMs >= timeoutMs)
     {
       DEBUG_W("Measurement timeout after %u ms (limit=%u ms)", (unsigned)elapsedMs, (unsigned)timeoutMs);
+      commManager.noteNoReply();
       return false;
     }
 
@@ -255,9 +502,18 @@ static bool waitForMeasurementReady(uint32_t timeoutMs)
   DEBUG_PLOT("calibrationOffset:%.3f", (double)systemStatus.calibrationOffset);
   DEBUG_PLOT("reference:%.3f", (double)systemStatus.reference);
   DEBUG_PLOT("angleZ:%u", (unsigned)systemStatus.msgSlave.angleZ);
+  DEBUG_PLOT("vibrationRms:%u", (unsigned)systemStatus.msgSlave.vibrationRms);
+  DEBUG_PLOT("settleMs:%u", (unsigned)systemStatus.msgSlave.settleMs);
   DEBUG_PLOT("measurement:%.3f", (double)systemStatus.msgSlave.measurement);
   DEBUG_PLOT("batteryVoltage:%.3f", (double)systemStatus.msgSlave.batteryVoltage);
 
+  const MessageSlaveMulti &multi = systemStatus.msgSlaveMulti;
+  for (uint8_t ch = 0; ch < multi.channelCount; ch++)
+  {
+    DEBUG_PLOT("channel%u:%.3f", (unsigned)ch, (double)multi.measurement[ch]);
+    DEBUG_PLOT("channelStatus%u:%u", (unsigned)ch, (unsigned)multi.status[ch]);
+  }
+
   return true;
 }
 
@@ -273,12 +529,13 @@ static bool waitForMeasurementReady(uint32_t timeoutMs)
  * 2. If yes - returns false (error: busy)
  * 3. If no - sets measurementInProgress = true
  * 4. Resets the ready flag
- * 5. Sends command to Slave
- * 6. Waits for response with timeout
+ * 5. Sends command to Slave with a new requestId (RequestTracker)
+ * 6. Waits for the reply carrying that requestId, with timeout; on timeout
+ *    the request expires, so a late reply is dropped as stale
  * 7. Sets measurementInProgress = false
  * 8. Returns true (success) or false (timeout/error)
  *
- * @param command Command type (CMD_MEASURE or CMD_UPDATE)
+ * @param command Command type (CMD_MEASURE, CMD_UPDATE or CMD_BURST)
  * @param commandName Command name for logging
  * @return true if the operation succeeded, false otherwise
  */
@@ -300,22 +557,39 @@ static bool executeMeasurementCommand(CommandType command, const char *commandNa
 
   // Step 4: Set and send the command
   systemStatus.msgMaster.command = command;
+  const uint8_t requestId = requestTracker.begin(command);
+  systemStatus.msgMaster.requestId = requestId;
 
   ErrorCode result = commManager.sendMessage(systemStatus.msgMaster);
 
   if (result != ERR_NONE)
   {
+    requestTracker.expire(requestId);
     LOG_ERROR(result, "Failed to send command %s", commandName);
     measurementState.setMeasurementMessage("ERROR: Cannot send command");
     measurementState.setMeasurementInProgress(false);  // Release lock
     return false;
   }
 
-  DEBUG_I("Command sent: %s", commandName);
+  DEBUG_I("Command sent: %s (request %u)", commandName, (unsigned)requestId);
   measurementState.setMeasurementMessage(commandName);
 
   // Step 5: Wait for response
-  bool success = waitForMeasurementReady(calcMeasurementWaitTimeoutMs());
+  bool success = waitForMeasurementReady(calcMeasurementWaitTimeoutMs(command));
+  if (!success)
+  {
+    requestTracker.expire(requestId);
+  }
+  else if (systemStatus.msgSlave.requestId == requestId)
+  {
+    DEBUG_I("Request %u answered, RTT %u us", (unsigned)requestId, (unsigned)requestTracker.getLastRttUs());
+#if REQUEST_STATS_LOG_INTERVAL > 0
+    if (requestTracker.getRttHistogram().count() % REQUEST_STATS_LOG_INTERVAL == 0)
+    {
+      requestTracker.logStatistics();
+    }
+#endif
+  }
 
   // Step 6: Release lock (even on timeout)
   measurementState.setMeasurementInProgress(false);
@@ -325,10 +599,14 @@ static bool executeMeasurementCommand(CommandType command, const char *commandNa
 
 ErrorCode sendTxToSlave(CommandType command, const char *commandName, bool expectResponse)
 {
+  // No reply expected: requestId 0, so no slot is taken and no ID of an
+  // earlier request is repeated
+  systemStatus.msgMaster.requestId = 0;
   if (expectResponse)
   {
     measurementState.setReady(false);
     measurementState.setMeasurementMessage("Waiting for response...");
+    systemStatus.msgMaster.requestId = requestTracker.begin(command);
   }
 
   systemStatus.msgMaster.command = command;
@@ -342,6 +620,10 @@ ErrorCode sendTxToSlave(CommandType command, const char *commandName, bool expec
   }
   else
   {
+    if (systemStatus.msgMaster.requestId != 0)
+    {
+      requestTracker.expire(systemStatus.msgMaster.requestId);
+    }
     LOG_ERROR(result, "Failed to send command %s", commandName);
     measurementState.setMeasurementMessage("ERROR: Cannot send command");
   }
@@ -359,6 +641,171 @@ void requestUpdate()
   executeMeasurementCommand(CMD_UPDATE, "Update");
 }
 
+/**
+ * @brief Summary of the last burst: valid samples, mean, spread
+ * @return Number of valid samples (0 if none)
+ */
+static uint8_t burstStatistics(float &mean, float &minValue, float &maxValue, float &stdDev)
+{
+  uint8_t valid = 0;
+  double sum = 0.0;
+  double sumSq = 0.0;
+  minValue = 0.0f;
+  maxValue = 0.0f;
+
+  for (uint8_t i = 0; i < systemStatus.burstCount; i++)
+  {
+    const BurstSample &sample = systemStatus.burst[i];
+    if (sample.status != CHANNEL_OK)
+    {
+      continue;
+    }
+    if (valid == 0 || sample.measurement < minValue) minValue = sample.measurement;
+    if (valid == 0 || sample.measurement > maxValue) maxValue = sample.measurement;
+    sum += sample.measurement;
+    sumSq += (double)sample.measurement * sample.measurement;
+    valid++;
+  }
+
+  mean = valid ? (float)(sum / valid) : INVALID_MEASUREMENT_VALUE;
+  // Sample standard deviation (n - 1), the repeatability figure
+  const double variance = valid > 1 ? (sumSq - sum * sum / valid) / (valid - 1) : 0.0;
+  stdDev = variance > 0.0 ? (float)sqrt(variance) : 0.0f;
+  return valid;
+}
+
+/**
+ * @brief Run CMD_BURST and report every sample
+ *
+ * All samples come back in one or two MessageSlaveBurst frames instead of
+ * one command/response round trip per sample.
+ *
+ * @param count Samples (1..BURST_MAX_SAMPLES)
+ * @param intervalMs Time between samples (0..BURST_MAX_INTERVAL_MS, 0 = back to back)
+ * @return true if all frames arrived
+ */
+static bool runBurst(uint8_t count, uint16_t intervalMs)
+{
+  systemStatus.msgMaster.burstCount = count;
+  systemStatus.msgMaster.burstIntervalMs = intervalMs;
+  systemStatus.burstCount = 0;
+  burstRxActive = false;
+
+  if (!executeMeasurementCommand(CMD_BURST, "Burst") || systemStatus.burstCount == 0)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < systemStatus.burstCount; i++)
+  {
+    const BurstSample &sample = systemStatus.burst[i];
+    DEBUG_PLOT("burstSample:%u,%.3f,%u,%u", (unsigned)i, (double)sample.measurement,
+      (unsigned)sample.offsetMs, (unsigned)sample.status);
+  }
+
+  float mean, minValue, maxValue, stdDev;
+  const uint8_t valid = burstStatistics(mean, minValue, maxValue, stdDev);
+  DEBUG_PLOT("burst:%u,%u,%.4f,%.4f,%.4f", (unsigned)valid, (unsigned)systemStatus.burstCount,
+    (double)mean, (double)(maxValue - minValue), (double)stdDev);
+  return true;
+}
+
+void requestBurst(uint8_t count, uint16_t intervalMs)
+{
+  (void)runBurst(count, intervalMs);
+}
+
+/**
+ * @brief Send CMD_STREAM with the current subscription (also the keepalive)
+ *
+ * Sent from a copy, so systemStatus.msgMaster.command of a measurement in
+ * progress is not touched, and without updating the measurement text.
+ */
+static ErrorCode sendStreamRequest()
+{
+  MessageMaster msg = systemStatus.msgMaster;
+  msg.command = CMD_STREAM;
+  ErrorCode result = commManager.sendMessage(msg);
+  if (result != ERR_NONE)
+  {
+    LOG_ERROR(result, "Failed to send CMD_STREAM");
+  }
+  return result;
+}
+
+/**
+ * @brief Subscribe to telemetry (or change the rate of the subscription)
+ *
+ * The slave sends measurement, angle and battery every periodMs, batched
+ * into MessageSlaveStream packets; loop() forwards them to Serial and
+ * /api/stream serves them to web clients. The subscription is renewed every
+ * STREAM_KEEPALIVE_MS; a failed send is retried by the next renewal.
+ *
+ * @param periodMs Sampling period (STREAM_MIN_PERIOD_MS..STREAM_MAX_PERIOD_MS)
+ * @param batch Samples per packet (1..STREAM_SAMPLES_PER_FRAME)
+ */
+void startStream(uint16_t periodMs, uint8_t batch)
+{
+  systemStatus.msgMaster.streamPeriodMs = periodMs;
+  systemStatus.msgMaster.streamBatch = batch;
+  if (!streamSubscribed)
+  {
+    streamSequenceValid = false;
+    streamLostPackets = 0;
+    streamDroppedSamples = 0;
+    streamForwardedSeq = streamHistory.pushed();
+  }
+  streamSubscribed = true;
+  streamRenewMs = millis();
+  (void)sendStreamRequest();
+  DEBUG_PLOT("streamPeriodMs:%u", (unsigned)periodMs);
+}
+
+void stopStream()
+{
+  streamSubscribed = false;
+  systemStatus.msgMaster.streamPeriodMs = 0;
+  (void)sendStreamRequest();
+  DEBUG_I("Telemetry stopped: %u packets lost, %u samples dropped by the slave",
+    (unsigned)streamLostPackets, (unsigned)streamDroppedSamples);
+  DEBUG_PLOT("streamPeriodMs:0");
+}
+
+/**
+ * @brief Renew the subscription and forward new telemetry samples to Serial
+ *
+ * Each sample becomes a DEBUG_PLOT line "stream:<slave ms>,<mm>,<angle>,<status>".
+ * At most STREAM_SERIAL_MAX_PER_LOOP per call, so the web server keeps
+ * running; a reader that fell more than STREAM_HISTORY_SIZE behind skips
+ * to the oldest sample still kept.
+ */
+static void serviceStream()
+{
+  if (streamSubscribed && millis() - streamRenewMs >= STREAM_KEEPALIVE_MS)
+  {
+    streamRenewMs = millis();
+    (void)sendStreamRequest();
+  }
+
+  const uint32_t newest = streamHistory.pushed();
+  if (newest - streamForwardedSeq > STREAM_HISTORY_SIZE)
+  {
+    streamForwardedSeq = newest - STREAM_HISTORY_SIZE;
+  }
+
+  for (uint8_t i = 0; i < STREAM_SERIAL_MAX_PER_LOOP && streamForwardedSeq != newest; i++)
+  {
+    StreamRecord rec;
+    uint32_t seq = 0;
+    streamForwardedSeq++;
+    if (streamHistory.latest(streamHistory.pushed() - streamForwardedSeq, rec, &seq) && seq == streamForwardedSeq)
+    {
+      DEBUG_PLOT("stream:%u,%.3f,%u,%u", (unsigned)rec.timestampMs, (double)rec.measurement,
+        (unsigned)rec.angleZ, (unsigned)rec.status);
+    }
+  }
+}
+
 void sendMotorTest()
 {
   (void)sendTxToSlave(CMD_MOTORTEST, "Motor test", false);
@@ -740,7 +1187,11 @@ void handleStartSession()
  *   "measurementCorrected": 123.579,
  *   "valid": true,
  *   "batteryVoltage": 3.7,
- *   "angleZ": 45
+ *   "angleZ": 45,
+ *   "vibrationRms": 3,
+ *   "settleMs": 210,
+ *   "channels": [123.456, 98.765],
+ *   "channelStatus": [0, 0]
  * }
  * ```
  *
@@ -752,6 +1203,11 @@ void handleStartSession()
  * - valid: validation flag (always true in this implementation)
  * - batteryVoltage: battery voltage in volts
  * - angleZ: vertical deviation from accelerometer in degrees (0-90°)
+ * - vibrationRms: fixture vibration at capture in mg (0 = not available)
+ * - settleMs: time from the start of the forward stroke until the jaw
+ *   stopped (0 = not detected, captured at the timeout)
+ * - channels / channelStatus: only for a multi-probe slave; raw value and
+ *   ChannelStatus (0 = OK) of every probe, measurementRaw is channel 0
  *
  * Note: measurementCorrected is calculated on the Master side
  * for UI convenience, but UI can also calculate it locally.
@@ -781,17 +1237,231 @@ void handleMeasureSession()
   }
 
   const MessageSlave &m = systemStatus.msgSlave;
+  const MessageSlaveMulti &multi = systemStatus.msgSlaveMulti;
 
   char response[JSON_RESPONSE_BUFFER_SIZE];
-  snprintf(response, sizeof(response),
-    "{\"sessionName\":\"%s\",\"measurementRaw\":%.3f,\"calibrationOffset\":%.3f,\"reference\":%.3f,\"measurementCorrected\":%.3f,\"valid\":true,\"batteryVoltage\":%.3f,\"angleZ\":%u}",
+  size_t used = appendf(response, sizeof(response), 0,
+    "{\"sessionName\":\"%s\",\"measurementRaw\":%.3f,\"calibrationOffset\":%.3f,\"reference\":%.3f,\"measurementCorrected\":%.3f,\"valid\":true,\"batteryVoltage\":%.3f,\"angleZ\":%u,\"vibrationRms\":%u,\"settleMs\":%u",
     systemStatus.sessionName,
     m.measurement,
     systemStatus.calibrationOffset,
     systemStatus.reference,
     m.measurement - systemStatus.calibrationOffset + systemStatus.reference,
     m.batteryVoltage,
-    (unsigned)m.angleZ);
+    (unsigned)m.angleZ,
+    (unsigned)m.vibrationRms,
+    (unsigned)m.settleMs);
+
+  // Multi-probe slave: raw value and ChannelStatus of every channel
+  if (multi.channelCount > 0)
+  {
+    used = appendf(response, sizeof(response), used, ",\"channels\":[");
+    for (uint8_t ch = 0; ch < multi.channelCount; ch++)
+    {
+      used = appendf(response, sizeof(response), used, "%s%.3f", ch ? "," : "", multi.measurement[ch]);
+    }
+    used = appendf(response, sizeof(response), used, "],\"channelStatus\":[");
+    for (uint8_t ch = 0; ch < multi.channelCount; ch++)
+    {
+      used = appendf(response, sizeof(response), used, "%s%u", ch ? "," : "", (unsigned)multi.status[ch]);
+    }
+    used = appendf(response, sizeof(response), used, "]");
+  }
+  appendf(response, sizeof(response), used, "}");
+
+  server.send(200, "application/json", response);
+}
+
+/**
+ * @brief Handles burst measurement request
+ *
+ * Endpoint: POST /api/burst
+ *
+ * URL parameters: count (1..BURST_MAX_SAMPLES), interval (ms,
+ * 0..BURST_MAX_INTERVAL_MS, optional, default 0 = back to back)
+ *
+ * JSON response format:
+ * ```json
+ * {
+ *   "success": true,
+ *   "count": 3,
+ *   "valid": 3,
+ *   "mean": 12.3453,
+ *   "range": 0.0010,
+ *   "stdDev": 0.0005,
+ *   "samples": [12.345, 12.346, 12.345],
+ *   "offsetMs": [0, 20, 40],
+ *   "status": [0, 0, 0]
+ * }
+ * ```
+ *
+ * samples are raw values like measurementRaw; status is the ChannelStatus
+ * of each sample (0 = OK, otherwise the value is -999.0).
+ */
+void handleBurst()
+{
+  long count = 0;
+  long interval = 0;
+  if (!parseIntStrict(server.arg("count"), count) || count < 1 || count > BURST_MAX_SAMPLES)
+  {
+    server.send(400, "application/json", "{\"success\":false,\"error\":\"Invalid count parameter\"}");
+    return;
+  }
+  if (server.hasArg("interval")
+    && (!parseIntStrict(server.arg("interval"), interval) || interval < 0 || interval > BURST_MAX_INTERVAL_MS))
+  {
+    server.send(400, "application/json", "{\"success\":false,\"error\":\"Invalid interval parameter\"}");
+    return;
+  }
+
+  if (!runBurst((uint8_t)count, (uint16_t)interval))
+  {
+    if (!measurementState.isReady())
+    {
+      server.send(504, "application/json", "{\"success\":false,\"error\":\"No response from device\"}");
+    }
+    else
+    {
+      server.send(503, "application/json", "{\"success\":false,\"error\":\"Device busy - operation in progress\"}");
+    }
+    return;
+  }
+
+  float mean, minValue, maxValue, stdDev;
+  const uint8_t valid = burstStatistics(mean, minValue, maxValue, stdDev);
+  const uint8_t n = systemStatus.burstCount;
+
+  static char response[BURST_JSON_BUFFER_SIZE];
+  size_t used = appendf(response, sizeof(response), 0,
+    "{\"success\":true,\"count\":%u,\"valid\":%u,\"mean\":%.4f,\"range\":%.4f,\"stdDev\":%.4f,\"samples\":[",
+    (unsigned)n, (unsigned)valid, mean, maxValue - minValue, stdDev);
+  for (uint8_t i = 0; i < n; i++)
+  {
+    used = appendf(response, sizeof(response), used, "%s%.3f", i ? "," : "", systemStatus.burst[i].measurement);
+  }
+  used = appendf(response, sizeof(response), used, "],\"offsetMs\":[");
+  for (uint8_t i = 0; i < n; i++)
+  {
+    used = appendf(response, sizeof(response), used, "%s%u", i ? "," : "", (unsigned)systemStatus.burst[i].offsetMs);
+  }
+  used = appendf(response, sizeof(response), used, "],\"status\":[");
+  for (uint8_t i = 0; i < n; i++)
+  {
+    used = appendf(response, sizeof(response), used, "%s%u", i ? "," : "", (unsigned)systemStatus.burst[i].status);
+  }
+  appendf(response, sizeof(response), used, "]}");
+
+  server.send(200, "application/json", response);
+}
+
+/**
+ * @brief Handles telemetry subscription
+ *
+ * Endpoint: POST /api/stream/start
+ *
+ * URL parameters: period (ms, STREAM_MIN_PERIOD_MS..STREAM_MAX_PERIOD_MS,
+ * default STREAM_DEFAULT_PERIOD_MS), batch (samples per packet,
+ * 1..STREAM_SAMPLES_PER_FRAME, default STREAM_DEFAULT_BATCH)
+ */
+void handleStreamStart()
+{
+  long period = STREAM_DEFAULT_PERIOD_MS;
+  long batch = STREAM_DEFAULT_BATCH;
+  if (server.hasArg("period")
+    && (!parseIntStrict(server.arg("period"), period) || period < STREAM_MIN_PERIOD_MS || period > STREAM_MAX_PERIOD_MS))
+  {
+    server.send(400, "application/json", "{\"success\":false,\"error\":\"Invalid period parameter\"}");
+    return;
+  }
+  if (server.hasArg("batch")
+    && (!parseIntStrict(server.arg("batch"), batch) || batch < 1 || batch > STREAM_SAMPLES_PER_FRAME))
+  {
+    server.send(400, "application/json", "{\"success\":false,\"error\":\"Invalid batch parameter\"}");
+    return;
+  }
+
+  startStream((uint16_t)period, (uint8_t)batch);
+
+  char response[JSON_RESPONSE_BUFFER_SIZE];
+  snprintf(response, sizeof(response), "{\"success\":true,\"periodMs\":%ld,\"batch\":%ld,\"seq\":%u}",
+    period, batch, (unsigned)streamHistory.pushed());
+  server.send(200, "application/json", response);
+}
+
+/**
+ * @brief Handles telemetry unsubscription
+ *
+ * Endpoint: POST /api/stream/stop
+ */
+void handleStreamStop()
+{
+  stopStream();
+  server.send(200, "application/json", "{\"success\":true}");
+}
+
+/**
+ * @brief Handles live feed polling
+ *
+ * Endpoint: GET /api/stream?since=<seq>
+ *
+ * Returns the samples received after sample number since (0 = the newest
+ * STREAM_WEB_MAX_SAMPLES). The client passes the returned seq as since of
+ * the next poll, so every sample arrives once however often it polls.
+ *
+ * JSON response format:
+ * ```json
+ * {
+ *   "active": true,
+ *   "seq": 1234,
+ *   "batteryVoltage": 7.800,
+ *   "calibrationOffset": 0.000,
+ *   "reference": 0.000,
+ *   "lostPackets": 0,
+ *   "droppedSamples": 0,
+ *   "samples": [[1233, 50120, 12.345, 3, 0], [1234, 50220, 12.346, 3, 0]]
+ * }
+ * ```
+ *
+ * Each sample is [seq, slave ms, raw mm, angleZ, ChannelStatus].
+ */
+void handleStreamRead()
+{
+  long since = 0;
+  if (server.hasArg("since") && (!parseIntStrict(server.arg("since"), since) || since < 0))
+  {
+    server.send(400, "application/json", "{\"error\":\"Invalid since parameter\"}");
+    return;
+  }
+
+  const uint32_t newest = streamHistory.pushed();
+  uint32_t first = (uint32_t)since + 1;
+  if (since == 0 || newest - (uint32_t)since > STREAM_WEB_MAX_SAMPLES)
+  {
+    first = newest > STREAM_WEB_MAX_SAMPLES ? newest - STREAM_WEB_MAX_SAMPLES + 1 : 1;
+  }
+
+  static char response[STREAM_JSON_BUFFER_SIZE];
+  size_t used = appendf(response, sizeof(response), 0,
+    "{\"active\":%s,\"seq\":%u,\"batteryVoltage\":%.3f,\"calibrationOffset\":%.3f,\"reference\":%.3f,\"lostPackets\":%u,\"droppedSamples\":%u,\"samples\":[",
+    streamSubscribed ? "true" : "false", (unsigned)newest, (double)streamBatteryVoltage,
+    systemStatus.calibrationOffset, systemStatus.reference,
+    (unsigned)streamLostPackets, (unsigned)streamDroppedSamples);
+
+  bool firstEntry = true;
+  for (uint32_t seq = first; seq <= newest && seq != 0; seq++)
+  {
+    // Index from the live head: OnDataRecv may push while the response is built
+    StreamRecord rec;
+    uint32_t got = 0;
+    if (!streamHistory.latest(streamHistory.pushed() - seq, rec, &got) || got != seq)
+    {
+      continue;
+    }
+    used = appendf(response, sizeof(response), used, "%s[%u,%u,%.3f,%u,%u]", firstEntry ? "" : ",",
+      (unsigned)seq, (unsigned)rec.timestampMs, (double)rec.measurement, (unsigned)rec.angleZ, (unsigned)rec.status);
+    firstEntry = false;
+  }
+  appendf(response, sizeof(response), used, "]}");
 
   server.send(200, "application/json", response);
 }
@@ -818,6 +1488,7 @@ void setup()
     prefsManager.loadSettings(&systemStatus);
     
     systemStatus.msgMaster.motorState = DEFAULT_MOTOR_STATE;
+    initDefaultMotionProfile();
 
     uint8_t nvsSlaveMac[6];
     if (prefsManager.loadSlaveMac(nvsSlaveMac))
@@ -875,6 +1546,9 @@ void setup()
     return;
   }
 
+  wire_peer_reset(rcWire, WIRE_VERSION_1);
+  wire_peer_reset(pairBroadcastWire, WIRE_VERSION_1);
+
   // Set callbacks
   commManager.setReceiveCallback(OnDataRecv);
   commManager.setSendCallback(OnDataSent);
@@ -920,6 +1594,10 @@ void setup()
 
   server.on("/start_session", HTTP_POST, handleStartSession);
   server.on("/measure_session", HTTP_POST, handleMeasureSession);
+  server.on("/api/burst", HTTP_POST, handleBurst);
+  server.on("/api/stream/start", HTTP_POST, handleStreamStart);
+  server.on("/api/stream/stop", HTTP_POST, handleStreamStop);
+  server.on("/api/stream", HTTP_GET, handleStreamRead);
   // Handle 404 errors with proper JSON response
   server.onNotFound([]()
                     {
@@ -940,6 +1618,9 @@ void setup()
   cliCtx.measurementState = &measurementState;
   cliCtx.requestMeasurement = requestMeasurement;
   cliCtx.requestUpdate = requestUpdate;
+  cliCtx.requestBurst = requestBurst;
+  cliCtx.startStream = startStream;
+  cliCtx.stopStream = stopStream;
   cliCtx.sendMotorTest = sendMotorTest;
   cliCtx.sendOTA = sendOTA;
   cliCtx.enterPairingMode = enterPairingMode;
@@ -989,11 +1670,13 @@ void loop()
         MessageMaster pairMsg{};
         pairMsg.command = CMD_PAIR;
         uint8_t broadcastAddr[] = BROADCAST_MAC_ADDR;
-        esp_now_send(broadcastAddr, (const uint8_t *)&pairMsg, sizeof(pairMsg));
+        pairBroadcastWire.version = pairBroadcastWire.version == WIRE_VERSION ? WIRE_VERSION_1 : WIRE_VERSION;
+        wire_send(pairBroadcastWire, broadcastAddr, WIRE_MASTER, 0, &pairMsg, 1);
       }
     }
   }
 
+  serviceStream();
   server.handleClient();
   timerWorker.tick();
 }
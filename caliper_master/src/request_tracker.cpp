@@ -0,0 +1,131 @@
+/**
+ * @file request_tracker.cpp
+ * @brief Correlation of slave replies with master requests
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - LEGACY count under the critical section, host build
+ */
+
+#include "request_tracker.h"
+#include <MacroDebugger.h>
+
+#if defined(ARDUINO)
+#include <esp_random.h>
+
+static uint32_t trackerMicros() { return micros(); }
+static uint32_t trackerRandom() { return esp_random(); }
+#else
+#include <chrono>
+#include <stdlib.h>
+
+static uint32_t trackerMicros()
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+static uint32_t trackerRandom() { return (uint32_t)rand(); }
+#endif
+
+RequestTracker::RequestTracker()
+    : nextSlot(0), lastRequestId((uint8_t)trackerRandom()), lastRttUs(0),
+      matched(0), legacy(0), duplicates(0), stale(0), mux(portMUX_INITIALIZER_UNLOCKED)
+{
+    // Random start, so a reply to a request from before a reboot does not match
+    for (uint8_t i = 0; i < REQUEST_TRACKER_SLOTS; i++)
+    {
+        slots[i] = {0, CMD_UPDATE, SlotState::FREE, 0};
+    }
+}
+
+RequestTracker::Slot *RequestTracker::find(uint8_t requestId)
+{
+    for (uint8_t i = 0; i < REQUEST_TRACKER_SLOTS; i++)
+    {
+        if (slots[i].state != SlotState::FREE && slots[i].requestId == requestId)
+        {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+uint8_t RequestTracker::begin(CommandType command)
+{
+    portENTER_CRITICAL(&mux);
+    lastRequestId++;
+    if (lastRequestId == 0)
+    {
+        lastRequestId = 1; // 0 marks replies without request ID
+    }
+
+    Slot &slot = slots[nextSlot];
+    nextSlot = (uint8_t)((nextSlot + 1) % REQUEST_TRACKER_SLOTS);
+    slot.requestId = lastRequestId;
+    slot.command = command;
+    slot.state = SlotState::IN_FLIGHT;
+    slot.sentUs = trackerMicros();
+    const uint8_t requestId = lastRequestId;
+    portEXIT_CRITICAL(&mux);
+
+    return requestId;
+}
+
+ReplyMatch RequestTracker::onReply(uint8_t requestId, bool finalReply, uint32_t &rttUs)
+{
+    const uint32_t nowUs = trackerMicros();
+    ReplyMatch match = ReplyMatch::STALE;
+
+    portENTER_CRITICAL(&mux);
+    Slot *slot = find(requestId);
+    if (requestId == 0)
+    {
+        match = ReplyMatch::LEGACY;
+        legacy++;
+    }
+    else if (slot != nullptr && slot->state == SlotState::IN_FLIGHT)
+    {
+        match = ReplyMatch::MATCHED;
+        if (finalReply)
+        {
+            slot->state = SlotState::ANSWERED;
+            rttUs = nowUs - slot->sentUs;
+            lastRttUs = rttUs;
+            rtt.record(rttUs);
+            matched++;
+        }
+    }
+    else if (slot != nullptr && slot->state == SlotState::ANSWERED)
+    {
+        match = ReplyMatch::DUPLICATE;
+        duplicates++;
+    }
+    else
+    {
+        stale++;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    return match;
+}
+
+void RequestTracker::expire(uint8_t requestId)
+{
+    portENTER_CRITICAL(&mux);
+    Slot *slot = find(requestId);
+    if (slot != nullptr && slot->state == SlotState::IN_FLIGHT)
+    {
+        slot->state = SlotState::EXPIRED;
+    }
+    portEXIT_CRITICAL(&mux);
+}
+
+void RequestTracker::logStatistics() const
+{
+    DEBUG_I("Slave replies: %u matched, %u duplicate, %u stale, %u without request ID",
+        (unsigned)matched, (unsigned)duplicates, (unsigned)stale, (unsigned)legacy);
+    DEBUG_I("Slave RTT: n=%u min=%u mean=%u p50<%u p99<%u max=%u us",
+        (unsigned)rtt.count(), (unsigned)rtt.minUs(), (unsigned)rtt.meanUs(),
+        (unsigned)rtt.percentileUs(50), (unsigned)rtt.percentileUs(99), (unsigned)rtt.maxUs());
+}
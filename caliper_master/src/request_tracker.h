@@ -0,0 +1,136 @@
+/**
+ * @file request_tracker.h
+ * @brief Correlation of slave replies with master requests
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Builds on the host for unit tests (test_request_tracker)
+ *
+ * @details
+ * Every request that expects a reply gets a new MessageMaster::requestId,
+ * which the slave echoes in MessageSlave, MessageSlaveMulti and every
+ * MessageSlaveBurst frame. The last REQUEST_TRACKER_SLOTS requests are kept,
+ * so a reply is classified as:
+ * - MATCHED: answers a request in flight
+ * - DUPLICATE: its request was answered already
+ * - STALE: its request timed out or is no longer in the table
+ * - LEGACY: requestId 0, slave firmware without request IDs (accepted as before)
+ *
+ * IDs run 1..255 and wrap; the table is much shorter than the ID space, so
+ * a reused ID never meets the slot of its previous request.
+ */
+
+#ifndef REQUEST_TRACKER_H
+#define REQUEST_TRACKER_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+// Host build (native_test): single-threaded, the critical section is empty
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#endif
+
+#include <shared_common.h>
+#include <latency_histogram.h>
+#include "config.h"
+
+enum class ReplyMatch : uint8_t
+{
+    MATCHED,    /**< Reply to a request in flight */
+    LEGACY,     /**< requestId 0 - slave without request IDs */
+    DUPLICATE,  /**< Request already answered */
+    STALE       /**< Request timed out or unknown */
+};
+
+/**
+ * @brief Table of the requests sent to the slave
+ *
+ * begin() and expire() run in loop(), onReply() in the ESP-NOW receive
+ * callback; the table is guarded by a critical section.
+ */
+class RequestTracker
+{
+private:
+    enum class SlotState : uint8_t
+    {
+        FREE,
+        IN_FLIGHT,
+        ANSWERED,
+        EXPIRED
+    };
+
+    struct Slot
+    {
+        uint8_t requestId;
+        CommandType command;
+        SlotState state;
+        uint32_t sentUs;    /**< micros() when the request was sent */
+    };
+
+    Slot slots[REQUEST_TRACKER_SLOTS];
+    uint8_t nextSlot;
+    uint8_t lastRequestId;
+    uint32_t lastRttUs;
+    uint32_t matched;
+    uint32_t legacy;
+    uint32_t duplicates;
+    uint32_t stale;
+    LatencyHistogram rtt;
+    portMUX_TYPE mux;
+
+    Slot *find(uint8_t requestId);
+
+public:
+    /**
+     * @brief Constructor - empty table, random first ID
+     */
+    RequestTracker();
+
+    /**
+     * @brief Register a request about to be sent
+     *
+     * Takes the slot of the oldest request.
+     *
+     * @param command Command of the request (for the log)
+     * @return requestId to put in MessageMaster (never 0)
+     */
+    uint8_t begin(CommandType command);
+
+    /**
+     * @brief Classify a reply from the slave
+     *
+     * @param requestId requestId echoed by the slave
+     * @param finalReply false for a burst frame before the last one: it is
+     *                   checked, but the request stays in flight
+     * @param rttUs Set to the round trip time of a MATCHED final reply
+     * @return How the reply relates to the requests sent
+     */
+    ReplyMatch onReply(uint8_t requestId, bool finalReply, uint32_t &rttUs);
+
+    /**
+     * @brief The request was not answered in time, a late reply is stale
+     * @param requestId ID returned by begin()
+     */
+    void expire(uint8_t requestId);
+
+    /**
+     * @brief Round trip time of the last MATCHED reply in microseconds
+     */
+    uint32_t getLastRttUs() const { return lastRttUs; }
+
+    /**
+     * @brief Round trip times of all MATCHED replies
+     */
+    const LatencyHistogram &getRttHistogram() const { return rtt; }
+
+    /**
+     * @brief Log the reply counters and the RTT distribution
+     */
+    void logStatistics() const;
+};
+
+#endif // REQUEST_TRACKER_H
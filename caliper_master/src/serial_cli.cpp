@@ -7,6 +7,7 @@
 #include <MacroDebugger.h>
 #include <shared_common.h>
 #include <shared_config.h>
+#include "config.h"
 #include "preferences_manager.h"
 #include "measurement_state.h"
 
@@ -112,10 +113,15 @@ static void printSerialHelp()
   DEBUG_I("\n=== AVAILABLE SERIAL COMMANDS (UART) ===\n"
           "m            - Send to slave: CMD_MEASURE (M)\n"
           "u            - Send to slave: CMD_UPDATE (U)\n"
+          "b <n> [ms]   - Send to slave: CMD_BURST (B), n samples (1-64) every ms (0-1000, default 0)\n"
+          "l <ms> [n]   - Live telemetry (CMD_STREAM) every ms (10-4000), n samples per packet (1-16); l 0 = stop\n"
           "o <ms>       - Set timeout\n"
           "q <0-255>    - Set motorTorque\n"
           "s <0-255>    - Set motorSpeed\n"
           "r <0-3>      - Set motorState (0=STOP, 1=FORWARD, 2=REVERSE, 3=BRAKE)\n"
+          "a <ms>       - Set rampUpMs (motor acceleration, 0..65535, 0 = step)\n"
+          "e <ms>       - Set rampDownMs (motor deceleration, 0..65535, 0 = step)\n"
+          "k <0-100>    - Set holdPercent (forward end speed in % of motorSpeed)\n"
           "t            - Send CMD_MOTORTEST (T) with current settings\n"
           "f            - Send CMD_OTA (O) – enter OTA mode on Slave (flash)\n"
           "p            - Pairing mode (30s broadcast CMD_PAIR)\n"
@@ -252,6 +258,97 @@ bool SerialCli_tick(void *arg)
       }
       break;
 
+    case 'b':
+    {
+      // "b <count> [interval]": split off the optional second number
+      const int space = rest.indexOf(' ');
+      const String countStr = space < 0 ? rest : rest.substring(0, space);
+      String intervalStr = space < 0 ? String("0") : rest.substring(space + 1);
+      intervalStr.trim();
+
+      long interval = 0;
+      if (!parseIntStrict(countStr, val) || !parseIntStrict(intervalStr, interval))
+      {
+        DEBUG_W("Serial: missing/invalid parameter for 'b' (use: b <count> [interval_ms]\\n)");
+        printSerialHelp();
+        break;
+      }
+
+      if (val < 1 || val > BURST_MAX_SAMPLES)
+      {
+        DEBUG_W("Serial: burst count out of range: %ld (1..%d)", val, BURST_MAX_SAMPLES);
+        break;
+      }
+
+      if (interval < 0 || interval > BURST_MAX_INTERVAL_MS)
+      {
+        DEBUG_W("Serial: burst interval out of range: %ld (0..%d ms)", interval, BURST_MAX_INTERVAL_MS);
+        break;
+      }
+
+      if (g_ctx.requestBurst)
+      {
+        g_ctx.requestBurst((uint8_t)val, (uint16_t)interval);
+
+        if (g_ctx.measurementState != nullptr)
+        {
+          if (g_ctx.measurementState->isReady())
+          {
+            DEBUG_I("Burst completed, mean: %s", g_ctx.measurementState->getMeasurement());
+          }
+          else
+          {
+            DEBUG_W("Burst failed or timeout");
+          }
+        }
+      }
+      break;
+    }
+
+    case 'l':
+    {
+      // "l <period> [batch]", "l 0" stops
+      const int space = rest.indexOf(' ');
+      const String periodStr = space < 0 ? rest : rest.substring(0, space);
+      String batchStr = space < 0 ? String(STREAM_DEFAULT_BATCH) : rest.substring(space + 1);
+      batchStr.trim();
+
+      long batch = 0;
+      if (!parseIntStrict(periodStr, val) || !parseIntStrict(batchStr, batch))
+      {
+        DEBUG_W("Serial: missing/invalid parameter for 'l' (use: l <period_ms> [batch]\\n)");
+        printSerialHelp();
+        break;
+      }
+
+      if (val == 0)
+      {
+        if (g_ctx.stopStream)
+        {
+          g_ctx.stopStream();
+        }
+        break;
+      }
+
+      if (val < STREAM_MIN_PERIOD_MS || val > STREAM_MAX_PERIOD_MS)
+      {
+        DEBUG_W("Serial: stream period out of range: %ld (%d..%d ms, 0 = stop)", val, STREAM_MIN_PERIOD_MS, STREAM_MAX_PERIOD_MS);
+        break;
+      }
+
+      if (batch < 1 || batch > STREAM_SAMPLES_PER_FRAME)
+      {
+        DEBUG_W("Serial: stream batch out of range: %ld (1..%d)", batch, STREAM_SAMPLES_PER_FRAME);
+        break;
+      }
+
+      if (g_ctx.startStream)
+      {
+        g_ctx.startStream((uint16_t)val, (uint8_t)batch);
+      }
+      break;
+    }
+
     case 'c':
       if (!parseFloatStrict(rest, fval))
       {
@@ -381,6 +478,69 @@ bool SerialCli_tick(void *arg)
       DEBUG_PLOT("motorState:%u", (unsigned)g_ctx.systemStatus->msgMaster.motorState);
       break;
 
+    case 'a':
+      if (!parseIntStrict(rest, val))
+      {
+        DEBUG_W("Serial: missing/invalid parameter for 'a' (use: a <ms>\\n)");
+        printSerialHelp();
+        break;
+      }
+
+      if (val < 0 || val > 65535)
+      {
+        DEBUG_W("Serial: rampUpMs out of range: %ld (0..65535)", val);
+        break;
+      }
+
+      g_ctx.systemStatus->msgMaster.rampUpMs = (uint16_t)val;
+      DEBUG_I("tx.rampUpMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampUpMs);
+
+      // Unify channel for GUI (DEBUG_PLOT) — GUI can update state immediately.
+      DEBUG_PLOT("rampUpMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampUpMs);
+      break;
+
+    case 'e':
+      if (!parseIntStrict(rest, val))
+      {
+        DEBUG_W("Serial: missing/invalid parameter for 'e' (use: e <ms>\\n)");
+        printSerialHelp();
+        break;
+      }
+
+      if (val < 0 || val > 65535)
+      {
+        DEBUG_W("Serial: rampDownMs out of range: %ld (0..65535)", val);
+        break;
+      }
+
+      g_ctx.systemStatus->msgMaster.rampDownMs = (uint16_t)val;
+      DEBUG_I("tx.rampDownMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampDownMs);
+
+      // Unify channel for GUI (DEBUG_PLOT) — GUI can update state immediately.
+      DEBUG_PLOT("rampDownMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampDownMs);
+      break;
+
+    case 'k':
+      if (!parseIntStrict(rest, val))
+      {
+        DEBUG_W("Serial: missing/invalid parameter for 'k' (use: k <0-100>\\n)");
+        printSerialHelp();
+        break;
+      }
+
+      if (val < 0 || val > 100)
+      {
+        DEBUG_W("Serial: holdPercent out of range: %ld (0..100)", val);
+        break;
+      }
+
+      g_ctx.systemStatus->msgMaster.holdPercent = (uint8_t)val;
+      DEBUG_I("tx.holdPercent:%u", (unsigned)g_ctx.systemStatus->msgMaster.holdPercent);
+
+      // Unify channel for GUI (DEBUG_PLOT) — GUI can update state immediately.
+      DEBUG_PLOT("holdPercent:%u", (unsigned)g_ctx.systemStatus->msgMaster.holdPercent);
+      break;
+
     case 't':
       if (g_ctx.sendMotorTest)
       {
@@ -428,6 +588,9 @@ bool SerialCli_tick(void *arg)
       DEBUG_PLOT("motorTorque:%u", (unsigned)g_ctx.systemStatus->msgMaster.motorTorque);
       DEBUG_PLOT("motorSpeed:%u", (unsigned)g_ctx.systemStatus->msgMaster.motorSpeed);
       DEBUG_PLOT("motorState:%u", (unsigned)g_ctx.systemStatus->msgMaster.motorState);
+      DEBUG_PLOT("rampUpMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampUpMs);
+      DEBUG_PLOT("rampDownMs:%u", (unsigned)g_ctx.systemStatus->msgMaster.rampDownMs);
+      DEBUG_PLOT("holdPercent:%u", (unsigned)g_ctx.systemStatus->msgMaster.holdPercent);
       DEBUG_PLOT("sessionName:%s", g_ctx.systemStatus->sessionName);
       break;
 
@@ -22,6 +22,9 @@ struct SerialCliContext
   // Actions (implemented in main.cpp)
   void (*requestMeasurement)() = nullptr;
   void (*requestUpdate)() = nullptr;
+  void (*requestBurst)(uint8_t count, uint16_t intervalMs) = nullptr;
+  void (*startStream)(uint16_t periodMs, uint8_t batch) = nullptr;
+  void (*stopStream)() = nullptr;
   void (*sendMotorTest)() = nullptr;
   void (*sendOTA)() = nullptr;
   void (*enterPairingMode)() = nullptr;
@@ -0,0 +1,140 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: classification of slave replies by RequestTracker
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Drives begin(), onReply() and expire() the way executeMeasurementCommand()
+ * and OnDataRecv() do: matched replies and their RTT, duplicates, late
+ * replies to expired or evicted requests, replies without request ID,
+ * multi-frame bursts and the wrap of the 8-bit request ID.
+ *
+ * Run: pio test -e native_test -f test_request_tracker
+ */
+
+#include <unity.h>
+
+#include "../../src/request_tracker.h"
+
+static ReplyMatch reply(RequestTracker &tracker, uint8_t requestId, bool finalReply = true)
+{
+    uint32_t rttUs = 0;
+    return tracker.onReply(requestId, finalReply, rttUs);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_matched_reply(void)
+{
+    RequestTracker tracker;
+    const uint8_t id = tracker.begin(CMD_MEASURE);
+    TEST_ASSERT_NOT_EQUAL(0, id);
+
+    uint32_t rttUs = 0xFFFFFFFFu;
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, tracker.onReply(id, true, rttUs));
+    TEST_ASSERT_NOT_EQUAL(0xFFFFFFFFu, rttUs);
+    TEST_ASSERT_EQUAL_UINT32(rttUs, tracker.getLastRttUs());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getRttHistogram().count());
+}
+
+void test_duplicate_reply(void)
+{
+    RequestTracker tracker;
+    const uint8_t id = tracker.begin(CMD_UPDATE);
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id));
+    TEST_ASSERT_EQUAL(ReplyMatch::DUPLICATE, reply(tracker, id));
+    TEST_ASSERT_EQUAL(ReplyMatch::DUPLICATE, reply(tracker, id));
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getRttHistogram().count());
+}
+
+void test_stale_reply(void)
+{
+    RequestTracker tracker;
+
+    // Timed out before the reply arrived
+    const uint8_t late = tracker.begin(CMD_MEASURE);
+    tracker.expire(late);
+    TEST_ASSERT_EQUAL(ReplyMatch::STALE, reply(tracker, late));
+
+    // Never sent
+    TEST_ASSERT_EQUAL(ReplyMatch::STALE, reply(tracker, (uint8_t)(late + 100)));
+
+    // Expiring an answered request does not make its repeat stale
+    const uint8_t answered = tracker.begin(CMD_MEASURE);
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, answered));
+    tracker.expire(answered);
+    TEST_ASSERT_EQUAL(ReplyMatch::DUPLICATE, reply(tracker, answered));
+}
+
+void test_evicted_request_is_stale(void)
+{
+    // The slot of the oldest request is reused once the table is full
+    RequestTracker tracker;
+    const uint8_t oldest = tracker.begin(CMD_MEASURE);
+    uint8_t newest = oldest;
+    for (int i = 0; i < REQUEST_TRACKER_SLOTS; i++)
+    {
+        newest = tracker.begin(CMD_UPDATE);
+    }
+    TEST_ASSERT_EQUAL(ReplyMatch::STALE, reply(tracker, oldest));
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, newest));
+}
+
+void test_legacy_reply(void)
+{
+    RequestTracker tracker;
+    const uint8_t id = tracker.begin(CMD_MEASURE);
+    TEST_ASSERT_EQUAL(ReplyMatch::LEGACY, reply(tracker, 0));
+    TEST_ASSERT_EQUAL(ReplyMatch::LEGACY, reply(tracker, 0));
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id));
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getRttHistogram().count());
+}
+
+void test_burst_frames(void)
+{
+    // Frames before the last one are matched but keep the request in flight
+    RequestTracker tracker;
+    const uint8_t id = tracker.begin(CMD_BURST);
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id, false));
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id, false));
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getRttHistogram().count());
+    TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id, true));
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getRttHistogram().count());
+    TEST_ASSERT_EQUAL(ReplyMatch::DUPLICATE, reply(tracker, id, false));
+}
+
+void test_request_id_wrap(void)
+{
+    RequestTracker tracker;
+    uint8_t previous = tracker.begin(CMD_UPDATE);
+    bool wrapped = false;
+    for (int i = 0; i < 600; i++)
+    {
+        const uint8_t id = tracker.begin(CMD_UPDATE);
+        TEST_ASSERT_NOT_EQUAL(0, id);
+        TEST_ASSERT_EQUAL_UINT8(previous == 255 ? 1 : previous + 1, id);
+        wrapped = wrapped || id < previous;
+
+        // The reused ID of a request 255 requests ago never meets its old slot
+        TEST_ASSERT_EQUAL(ReplyMatch::MATCHED, reply(tracker, id));
+        TEST_ASSERT_EQUAL(ReplyMatch::DUPLICATE, reply(tracker, id));
+        previous = id;
+    }
+    TEST_ASSERT_TRUE(wrapped);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_matched_reply);
+    RUN_TEST(test_duplicate_reply);
+    RUN_TEST(test_stale_reply);
+    RUN_TEST(test_evicted_request_is_stale);
+    RUN_TEST(test_legacy_reply);
+    RUN_TEST(test_burst_frames);
+    RUN_TEST(test_request_id_wrap);
+    return UNITY_END();
+}
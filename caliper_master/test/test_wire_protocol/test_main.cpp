@@ -0,0 +1,402 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: ESP-NOW wire format (v2 header, v1 fallback)
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - v1 frames in the layout of the firmware before v2
+ * @details
+ * Encodes messages with wire_encode() and parses them with wire_decode(),
+ * as sender and receiver do around esp_now_send(). Covers the CRC check
+ * value, v2 and v1 round trips of every message type, baseline v1 frames, single-bit
+ * corruption, short burst and stream frames, repeated sequences and the
+ * v2 probing / v1 fallback of WirePeer. Frames with a wrong length but a
+ * valid CRC are sealed by the test with the CRC as documented in
+ * wire_protocol.h.
+ *
+ * Run: pio test -e native_test -f test_wire_protocol
+ */
+
+#include <unity.h>
+#include <string.h>
+
+#include <wire_protocol.h>
+
+static WirePeer makePeer(uint8_t version)
+{
+    WirePeer peer;
+    wire_peer_reset(peer, version);
+    return peer;
+}
+
+/**
+ * @brief Recompute the CRC of a v2 frame: header with crc = 0, then payload
+ */
+static void seal(uint8_t *frame, size_t len)
+{
+    frame[offsetof(WireHeader, crc)] = 0;
+    frame[offsetof(WireHeader, crc) + 1] = 0;
+    const uint16_t crc = wire_crc16(frame, len);
+    frame[offsetof(WireHeader, crc)] = (uint8_t)(crc & 0xFF);
+    frame[offsetof(WireHeader, crc) + 1] = (uint8_t)(crc >> 8);
+}
+
+static MessageSlaveBurst makeBurst(uint8_t count)
+{
+    MessageSlaveBurst msg{};
+    msg.command = CMD_BURST;
+    msg.requestId = 42;
+    msg.frameCount = 1;
+    msg.sampleCount = count;
+    msg.totalSamples = count;
+    msg.angleZ = 3;
+    msg.batteryVoltage = 7.8f;
+    for (uint8_t i = 0; i < count && i < BURST_SAMPLES_PER_FRAME; i++)
+    {
+        msg.samples[i].measurement = 10.0f + i * 0.001f;
+        msg.samples[i].offsetMs = (uint16_t)(i * 20);
+        msg.samples[i].status = CHANNEL_OK;
+    }
+    return msg;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_crc_check_value(void)
+{
+    // CRC-16/CCITT-FALSE check value
+    const char check[] = "123456789";
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, wire_crc16((const uint8_t *)check, sizeof(check) - 1));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, wire_crc16(nullptr, 0));
+
+    // Streaming: the CRC of a buffer in two parts is the CRC of the whole
+    const uint16_t first = wire_crc16((const uint8_t *)check, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, wire_crc16((const uint8_t *)check + 4, 5, first));
+}
+
+void test_v2_round_trip(void)
+{
+    WirePeer tx = makePeer(WIRE_VERSION);
+    uint8_t frame[WIRE_MAX_FRAME_SIZE];
+
+    MessageMaster master{};
+    master.timeout = 1234;
+    master.command = CMD_MEASURE;
+    master.motorSpeed = 200;
+    master.rampUpMs = 150;
+    master.requestId = 77;
+    const uint16_t sequence = tx.txSequence;
+    size_t len = wire_encode(tx, WIRE_MASTER, 0, &master, frame);
+    TEST_ASSERT_EQUAL(sizeof(WireHeader) + sizeof(MessageMaster), len);
+    TEST_ASSERT_EQUAL_HEX8(WIRE_MAGIC, frame[0]);
+
+    WireFrame rx{};
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+    TEST_ASSERT_EQUAL(WIRE_MASTER, rx.type);
+    TEST_ASSERT_EQUAL(WIRE_VERSION, rx.version);
+    TEST_ASSERT_EQUAL_UINT16(sequence, rx.sequence);
+    TEST_ASSERT_EQUAL(sizeof(MessageMaster), rx.length);
+    TEST_ASSERT_EQUAL_MEMORY(&master, rx.payload, sizeof(MessageMaster));
+
+    MessageSlaveMulti multi{};
+    multi.channelCount = 3;
+    multi.measurement[2] = 5.5f;
+    multi.status[2] = CHANNEL_OUT_OF_RANGE;
+    multi.requestId = 9;
+    len = wire_encode(tx, WIRE_SLAVE_MULTI, WIRE_FLAG_BEST_EFFORT, &multi, frame);
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+    TEST_ASSERT_EQUAL(WIRE_SLAVE_MULTI, rx.type);
+    TEST_ASSERT_EQUAL(WIRE_FLAG_BEST_EFFORT, rx.flags);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)(sequence + 1), rx.sequence);
+    TEST_ASSERT_EQUAL_MEMORY(&multi, rx.payload, sizeof(MessageSlaveMulti));
+
+    MessageRC rc{CMD_MEASURE};
+    len = wire_encode(tx, WIRE_RC, 0, &rc, frame);
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+    TEST_ASSERT_EQUAL(WIRE_RC, rx.type);
+    TEST_ASSERT_EQUAL(1, rx.length);
+}
+
+void test_v1_is_the_legacy_layout(void)
+{
+    WirePeer tx = makePeer(WIRE_VERSION_1);
+    uint8_t frame[WIRE_MAX_FRAME_SIZE];
+    memset(frame, 0xEE, sizeof(frame));
+
+    MessageSlave slave{};
+    slave.measurement = 12.345f;
+    slave.batteryVoltage = 7.4f;
+    slave.command = CMD_MEASURE;
+    slave.angleZ = 12;
+    slave.vibrationRms = 30;
+    slave.requestId = 5;
+    const uint16_t sequence = tx.txSequence;
+    size_t len = wire_encode(tx, WIRE_SLAVE, WIRE_FLAG_MORE, &slave, frame);
+    TEST_ASSERT_EQUAL(WIRE_V1_SLAVE_SIZE, len);
+    TEST_ASSERT_EQUAL_MEMORY(&slave, frame, offsetof(MessageSlave, vibrationRms));
+    TEST_ASSERT_EQUAL_HEX8(0, frame[WIRE_V1_SLAVE_SIZE - 2]);
+    TEST_ASSERT_EQUAL_HEX8(0, frame[WIRE_V1_SLAVE_SIZE - 1]);
+    TEST_ASSERT_EQUAL_UINT16(sequence, tx.txSequence);
+
+    WireFrame rx{};
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+    TEST_ASSERT_EQUAL(WIRE_SLAVE, rx.type);
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, rx.version);
+    TEST_ASSERT_EQUAL(0, rx.flags);
+
+    MessageMaster master{};
+    master.timeout = 500;
+    master.command = CMD_MOTORTEST;
+    master.motorSpeed = 100;
+    master.rampUpMs = 200;
+    master.requestId = 6;
+    len = wire_encode(tx, WIRE_MASTER, 0, &master, frame);
+    TEST_ASSERT_EQUAL(WIRE_V1_MASTER_SIZE, len);
+    TEST_ASSERT_EQUAL_MEMORY(&master, frame, WIRE_V1_MASTER_SIZE);
+
+    // Every message is told apart by its length alone
+    const struct { size_t size; WireType type; } v1[] = {
+        {WIRE_V1_MASTER_SIZE, WIRE_MASTER},
+        {WIRE_V1_SLAVE_SIZE, WIRE_SLAVE},
+        {sizeof(MessageSlaveMulti), WIRE_SLAVE_MULTI},
+        {sizeof(MessageSlaveBurst), WIRE_SLAVE_BURST},
+        {sizeof(MessageSlaveStream), WIRE_SLAVE_STREAM},
+        {sizeof(MessageRC), WIRE_RC},
+    };
+    static uint8_t zeros[WIRE_MAX_FRAME_SIZE];
+    for (const auto &entry : v1)
+    {
+        TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(zeros, (int)entry.size, rx));
+        TEST_ASSERT_EQUAL(entry.type, rx.type);
+        TEST_ASSERT_EQUAL(WIRE_VERSION_1, rx.version);
+    }
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(zeros, 2, rx));
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(zeros, 0, rx));
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(zeros, (int)sizeof(MessageMaster), rx));
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(zeros, (int)sizeof(MessageSlave), rx));
+}
+
+void test_baseline_v1_messages(void)
+{
+    // Byte images of the messages sent by firmware before v2 (little endian)
+    const uint8_t baselineSlave[12] = {
+        0x00, 0x00, 0x48, 0x41,   // measurement 12.5f
+        0x66, 0x66, 0xF6, 0x40,   // batteryVoltage 7.7f
+        (uint8_t)CMD_MEASURE,
+        7,                        // angleZ
+        0xAA, 0x55,               // padding, not cleared by the old firmware
+    };
+    WireFrame rx{};
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(baselineSlave, sizeof(baselineSlave), rx));
+    TEST_ASSERT_EQUAL(WIRE_SLAVE, rx.type);
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, rx.version);
+
+    MessageSlave slave{};
+    memcpy(&slave, rx.payload, rx.length);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, slave.measurement);
+    TEST_ASSERT_EQUAL_FLOAT(7.7f, slave.batteryVoltage);
+    TEST_ASSERT_EQUAL(CMD_MEASURE, slave.command);
+    TEST_ASSERT_EQUAL_UINT8(7, slave.angleZ);
+    TEST_ASSERT_EQUAL_UINT16(0, slave.vibrationRms);
+    TEST_ASSERT_EQUAL_UINT16(0, slave.settleMs);
+    TEST_ASSERT_EQUAL_UINT8(0, slave.requestId);
+
+    const uint8_t baselineMaster[8] = {
+        0xE8, 0x03, 0x00, 0x00,   // timeout 1000
+        (uint8_t)CMD_MEASURE,
+        (uint8_t)MOTOR_FORWARD,
+        150,                      // motorSpeed
+        60,                       // motorTorque
+    };
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(baselineMaster, sizeof(baselineMaster), rx));
+    TEST_ASSERT_EQUAL(WIRE_MASTER, rx.type);
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, rx.version);
+    TEST_ASSERT_EQUAL(WIRE_V1_MASTER_SIZE, rx.length);
+
+    MessageMaster master{};
+    memcpy(&master, rx.payload, rx.length);
+    TEST_ASSERT_EQUAL_UINT32(1000, master.timeout);
+    TEST_ASSERT_EQUAL(CMD_MEASURE, master.command);
+    TEST_ASSERT_EQUAL(MOTOR_FORWARD, master.motorState);
+    TEST_ASSERT_EQUAL_UINT8(150, master.motorSpeed);
+    TEST_ASSERT_EQUAL_UINT8(60, master.motorTorque);
+    TEST_ASSERT_EQUAL_UINT16(0, master.rampUpMs);
+    TEST_ASSERT_EQUAL_UINT8(0, master.requestId);
+}
+
+void test_corrupted_frames_are_rejected(void)
+{
+    WirePeer tx = makePeer(WIRE_VERSION);
+    uint8_t frame[WIRE_MAX_FRAME_SIZE];
+    const MessageSlaveBurst burst = makeBurst(3);
+    const size_t len = wire_encode(tx, WIRE_SLAVE_BURST, 0, &burst, frame);
+    WireFrame rx{};
+    TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+
+    // CRC-16 detects every single-bit error
+    for (size_t byte = 0; byte < len; byte++)
+    {
+        for (int bit = 0; bit < 8; bit++)
+        {
+            frame[byte] ^= (uint8_t)(1u << bit);
+            const ErrorCode result = wire_decode(frame, (int)len, rx);
+            frame[byte] ^= (uint8_t)(1u << bit);
+
+            TEST_ASSERT_NOT_EQUAL(ERR_NONE, result);
+            if (byte >= sizeof(WireHeader))
+            {
+                TEST_ASSERT_EQUAL(ERR_ESPNOW_CRC_MISMATCH, result);
+            }
+        }
+    }
+
+    // Unknown version with a valid CRC
+    frame[offsetof(WireHeader, version)] = WIRE_VERSION + 1;
+    seal(frame, len);
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_UNSUPPORTED_VERSION, wire_decode(frame, (int)len, rx));
+}
+
+void test_short_burst_frames(void)
+{
+    WirePeer tx = makePeer(WIRE_VERSION);
+    uint8_t frame[WIRE_MAX_FRAME_SIZE];
+    WireFrame rx{};
+
+    for (uint8_t count = 0; count <= BURST_SAMPLES_PER_FRAME; count++)
+    {
+        const MessageSlaveBurst sent = makeBurst(count);
+        const size_t len = wire_encode(tx, WIRE_SLAVE_BURST, 0, &sent, frame);
+        TEST_ASSERT_EQUAL(sizeof(WireHeader) + offsetof(MessageSlaveBurst, samples) + count * sizeof(BurstSample), len);
+        TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+        TEST_ASSERT_EQUAL(WIRE_SLAVE_BURST, rx.type);
+
+        MessageSlaveBurst received{};
+        memcpy(&received, rx.payload, rx.length);
+        TEST_ASSERT_EQUAL(count, received.sampleCount);
+        TEST_ASSERT_EQUAL_MEMORY(&sent, &received, sizeof(MessageSlaveBurst));
+    }
+
+    // More samples than a frame holds cannot be encoded
+    const MessageSlaveBurst tooMany = makeBurst(BURST_SAMPLES_PER_FRAME + 1);
+    TEST_ASSERT_EQUAL(0, wire_encode(tx, WIRE_SLAVE_BURST, 0, &tooMany, frame));
+
+    // Length disagrees with sampleCount, CRC valid
+    const MessageSlaveBurst three = makeBurst(3);
+    const size_t len = wire_encode(tx, WIRE_SLAVE_BURST, 0, &three, frame);
+    seal(frame, len - 1);
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(frame, (int)len - 1, rx));
+    frame[len] = 0;
+    seal(frame, len + 1);
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(frame, (int)len + 1, rx));
+
+    // Cut inside the fixed part, before samples[]
+    const size_t cut = sizeof(WireHeader) + offsetof(MessageSlaveBurst, samples) - 1;
+    seal(frame, cut);
+    TEST_ASSERT_EQUAL(ERR_ESPNOW_INVALID_LENGTH, wire_decode(frame, (int)cut, rx));
+}
+
+void test_short_stream_frames(void)
+{
+    WirePeer tx = makePeer(WIRE_VERSION);
+    uint8_t frame[WIRE_MAX_FRAME_SIZE];
+    WireFrame rx{};
+
+    for (uint8_t count = 1; count <= STREAM_SAMPLES_PER_FRAME; count++)
+    {
+        MessageSlaveStream sent{};
+        sent.command = CMD_STREAM;
+        sent.sampleCount = count;
+        sent.sequence = count;
+        sent.samples[count - 1].measurement = 1.5f;
+        sent.samples[count - 1].status = CHANNEL_OK;
+        const size_t len = wire_encode(tx, WIRE_SLAVE_STREAM, WIRE_FLAG_BEST_EFFORT, &sent, frame);
+        TEST_ASSERT_EQUAL(sizeof(WireHeader) + offsetof(MessageSlaveStream, samples) + count * sizeof(StreamSample), len);
+
+        // 15 samples have the length of a v1 MessageSlaveStream: the CRC decides
+        TEST_ASSERT_EQUAL(ERR_NONE, wire_decode(frame, (int)len, rx));
+        TEST_ASSERT_EQUAL(WIRE_VERSION, rx.version);
+        TEST_ASSERT_EQUAL(WIRE_SLAVE_STREAM, rx.type);
+        TEST_ASSERT_EQUAL_MEMORY(&sent, rx.payload, rx.length);
+    }
+}
+
+void test_repeated_sequence_is_dropped(void)
+{
+    WirePeer rx = makePeer(WIRE_VERSION_1);
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION, 100));
+    TEST_ASSERT_EQUAL(WIRE_VERSION, rx.version);
+    TEST_ASSERT_TRUE(rx.confirmed);
+    TEST_ASSERT_FALSE(wire_peer_accept(rx, WIRE_VERSION, 100));
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION, 101));
+
+    // Sequence wrap
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION, 0xFFFF));
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION, 0));
+
+    // v1 has no sequence: never a repeat, and the peer is answered in v1
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION_1, 0));
+    TEST_ASSERT_TRUE(wire_peer_accept(rx, WIRE_VERSION_1, 0));
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, rx.version);
+}
+
+void test_v1_fallback_and_reprobe(void)
+{
+    WirePeer peer = makePeer(WIRE_VERSION);
+    for (int i = 0; i < WIRE_PROBE_MAX_UNANSWERED - 1; i++)
+    {
+        wire_peer_request(peer);
+        wire_peer_no_reply(peer);
+        TEST_ASSERT_EQUAL(WIRE_VERSION, peer.version);
+    }
+    wire_peer_request(peer);
+    wire_peer_no_reply(peer);
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, peer.version);
+
+    // A v1 slave answers; v2 is still tried again now and then
+    for (int i = 0; i < WIRE_V1_REPROBE_REQUESTS - 1; i++)
+    {
+        wire_peer_request(peer);
+        TEST_ASSERT_EQUAL(WIRE_VERSION_1, peer.version);
+        TEST_ASSERT_TRUE(wire_peer_accept(peer, WIRE_VERSION_1, 0));
+    }
+    wire_peer_request(peer);
+    TEST_ASSERT_EQUAL(WIRE_VERSION, peer.version);
+
+    // ... and a single lost probe goes back to v1
+    wire_peer_no_reply(peer);
+    TEST_ASSERT_EQUAL(WIRE_VERSION_1, peer.version);
+
+    // A v2 slave that was out of range while probing is found again
+    for (int i = 0; i < WIRE_V1_REPROBE_REQUESTS; i++)
+    {
+        wire_peer_request(peer);
+    }
+    TEST_ASSERT_EQUAL(WIRE_VERSION, peer.version);
+    TEST_ASSERT_TRUE(wire_peer_accept(peer, WIRE_VERSION, 7));
+    TEST_ASSERT_TRUE(peer.confirmed);
+
+    // Once confirmed, lost requests do not change the version
+    for (int i = 0; i < 2 * WIRE_V1_REPROBE_REQUESTS; i++)
+    {
+        wire_peer_request(peer);
+        wire_peer_no_reply(peer);
+    }
+    TEST_ASSERT_EQUAL(WIRE_VERSION, peer.version);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_check_value);
+    RUN_TEST(test_v2_round_trip);
+    RUN_TEST(test_v1_is_the_legacy_layout);
+    RUN_TEST(test_baseline_v1_messages);
+    RUN_TEST(test_corrupted_frames_are_rejected);
+    RUN_TEST(test_short_burst_frames);
+    RUN_TEST(test_short_stream_frames);
+    RUN_TEST(test_repeated_sequence_is_dropped);
+    RUN_TEST(test_v1_fallback_and_reprobe);
+    return UNITY_END();
+}
@@ -249,6 +249,49 @@ class CaliperGUI:
                 self.calibration_tab.add_app_log(f"[ANGLE Z] {angle_str}°")
                 return
 
+            if data.startswith("vibrationRms:"):
+                vibration_str = data.split(":", 1)[1].strip()
+                self.calibration_tab.add_app_log(f"[VIBRATION] {vibration_str} mg RMS")
+                return
+
+            if data.startswith("settleMs:"):
+                settle_str = data.split(":", 1)[1].strip()
+                self.calibration_tab.add_app_log(f"[SETTLE] {settle_str} ms")
+                return
+
+            if data.startswith("burst:"):
+                fields = data.split(":", 1)[1].strip().split(",")
+                valid, total, mean, spread, std_dev = fields
+                self.calibration_tab.add_app_log(
+                    f"[BURST] {valid}/{total} valid, mean {float(mean):.4f} mm, "
+                    f"range {float(spread):.4f} mm, std dev {float(std_dev):.4f} mm"
+                )
+                return
+
+            # Live telemetry: "stream:<slave ms>,<raw mm>,<angle>,<status>".
+            # Updates the gauge only; measurement rows come from "measurement:".
+            if data.startswith("stream:"):
+                _, raw_str, angle_str, status_str = data.split(":", 1)[1].strip().split(",")
+                if int(status_str) != 0:
+                    return
+                corrected = float(raw_str) - float(self.current_calibration_offset) + float(self.current_reference)
+                self.gauge_tab.update(
+                    f"{corrected:.3f}",
+                    timestamp=datetime.now().strftime("%Y-%m-%d %H:%M:%S"),
+                    angle=angle_str,
+                    include_timestamp=self.measurement_tab.include_timestamp,
+                    include_angle=self.measurement_tab.include_angle,
+                )
+                return
+
+            if data.startswith("streamPeriodMs:"):
+                period_str = data.split(":", 1)[1].strip()
+                if int(period_str) == 0:
+                    self.calibration_tab.add_app_log("[STREAM] Stopped")
+                else:
+                    self.calibration_tab.add_app_log(f"[STREAM] Every {period_str} ms")
+                return
+
             if data.startswith("batteryVoltage:"):
                 voltage_str = data.split(":", 1)[1].strip()
                 self.calibration_tab.add_app_log(f"[BATTERY] {voltage_str} V")
@@ -321,6 +364,14 @@ class CaliperGUI:
                     self.calibration_tab.add_app_log(f"[CONFIG] motorState (parse err): {val_str}")
                 return
 
+            if data.startswith(("rampUpMs:", "rampDownMs:", "holdPercent:")):
+                key, val_str = data.split(":", 1)
+                try:
+                    self.calibration_tab.add_app_log(f"[CONFIG] {key}: {int(val_str.strip())}")
+                except Exception:
+                    self.calibration_tab.add_app_log(f"[CONFIG] {key} (parse err): {val_str.strip()}")
+                return
+
             # --- Session name (sent via DEBUG_PLOT on session name change)
             if data.startswith("sessionName:"):
                 name_str = data.split(":", 1)[1].strip()
@@ -395,6 +446,11 @@ class CaliperGUI:
             (
                 "measurement:",
                 "angleZ:",
+                "vibrationRms:",
+                "settleMs:",
+                "burst:",
+                "stream:",
+                "streamPeriodMs:",
                 "batteryVoltage:",
                 "calibrationOffset:",
                 "reference:",
@@ -402,6 +458,9 @@ class CaliperGUI:
                 "motorTorque:",
                 "motorSpeed:",
                 "motorState:",
+                "rampUpMs:",
+                "rampDownMs:",
+                "holdPercent:",
                 "sessionName:",
                 "dropMeas:",
                 "pairing:",
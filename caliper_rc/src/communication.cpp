@@ -2,7 +2,9 @@
  * @file communication.cpp
  * @brief ESP-NOW Communication Module Implementation for RC device
  * @date 2026-05-03
- * @version 1.0
+ * @version 1.1
+ *
+ * @version 1.1 - Protocol v2 once the master has sent a v2 frame, v1 before
  */
 
 #include "communication.h"
@@ -12,6 +14,8 @@ CommunicationManager::CommunicationManager() : initialized(false), lastError(ERR
 {
   memset(masterAddress, 0, 6);
   memset(&peerInfo, 0, sizeof(peerInfo));
+  // RC commands get no reply, so v2 cannot be probed: v1 until the master sends v2
+  wire_peer_reset(masterWire, WIRE_VERSION_1);
 }
 
 ErrorCode CommunicationManager::initialize(const uint8_t *masterAddr)
@@ -58,10 +62,12 @@ ErrorCode CommunicationManager::sendMessage(const MessageRC &message, int retryC
     return lastError;
   }
 
-  ErrorCode result = espnow_send_with_retry(
+  ErrorCode result = wire_send(
+      masterWire,
       masterAddress,
+      WIRE_RC,
+      0,
       &message,
-      sizeof(message),
       retryCount,
       ESPNOW_RETRY_DELAY_MS
   );
@@ -2,7 +2,9 @@
  * @file communication.h
  * @brief ESP-NOW Communication Module Header for RC device
  * @date 2026-05-03
- * @version 1.0
+ * @version 1.1
+ *
+ * @version 1.1 - Messages to the master go through wire_protocol.h
  */
 
 #ifndef COMMUNICATION_H
@@ -11,6 +13,7 @@
 #include "config.h"
 #include <shared_common.h>
 #include <error_handler.h>
+#include <wire_protocol.h>
 #include <esp_now.h>
 #include <WiFi.h>
 
@@ -19,6 +22,7 @@ class CommunicationManager
 private:
   uint8_t masterAddress[6];
   esp_now_peer_info_t peerInfo;
+  WirePeer masterWire;
   bool initialized;
   ErrorCode lastError;
 
@@ -29,6 +33,12 @@ public:
 
   ErrorCode sendMessage(const MessageRC &message, int retryCount = ESPNOW_MAX_RETRIES);
 
+  /**
+   * @brief Record a frame received from the master; later messages use its version
+   * @return false if the frame repeats the previous one and must be dropped
+   */
+  bool acceptMasterFrame(const WireFrame &frame) { return wire_peer_accept(masterWire, frame.version, frame.sequence); }
+
   ErrorCode updatePeerAddress(const uint8_t *newAddr);
 
   bool isInitialized() const { return initialized; }
@@ -68,38 +68,51 @@ void OnDataRecv(const esp_now_recv_info_t *recv_info, const uint8_t *incomingDat
   uint8_t src_addr[6];
   memcpy(src_addr, recv_info->src_addr, 6);
 
-  if (pairingMode && len == sizeof(MessageMaster))
+  if (!pairingMode)
   {
-    MessageMaster tmpMsg{};
-    memcpy(&tmpMsg, incomingData, sizeof(tmpMsg));
+    return;
+  }
 
-    if (tmpMsg.command == CMD_PAIR)
-    {
-      commManager.updatePeerAddress(src_addr);
-      memcpy(masterAddress, src_addr, 6);
+  WireFrame frame{};
+  if (wire_decode(incomingData, len, frame) != ERR_NONE || frame.type != WIRE_MASTER)
+  {
+    return;
+  }
+  // The pairing reply goes out in the version of this frame
+  if (!commManager.acceptMasterFrame(frame))
+  {
+    return;
+  }
 
-      rcPrefs.putBytes("masterMac", src_addr, 6);
+  MessageMaster tmpMsg{};
+  memcpy(&tmpMsg, frame.payload, frame.length);
 
-      isPaired = false;
+  if (tmpMsg.command == CMD_PAIR)
+  {
+    commManager.updatePeerAddress(src_addr);
+    memcpy(masterAddress, src_addr, 6);
 
-      MessageRC pairResp{};
-      pairResp.command = CMD_PAIR;
-      commManager.sendMessage(pairResp);
+    rcPrefs.putBytes("masterMac", src_addr, 6);
 
-      DEBUG_I("Received CMD_PAIR from Master: %02X:%02X:%02X:%02X:%02X:%02X",
-        src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
-      return;
-    }
+    isPaired = false;
 
-    if (tmpMsg.command == CMD_PAIR_ACK)
-    {
-      rcPrefs.putBytes("masterMac", src_addr, 6);
-      hasStoredMasterMac = true;
-      isPaired = true;
-      exitPairingMode();
-      DEBUG_I("RC: Pairing completed");
-      return;
-    }
+    MessageRC pairResp{};
+    pairResp.command = CMD_PAIR;
+    commManager.sendMessage(pairResp);
+
+    DEBUG_I("Received CMD_PAIR from Master: %02X:%02X:%02X:%02X:%02X:%02X",
+      src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
+    return;
+  }
+
+  if (tmpMsg.command == CMD_PAIR_ACK)
+  {
+    rcPrefs.putBytes("masterMac", src_addr, 6);
+    hasStoredMasterMac = true;
+    isPaired = true;
+    exitPairingMode();
+    DEBUG_I("RC: Pairing completed");
+    return;
   }
 }
 
@@ -0,0 +1,395 @@
+/**
+ * @file bench.cpp
+ * @brief On-target micro-benchmarks for the slave firmware
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1 - RS485 direction control benchmark
+ * @version 1.2 - P12D parser benchmark
+ * @version 1.3 - Tilt kernel accuracy and cost
+ * @version 1.4 - RS485 benchmark runs on the firmware's sensor instance
+ * @version 1.5 - P12D parser correctness check moved to test/test_p12d_parser
+ */
+
+#include "bench.h"
+
+#if defined(ENABLE_BENCHMARK)
+
+#include <MacroDebugger.h>
+
+#if defined(SPC)
+#include "../sensors/caliper.h"
+#include "../sensors/spc_decoder.h"
+#include <math.h>
+
+// Copy of the pre-2.1 ISR body (digitalRead-based, one byte per bit),
+// kept here only as the reference for benchSpcCapture().
+static volatile uint8_t legacyBitBuffer[CALIPER_FRAME_BITS];
+static volatile int legacyBitCount = 0;
+static volatile bool legacyDataReady = false;
+
+static void IRAM_ATTR legacyClockISR()
+{
+    uint8_t bit = digitalRead(CLOCK_PIN);
+    if (bit == HIGH) return;
+
+    if (legacyBitCount < CALIPER_FRAME_BITS)
+    {
+        bit = digitalRead(DATA_PIN);
+        bit = digitalRead(DATA_PIN);
+        bit = digitalRead(DATA_PIN);
+
+        legacyBitBuffer[legacyBitCount] = bit;
+        legacyBitCount = legacyBitCount + 1;
+        if (legacyBitCount == CALIPER_FRAME_BITS)
+        {
+            legacyDataReady = true;
+        }
+    }
+}
+
+void benchSpcCapture()
+{
+    // OUTPUT on ESP32 keeps the input buffer enabled, so both ISRs read LOW
+    pinMode(CLOCK_PIN, OUTPUT);
+    digitalWrite(CLOCK_PIN, LOW);
+
+    uint32_t legacyTotal = 0;
+    uint32_t legacyMin = UINT32_MAX;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (legacyBitCount >= CALIPER_FRAME_BITS) legacyBitCount = 0;
+        uint32_t t0 = ESP.getCycleCount();
+        legacyClockISR();
+        uint32_t dt = ESP.getCycleCount() - t0;
+        legacyTotal += dt;
+        if (dt < legacyMin) legacyMin = dt;
+    }
+
+    // The current ISR runs once per bit as well, on the falling edge. Period
+    // checks are disabled for the run since the simulated edges are only a
+    // few hundred cycles apart. Without a gap the synchroniser would ignore
+    // every edge after the first frame, so it is restarted once per frame,
+    // as legacyBitCount is above.
+    CaliperInterface::frameSync.configure(0, UINT32_MAX);
+
+    uint32_t packedTotal = 0;
+    uint32_t packedMin = UINT32_MAX;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (i % CALIPER_FRAME_BITS == 0) CaliperInterface::frameSync.reset(ESP.getCycleCount(), true);
+        const uint32_t t0 = ESP.getCycleCount();
+        CaliperInterface::clockISR();
+        const uint32_t dt = ESP.getCycleCount() - t0;
+
+        packedTotal += dt;
+        if (dt < packedMin) packedMin = dt;
+    }
+
+    const uint32_t cyclesPerUs = getCpuFrequencyMhz();
+    CaliperInterface::frameSync.configure(SPC_MIN_BIT_PERIOD_US * cyclesPerUs, SPC_FRAME_GAP_US * cyclesPerUs);
+    CaliperInterface::frameSync.reset(ESP.getCycleCount(), true);
+    CaliperInterface::frameWord = 0;
+    CaliperInterface::dataReady = false;
+    pinMode(CLOCK_PIN, INPUT_PULLUP);
+
+    DEBUG_I("BENCH SPC ISR per bit: legacy avg=%u min=%u cycles, synced avg=%u min=%u cycles",
+        (unsigned)(legacyTotal / BENCH_ITERATIONS), (unsigned)legacyMin,
+        (unsigned)(packedTotal / BENCH_ITERATIONS), (unsigned)packedMin);
+}
+
+// Copy of the pre-1.1 decoder body (per-digit pow() and float math),
+// kept here only as the reference for benchSpcDecode().
+static float legacyDecodeFrame(uint64_t frame)
+{
+    static constexpr int FIRST_NIBBLE_BIT = CALIPER_FRAME_BITS - CALIPER_BIT_SHIFT - BITS_PER_NIBBLE;
+
+    auto nibble = [frame](int k) -> uint8_t {
+        return (uint8_t)((frame >> (FIRST_NIBBLE_BIT - k * BITS_PER_NIBBLE)) & 0x0F);
+    };
+
+    long value = 0;
+    for (int i = 0; i < CALIPER_DECIMAL_DIGITS; i++)
+        value += nibble(i) * pow(10, i);
+    const uint8_t flags = nibble(6);
+    bool negative = flags & 0x08;
+    bool inchMode = flags & 0x04;
+    float measurement = value / CALIPER_VALUE_DIVISOR;
+    if (negative)
+        measurement = -measurement;
+    if (inchMode)
+        measurement *= INCH_TO_MM_FACTOR;
+    return measurement;
+}
+
+void benchSpcDecode()
+{
+    // 12.34x mm; the lowest digit is varied per iteration so nothing folds
+    static constexpr uint64_t BASE_FRAME = 0x00004321000000ULL;
+    volatile float sink = 0.0f;
+
+    uint32_t legacyTotal = 0;
+    uint32_t legacyMin = UINT32_MAX;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const uint64_t frame = BASE_FRAME | ((uint64_t)(i % 10) << 40);
+        uint32_t t0 = ESP.getCycleCount();
+        sink = legacyDecodeFrame(frame);
+        uint32_t dt = ESP.getCycleCount() - t0;
+        legacyTotal += dt;
+        if (dt < legacyMin) legacyMin = dt;
+    }
+
+    uint32_t tableTotal = 0;
+    uint32_t tableMin = UINT32_MAX;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const uint64_t frame = BASE_FRAME | ((uint64_t)(i % 10) << 40);
+        uint32_t t0 = ESP.getCycleCount();
+        sink = spcDecodeFrame(frame);
+        uint32_t dt = ESP.getCycleCount() - t0;
+        tableTotal += dt;
+        if (dt < tableMin) tableMin = dt;
+    }
+    (void)sink;
+
+    DEBUG_I("BENCH SPC decode per frame: legacy avg=%u min=%u cycles, table avg=%u min=%u cycles",
+        (unsigned)(legacyTotal / BENCH_ITERATIONS), (unsigned)legacyMin,
+        (unsigned)(tableTotal / BENCH_ITERATIONS), (unsigned)tableMin);
+}
+#endif // defined(SPC)
+
+#if defined(RS485)
+#include "../sensors/rs485.h"
+#include "../sensors/p12d_parser.h"
+#include <math.h>
+#include <stdlib.h>
+#include <soc/gpio_reg.h>
+#include <soc/gpio_periph.h>
+
+static inline bool deRePinHigh()
+{
+    return (REG_READ(GPIO_IN_REG) >> RS485_DE_RE_PIN) & 1;
+}
+
+void benchRs485(RS485Interface &bus)
+{
+    if (bus.isContinuous())
+    {
+        DEBUG_W("RS485 benchmark skipped: the probe is streaming");
+        return;
+    }
+
+    auto runMode = [](RS485Interface &bus, bool hardware)
+    {
+        bus.configureDirection(hardware);
+        // Keep the pad input buffer on in both modes so DE/RE can be sampled
+        PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[RS485_DE_RE_PIN]);
+
+        // '?' + CR, 10 bits per character
+        const uint32_t wireUs = (2UL * 10UL * 1000000UL + RS485_BAUD_RATE - 1) / RS485_BAUD_RATE;
+
+        LatencyHistogram turnaround;
+        for (uint32_t i = 0; i < BENCH_RS485_TURNAROUND_ITERATIONS; i++)
+        {
+            uint32_t t0 = micros();
+            bus.sendQuery();
+            while (deRePinHigh() && micros() - t0 < RS485_RESPONSE_TIMEOUT_MS * 1000UL)
+            {
+            }
+            uint32_t dt = micros() - t0;
+            turnaround.record(dt > wireUs ? dt - wireUs : 0);
+
+            // Let the probe answer; the UART event task consumes the reply
+            delay(RS485_RESPONSE_TIMEOUT_MS / 10);
+        }
+
+        uint32_t ok = 0;
+        uint32_t failed = 0;
+        uint32_t start = millis();
+        while (millis() - start < BENCH_RS485_WINDOW_MS)
+        {
+            if (bus.performMeasurement() == INVALID_MEASUREMENT_VALUE) failed++;
+            else ok++;
+        }
+
+        DEBUG_I("RS485 %s direction: turnaround min=%u mean=%u max=%u us, %u queries/s (%u failed)",
+            hardware ? "UART RTS" : "GPIO",
+            (unsigned)turnaround.minUs(), (unsigned)turnaround.meanUs(), (unsigned)turnaround.maxUs(),
+            (unsigned)(ok * 1000UL / BENCH_RS485_WINDOW_MS), (unsigned)failed);
+    };
+
+    runMode(bus, false);
+    runMode(bus, true);
+
+    bus.configureDirection(RS485_HW_HALF_DUPLEX);
+}
+
+#define BENCH_P12D_LINES 64
+#define BENCH_P12D_LINE_SIZE 24
+
+void benchP12dParser()
+{
+    static char lines[BENCH_P12D_LINES][BENCH_P12D_LINE_SIZE];
+
+    uint32_t rng = 0x2545F491u;
+    auto next = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    for (uint32_t i = 0; i < BENCH_P12D_LINES; i++)
+    {
+        const int32_t um = (int32_t)(next() % 2000001u) - 1000000;
+        const int32_t mag = um < 0 ? -um : um;
+        snprintf(lines[i], BENCH_P12D_LINE_SIZE, "%s%ld.%03ld%s\r",
+            um < 0 ? "-" : "+", (long)(mag / 1000), (long)(mag % 1000), (i & 1) ? " mm" : "");
+    }
+
+    // Throughput: legacy line buffer + strtof vs. byte-wise fixed point
+    volatile float legacySink = 0.0f;
+    uint32_t t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        legacySink = strtof(lines[i % BENCH_P12D_LINES], nullptr);
+    }
+    const uint32_t legacyCycles = ESP.getCycleCount() - t0;
+
+    volatile int32_t parserSink = 0;
+    P12dParser parser;
+    t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        for (const char *c = lines[i % BENCH_P12D_LINES]; *c != '\0'; c++)
+        {
+            if (parser.feed(*c) == P12dParseStatus::VALUE)
+            {
+                parserSink = parser.micrometers();
+            }
+        }
+    }
+    const uint32_t parserCycles = ESP.getCycleCount() - t0;
+    (void)legacySink;
+    (void)parserSink;
+
+    DEBUG_I("P12D parse: strtof %u cycles/line, P12dParser %u cycles/line",
+        (unsigned)(legacyCycles / BENCH_ITERATIONS), (unsigned)(parserCycles / BENCH_ITERATIONS));
+}
+#endif // defined(RS485)
+
+#include "../sensors/tilt_kernel.h"
+#include <math.h>
+
+// Copy of the pre-3.4 AccelerometerInterface angle code (double-promoting
+// atan2/sqrt/acos), kept here only as the reference for benchTilt().
+static TiltAngles legacyTilt(float accX, float accY, float accZ)
+{
+    TiltAngles angle;
+    angle.x = atan2(accY, accZ) * RAD_TO_DEG;
+    angle.y = atan2(-accX, sqrt(accY * accY + accZ * accZ)) * RAD_TO_DEG;
+    float magnitude = sqrt(accX * accX + accY * accY + accZ * accZ);
+    if (magnitude > 0.001f)
+    {
+        angle.z = acos(fabs(accZ) / magnitude) * RAD_TO_DEG;
+        if (angle.z > 90.0f) angle.z = 90.0f;
+    }
+    else
+    {
+        angle.z = 0.0f;
+    }
+    return angle;
+}
+
+void benchTilt()
+{
+    // Accuracy over the sphere at 1 g (16 counts per 0.98 mg) and full scale
+    static constexpr int32_t MAGNITUDES[] = {16327, 32767};
+    double maxError = 0.0;
+    uint32_t checked = 0;
+    for (int32_t magnitude : MAGNITUDES)
+    {
+        for (int theta = 0; theta <= 180; theta += BENCH_TILT_GRID_DEG)
+        {
+            for (int phi = 0; phi < 360; phi += BENCH_TILT_GRID_DEG)
+            {
+                const double th = theta * DEG_TO_RAD;
+                const double ph = phi * DEG_TO_RAD;
+                const int32_t x = lround(magnitude * sin(th) * cos(ph));
+                const int32_t y = lround(magnitude * sin(th) * sin(ph));
+                const int32_t z = lround(magnitude * cos(th));
+
+                const TiltAngles fast = tiltFromCounts(x, y, z);
+                const double refX = atan2((double)y, (double)z) * RAD_TO_DEG;
+                const double refY = atan2(-(double)x, sqrt((double)y * y + (double)z * z)) * RAD_TO_DEG;
+                const double norm = sqrt((double)x * x + (double)y * y + (double)z * z);
+                const double refZ = acos(fabs((double)z) / norm) * RAD_TO_DEG;
+
+                // Roll wraps at ±180°
+                double errorX = fabs(fast.x - refX);
+                if (errorX > 180.0) errorX = 360.0 - errorX;
+                maxError = fmax(maxError, fmax(errorX, fmax(fabs(fast.y - refY), fabs(fast.z - refZ))));
+                checked++;
+            }
+        }
+    }
+
+    static int16_t vectors[BENCH_TILT_VECTORS][3];
+    uint32_t rng = 0x2545F491u;
+    for (uint32_t i = 0; i < BENCH_TILT_VECTORS; i++)
+    {
+        for (uint8_t axis = 0; axis < 3; axis++)
+        {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            vectors[i][axis] = (int16_t)rng;
+        }
+    }
+
+    volatile float sink = 0.0f;
+    uint32_t t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const int16_t *v = vectors[i % BENCH_TILT_VECTORS];
+        const TiltAngles angles = legacyTilt(v[0] * 0.98f * 0.001f, v[1] * 0.98f * 0.001f, v[2] * 0.98f * 0.001f);
+        sink = angles.x + angles.y + angles.z;
+    }
+    const uint32_t legacyCycles = ESP.getCycleCount() - t0;
+
+    t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const int16_t *v = vectors[i % BENCH_TILT_VECTORS];
+        const TiltAngles angles = tiltFromCounts(v[0], v[1], v[2]);
+        sink = angles.x + angles.y + angles.z;
+    }
+    const uint32_t kernelCycles = ESP.getCycleCount() - t0;
+    (void)sink;
+
+    DEBUG_I("Tilt: libm %u cycles/vector, kernel %u cycles/vector, max error %.5f deg over %u vectors (%s)",
+        (unsigned)(legacyCycles / BENCH_ITERATIONS), (unsigned)(kernelCycles / BENCH_ITERATIONS),
+        maxError, (unsigned)checked, maxError <= BENCH_TILT_MAX_ERROR_DEG ? "PASS" : "FAIL");
+}
+
+#if defined(RS485)
+void runBenchmarks(RS485Interface &bus)
+#else
+void runBenchmarks()
+#endif
+{
+    DEBUG_I("=== Benchmarks (%u iterations, CPU %u MHz) ===",
+        (unsigned)BENCH_ITERATIONS, (unsigned)getCpuFrequencyMhz());
+#if defined(SPC)
+    benchSpcCapture();
+    benchSpcDecode();
+#endif
+#if defined(RS485)
+    benchP12dParser();
+    benchRs485(bus);
+#endif
+    benchTilt();
+    DEBUG_I("=== Benchmarks done ===");
+}
+
+#endif // defined(ENABLE_BENCHMARK)
@@ -0,0 +1,104 @@
+/**
+ * @file bench.h
+ * @brief On-target micro-benchmarks for the slave firmware
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1 - RS485 direction control benchmark
+ * @version 1.2 - P12D parser benchmark
+ * @version 1.3 - Tilt kernel accuracy and cost
+ * @version 1.4 - RS485 benchmark runs on the firmware's sensor instance
+ * @version 1.5 - P12D parser correctness check moved to test/test_p12d_parser
+ *
+ * @details
+ * Benchmarks are compiled only with the ENABLE_BENCHMARK build flag
+ * (see env:caliper_slave_bench in platformio.ini). They run once from
+ * setup() and print their results through DEBUG_I, so the normal
+ * firmware image is not affected.
+ *
+ * Cycle counts are taken with ESP.getCycleCount() (CPU clock cycles).
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#if defined(ENABLE_BENCHMARK)
+
+#include <Arduino.h>
+#include "../config.h"
+
+/**
+ * @brief Number of iterations of each benchmarked operation
+ */
+#define BENCH_ITERATIONS 10000
+
+#if defined(SPC)
+/**
+ * @brief Compare the cost of one SPC bit in the legacy and current ISR
+ * @details CLOCK_PIN is driven as an output so that the ISRs see the
+ *          simulated clock level: both ISRs get one falling edge per
+ *          bit. Pin modes and frame synchroniser timing are restored
+ *          afterwards.
+ */
+void benchSpcCapture();
+
+/**
+ * @brief Compare the legacy pow()-based frame decoder with spcDecodeFrame()
+ */
+void benchSpcDecode();
+#endif
+
+#if defined(RS485)
+#include "../sensors/rs485.h"
+
+/**
+ * @brief Compare GPIO and UART hardware DE/RE direction control
+ * @details For each mode: bus turnaround after a query (time from the end
+ *          of the last stop bit until DE/RE is observed LOW on the pad) and
+ *          query/response rate against the attached probe over
+ *          BENCH_RS485_WINDOW_MS. The configured mode is restored afterwards.
+ *          Skipped while the probe is streaming.
+ * @param bus The firmware's started sensor; Serial1 is not opened twice
+ */
+void benchRs485(RS485Interface &bus);
+
+/**
+ * @brief Compare strtof() line parsing with P12dParser on random P12D lines
+ * @details Cycles only; correctness is checked on the host by
+ *          test/test_p12d_parser (pio test -e native_sim).
+ */
+void benchP12dParser();
+
+/**
+ * @brief Measurement window of the RS485 query rate benchmark
+ */
+#define BENCH_RS485_WINDOW_MS 2000
+#define BENCH_RS485_TURNAROUND_ITERATIONS 200
+#endif
+
+/**
+ * @brief Tilt kernel accuracy against libm and cycles per vector
+ * @details Accuracy: tiltFromCounts() vs. the double-precision libm angles
+ *          for directions on a BENCH_TILT_GRID_DEG grid over the full sphere
+ *          at 1 g and at the ±2 g full scale; the maximum error must stay
+ *          within BENCH_TILT_MAX_ERROR_DEG. Cost: the pre-3.4 double-promoting
+ *          angle code vs. tiltFromCounts() on BENCH_TILT_VECTORS vectors.
+ */
+void benchTilt();
+
+#define BENCH_TILT_GRID_DEG 1
+#define BENCH_TILT_MAX_ERROR_DEG 0.05
+#define BENCH_TILT_VECTORS 256
+
+/**
+ * @brief Run all benchmarks enabled for the current build
+ * @param bus (RS485 builds) The started sensor, see benchRs485()
+ */
+#if defined(RS485)
+void runBenchmarks(RS485Interface &bus);
+#else
+void runBenchmarks();
+#endif
+
+#endif // defined(ENABLE_BENCHMARK)
+
+#endif // BENCH_H
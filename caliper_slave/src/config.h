@@ -41,6 +41,221 @@
 // Slave-specific Settings
 // ============================================================================
 
+/**
+ * @brief SPC capture mode (also enables RS485_CONTINUOUS_OUTPUT)
+ * 1 = free-running: the caliper is triggered once at startup and every frame
+ *     is queued with a timestamp; reads are answered from the newest frames.
+ * 0 = one-shot: each read triggers the caliper and waits for one frame.
+ */
+#define CALIPER_CONTINUOUS_CAPTURE 1
+
+/**
+ * @brief SPC frame synchroniser timing (GPIO interrupt capture; the SPI
+ * capture also waits for SPC_FRAME_GAP_US of idle CLOCK before a frame)
+ * Falling CLOCK edges closer than SPC_MIN_BIT_PERIOD_US to the previous one
+ * are treated as glitches. A falling edge more than SPC_FRAME_GAP_US after
+ * the previous one starts a new frame; it must be longer than any bit
+ * period inside a frame and shorter than the pause between frames.
+ */
+#define SPC_MIN_BIT_PERIOD_US 10
+#define SPC_FRAME_GAP_US 2000
+
+/**
+ * @brief SPI-slave DMA capture backend (build flag SPC_CAPTURE_SPI, next to SPC)
+ * CLOCK/DATA are routed to the SPI slave through the GPIO matrix; the CS pad is
+ * only claimed by the driver and overridden internally, so it must be a free,
+ * unconnected GPIO. The glitch filter rejects clock pulses shorter than this.
+ */
+#define SPC_SPI_HOST SPI2_HOST
+#define SPC_SPI_CS_PIN 14
+#define SPC_SPI_GLITCH_FILTER_NS 1000
+
+/**
+ * @brief RS485 direction control
+ * 1 = UART hardware RS485 half-duplex mode: the UART RTS output drives the
+ *     MAX485 DE/RE pin and releases the bus right after the last stop bit.
+ * 0 = software control: DE/RE toggled with digitalWrite around flush() and
+ *     a fixed guard delay.
+ */
+#define RS485_HW_HALF_DUPLEX 1
+
+/**
+ * @brief RS485 continuous-output (streaming) mode
+ * 1 = the probe is switched to continuous position output at startup
+ *     (RS485_STREAM_START_CMD, together with CALIPER_CONTINUOUS_CAPTURE);
+ *     every line is parsed as it arrives and reads are answered from the
+ *     newest RS485_STREAM_RING_SIZE timestamped positions.
+ * 0 = one '?' query per reading.
+ */
+#define RS485_CONTINUOUS_OUTPUT 0
+
+/**
+ * @brief Number of P12D probes on the RS485 bus (1..RS485_MAX_PROBES)
+ * 1  = single probe: unaddressed '?' query, reply in MessageSlave.
+ * >1 = multi-drop: channel n is queried at RS485_PROBE_ADDRESSES[n] with
+ *      RS485_ADDRESSED_QUERY_FORMAT, all channels are polled round-robin
+ *      and the reply to the master is one MessageSlaveMulti.
+ */
+#define RS485_PROBE_COUNT 1
+
+// ============================================================================
+// Accelerometer (IIS328DQ background sampler, see sensors/accelerometer.h)
+// ============================================================================
+
+/**
+ * @brief IIS328DQ output data rate, CTRL_REG1 DR bits
+ * 0 = 50 Hz, 1 = 100 Hz, 2 = 400 Hz, 3 = 1000 Hz
+ */
+#define ACCEL_ODR_SELECT 2
+
+/**
+ * @brief Background sampler
+ * A FreeRTOS task reads one XYZ vector every ACCEL_SAMPLE_PERIOD_MS into a
+ * ring of the newest ACCEL_RING_SIZE vectors (power of two). The tilt is the
+ * angle of the average of the newest ACCEL_WINDOW_SAMPLES vectors; a window
+ * whose newest vector is older than ACCEL_STALE_MS is rejected.
+ */
+#define ACCEL_SAMPLE_PERIOD_MS 5
+#define ACCEL_RING_SIZE 64
+#define ACCEL_WINDOW_SAMPLES 32
+#define ACCEL_STALE_MS 100
+#define ACCEL_TASK_STACK_SIZE 3072
+#define ACCEL_TASK_PRIORITY 3
+#define ACCEL_TASK_CORE 1
+
+/**
+ * @brief IIS328DQ INT1 data-ready pacing
+ * GPIO wired to the IIS328DQ INT1 pin, or -1 when not connected.
+ * With a pin, INT1 signals data-ready and the sampler reads every new vector
+ * exactly once (ACCEL_SAMPLE_PERIOD_MS is then unused; the window spans
+ * ACCEL_WINDOW_SAMPLES / ODR). Without it the sampler is timer-paced.
+ */
+#define ACCEL_DRDY_PIN -1
+#define ACCEL_I2C_CLOCK_HZ 400000
+
+/**
+ * @brief Vibration gate before capture (see sensors/vibration_monitor.h)
+ * The sampled acceleration is high-pass filtered at VIB_HPF_CUTOFF_HZ (removes
+ * gravity and tilt); RMS and peak of its magnitude are tracked over the newest
+ * VIB_WINDOW_SAMPLES samples (<= VIB_MAX_WINDOW). After the motor move,
+ * runMeasReq() waits until RMS <= VIB_QUIET_RMS_MG and peak <= VIB_QUIET_PEAK_MG,
+ * polling every VIB_POLL_MS, and captures anyway after VIB_MAX_WAIT_MS.
+ * Without settle detection the same gate also ends the forward stroke early
+ * (first quiet window after the ramp-up, msgMaster.timeout at most).
+ * VIB_MAX_WAIT_MS 0 disables the gate (the level is still reported).
+ */
+#define VIB_HPF_CUTOFF_HZ 1.0f
+#define VIB_WINDOW_SAMPLES 64
+#define VIB_QUIET_RMS_MG 8.0f
+#define VIB_QUIET_PEAK_MG 25.0f
+#define VIB_MAX_WAIT_MS 1000
+#define VIB_POLL_MS 5
+
+// ============================================================================
+// Settle Detection (forward stroke, see sensors/settle_detector.h)
+// ============================================================================
+// While the motor drives forward the length sensor is read every
+// SETTLE_POLL_MS (newest streamed frame, or a one-shot read without a
+// stream). The capture starts as soon as the jaw has moved and then
+// SETTLE_FRAMES consecutive frame-to-frame steps are within
+// SETTLE_TOLERANCE_MM; msgMaster.timeout is only the upper bound.
+// SETTLE_DETECTION 0 ends the stroke on the vibration gate instead (fixed
+// msgMaster.timeout wait when VIB_MAX_WAIT_MS is 0). Not used with several
+// RS485 probes (one-shot reads would poll the whole bus).
+#define SETTLE_DETECTION 1
+#define SETTLE_TOLERANCE_MM 0.002f
+#define SETTLE_FRAMES 3
+#define SETTLE_POLL_MS 5
+
+// ============================================================================
+// Burst Measurement (CMD_BURST)
+// ============================================================================
+// Samples come from the fastest acquisition path: a new streamed frame when
+// continuous capture runs (polled every BURST_POLL_MS), otherwise one
+// performMeasurement() per sample. Limits are in shared_config.h.
+#define BURST_POLL_MS 1
+
+// ============================================================================
+// Telemetry Streaming (CMD_STREAM)
+// ============================================================================
+// Flow control: a packet is held back (and keeps filling, oldest samples
+// dropped once STREAM_SAMPLES_PER_FRAME are buffered) while this many frames
+// are not yet confirmed by the send callback, or this many replies wait in
+// the communication queue. Rates and limits are in shared_config.h.
+#define STREAM_MAX_IN_FLIGHT 2
+#define STREAM_QUEUE_HIGH_WATER 2
+
+// ============================================================================
+// Battery ADC (continuous DMA sampling, see power/battery.h)
+// ============================================================================
+
+/**
+ * @brief Continuous sampling of BATTERY_VOLTAGE_PIN
+ * The ADC converts at BATTERY_ADC_SAMPLE_RATE_HZ (>= 611 Hz on the S3) into DMA
+ * frames of BATTERY_ADC_OVERSAMPLING conversions. Each frame is averaged into
+ * one reading (about 4 per second with the defaults), converted with the
+ * eFuse calibration and fed to the BATTERY_FILTER_ALPHA filter by a
+ * background task.
+ */
+#define BATTERY_ADC_SAMPLE_RATE_HZ 1000
+#define BATTERY_ADC_OVERSAMPLING 256
+#define BATTERY_TASK_STACK_SIZE 3072
+#define BATTERY_TASK_PRIORITY 1
+#define BATTERY_TASK_CORE 0
+
+// ============================================================================
+// Motor Motion Profile (trapezoidal PWM ramps, see motor/motion_profile.h)
+// ============================================================================
+// Control period of the ramp executor (esp_timer). Ramp lengths and the
+// forward end duty come from MessageMaster (rampUpMs, rampDownMs, holdPercent).
+// 2 ms keeps a full 0-255 ramp of 100 ms within ~5 PWM steps per update.
+#define MOTOR_PROFILE_PERIOD_MS 2
+
+// ============================================================================
+// Reliable Measurement (consensus engine, see sensors/consensus.h)
+// ============================================================================
+
+/**
+ * @brief Default consensus criterion for performReliableMeasurement()
+ * K_OF_M with k = 2, m = 2, tolerance 0 is the original rule: two
+ * consecutive identical readings. Widen m / tolerance for parts that sit
+ * near a graduation boundary, or switch to MEDIAN / TRIMMED_MEAN.
+ */
+#define CONSENSUS_STRATEGY ConsensusStrategy::K_OF_M
+#define CONSENSUS_K 2
+#define CONSENSUS_M 2
+#define CONSENSUS_TRIM 0
+#define CONSENSUS_TOLERANCE_MM 0.0f
+#define CONSENSUS_DEFAULT_CONFIG \
+    {CONSENSUS_STRATEGY, CONSENSUS_K, CONSENSUS_M, CONSENSUS_TRIM, CONSENSUS_TOLERANCE_MM, RELIABLE_MEASUREMENT_TIMEOUT_MS}
+
+// ============================================================================
+// Task Architecture (see main.cpp)
+// ============================================================================
+// WiFi and ESP-NOW run on core 0. The measurement task (state machine,
+// length sensor, motor) and the accelerometer sampler get core 1, so
+// captures are not delayed by radio activity. The communication task (ESP-NOW
+// receive handling, replies with retries, pairing) and housekeeping (battery,
+// LEDs) stay next to the WiFi stack. Arduino loop() only serves OTA.
+#define MEASURE_TASK_STACK_SIZE 6144
+#define MEASURE_TASK_PRIORITY 2
+#define MEASURE_TASK_CORE 1
+#define MEASURE_QUEUE_LENGTH 4          // Commands waiting for the measurement task
+#define MEASURE_TASK_IDLE_MS 100        // Longest sleep while no phase is scheduled
+
+#define COMM_TASK_STACK_SIZE 4096
+#define COMM_TASK_PRIORITY 3
+#define COMM_TASK_CORE 0
+#define COMM_QUEUE_LENGTH 8             // Received messages and pending replies
+#define COMM_QUEUE_SEND_TIMEOUT_MS 50   // Measurement task wait when the queue is full
+
+#define HOUSEKEEPING_TASK_STACK_SIZE 3072
+#define HOUSEKEEPING_TASK_PRIORITY 1
+#define HOUSEKEEPING_TASK_CORE 0
+#define HOUSEKEEPING_PERIOD_MS 100      // LED update; battery every BATTERY_UPDATE_INTERVAL_MS
+
+#define LOOP_IDLE_MS 10
+
 // ============================================================================
 // OTA Configuration
 // ============================================================================
@@ -7,52 +7,182 @@
 #include <error_handler.h>
 #include <MacroDebugger.h>
 #include <espnow_helper.h>
+#include <wire_protocol.h>
 #include <arduino-timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <atomic>
 
 // Module includes
-#if defined(SPC) && defined(RS485)
-  #error "Define only one of SPC or RS485"
+#if (defined(SPC) + defined(RS485) + defined(SIM_SENSOR)) > 1
+  #error "Define only one of SPC, RS485 or SIM_SENSOR"
 #elif defined(SPC)
   #include "sensors/caliper.h"
+  using SensorType = CaliperInterface;
 #elif defined(RS485)
   #include "sensors/rs485.h"
+  using SensorType = RS485Interface;
+#elif defined(SIM_SENSOR)
+  #include "sensors/simulated_sensor.h"
+  using SensorType = SimulatedSensor;
 #else
-  #error "Define either SPC or RS485 build flag"
+  #error "Define either SPC, RS485 or SIM_SENSOR build flag"
+#endif
+static_assert(isLengthSensor<SensorType>(), "Selected sensor backend does not implement LengthSensor");
+
+// Several addressed probes on one RS485 bus: reply with MessageSlaveMulti
+#if defined(RS485) && RS485_PROBE_COUNT > 1
+  #define SLAVE_MULTI_PROBE 1
+#else
+  #define SLAVE_MULTI_PROBE 0
 #endif
 #include "sensors/accelerometer.h"
+#include "sensors/settle_detector.h"
 #include "power/battery.h"
 #include "motor/motor_ctrl.h"
 #include "ota/ota_update.h"
+#if defined(ENABLE_BENCHMARK)
+  #include "bench/bench.h"
+#endif
 
 uint8_t masterAddress[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+// Protocol version and sequences towards Master (communication task only)
+static WirePeer masterWire;
 
 Preferences slavePrefs;
 esp_now_peer_info_t peerInfo;
-#if defined(SPC)
-CaliperInterface caliper;
-#elif defined(RS485)
-RS485Interface caliper;
-#endif
+SensorType caliper;
 AccelerometerInterface accelerometer;
 BatteryMonitor battery;
 MessageMaster msgMaster;
 MessageSlave msgSlave;
+#if SLAVE_MULTI_PROBE
+MessageSlaveMulti msgSlaveMulti;
+#endif
 
 volatile bool measurementInProgress = false;
 
+/**
+ * @brief Work item of the communication task
+ * @details RECEIVED carries a MessageMaster from OnDataRecv, SEND a reply
+ *          (MessageSlave, MessageSlaveMulti or MessageSlaveBurst) or a
+ *          telemetry packet (MessageSlaveStream) from the measurement task.
+ *          Encoding (wire_send()) happens in the communication task, which
+ *          owns masterWire.
+ */
+enum class CommEventType : uint8_t
+{
+  RECEIVED,
+  SEND
+};
+
+struct CommEvent
+{
+  CommEventType type;
+  WireType wireType;     /**< Message in msg */
+  uint8_t wireFlags;     /**< SEND: WireFlag bits */
+  uint8_t wireVersion;   /**< RECEIVED: protocol version of the frame */
+  uint16_t wireSequence; /**< RECEIVED: v2 sequence of the frame */
+  uint8_t attempts;      /**< SEND: esp_now_send() attempts (1 = best effort) */
+  uint8_t mac[6];        /**< Sender of a RECEIVED message */
+  union
+  {
+    MessageMaster master;
+    MessageSlave slave;
+    MessageSlaveMulti multi;
+    MessageSlaveBurst burst;
+    MessageSlaveStream stream;
+  } msg;
+};
+
+static QueueHandle_t commQueue = nullptr;     // OnDataRecv / measurement task -> communication task
+static QueueHandle_t measureQueue = nullptr;  // communication task -> measurement task (MessageMaster)
+static TaskHandle_t measureTaskHandle = nullptr;
+static TaskHandle_t commTaskHandle = nullptr;
+static TaskHandle_t housekeepingTaskHandle = nullptr;
+
+/**
+ * @brief Phases of the measurement cycle (see runMeasReq())
+ */
+enum class MeasurePhase : uint8_t
+{
+  IDLE,
+  MOTOR_FORWARD,  /**< Probe moving onto the part until it settles, at most msgMaster.timeout */
+  SETTLE,         /**< Waiting for a still fixture, at most VIB_MAX_WAIT_MS */
+  BURST,          /**< CMD_BURST: one sample per step until msgMaster.burstCount */
+  ACQUIRE,        /**< Length, angle and battery */
+  REPORT,         /**< Reverse stroke started, result sent while it runs */
+  MOTOR_REVERSE,  /**< Probe moving back until msgMaster.timeout after REPORT began */
+  COUNT
+};
+
+static const char *const MEASURE_PHASE_NAMES[] = {"idle", "forward", "settle", "burst", "acquire", "report", "reverse"};
+static_assert(sizeof(MEASURE_PHASE_NAMES) / sizeof(MEASURE_PHASE_NAMES[0]) == (size_t)MeasurePhase::COUNT,
+  "MEASURE_PHASE_NAMES out of sync with MeasurePhase");
+
+static MeasurePhase measurePhase = MeasurePhase::IDLE;
+static uint32_t measureCycleStartMs = 0;
+static uint32_t measurePhaseStartMs = 0;
+static uint32_t reverseStartMs = 0;
+static uint32_t measurePhaseMs[(size_t)MeasurePhase::COUNT];
+
+// Jaw settle detection during MOTOR_FORWARD
+#define SETTLE_ACTIVE (SETTLE_DETECTION && !SLAVE_MULTI_PROBE)
+#if SETTLE_ACTIVE
+static SettleDetector settleDetector({SETTLE_TOLERANCE_MM, SETTLE_FRAMES, true});
+#endif
+
+// CMD_BURST samples, sent as MessageSlaveBurst frames after the last one
+static BurstSample burstSamples[BURST_MAX_SAMPLES];
+static uint8_t burstTaken = 0;
+static uint32_t burstDueMs = 0;        // When the next sample should be taken
+static uint32_t burstFirstFrameMs = 0;
+static uint32_t burstLastFrameUs = 0;   // Capture time of the frame of the previous sample
+
+// Telemetry subscription (CMD_STREAM), sampled by the measurement task
+static bool streamActive = false;
+static uint16_t streamPeriodMs = 0;
+static uint8_t streamBatch = 1;          // Samples per packet after the packet rate limit
+static uint32_t streamRenewedMs = 0;     // Last CMD_STREAM from Master (keepalive)
+static uint32_t streamLastFrameUs = 0;   // Capture time of the last sampled frame
+static uint32_t streamLastSampleMs = 0;  // Time of the last buffered sample
+static uint16_t streamSequence = 0;
+static uint16_t streamDropped = 0;       // Since the previous packet
+static uint32_t streamTimestamps[STREAM_SAMPLES_PER_FRAME];
+static StreamSample streamSamples[STREAM_SAMPLES_PER_FRAME];
+static uint8_t streamCount = 0;
+
+// Frames handed to esp_now_send() and not yet reported by OnDataSent
+// (communication task and the Wi-Fi task)
+static std::atomic<uint8_t> sendsInFlight{0};
+
 OTAUpdate otaUpdate;
 volatile bool otaMode = false;
 
-static bool pairingMode = false;
+// Owned by the communication task; read by housekeeping for the LED
+static volatile bool pairingMode = false;
 static uint32_t pairingModeStartMs = 0;
-static bool hasStoredMasterMac = false;
+static volatile bool hasStoredMasterMac = false;
 
 bool runMeasReq(void *arg);
-bool motorStopTimeout(void *arg);
-bool batteryMonitorTask(void *arg);
+bool measureCycleStep(void *arg);
+void cancelMeasureCycle(const char *reason);
+static bool streamTick(void *arg);
+// Phases of the measurement cycle; ticked only by the measurement task
 auto timerWorker = timer_create_default();
-auto timerMotorStopTimeout = timer_create_default();
-auto timerBattery = timer_create_default();
+// Telemetry sampling, separate so that cancelling the cycle keeps it running
+auto timerStream = timer_create_default();
+
+/**
+ * @brief millis() time of a LengthSensor::readLatest() timestamp
+ * @details For reporting only; the µs timestamp identifies the frame, its
+ *          ms value jitters with the time of the conversion.
+ */
+static uint32_t frameMillis(uint32_t timestampUs)
+{
+  return millis() - (micros() - timestampUs) / 1000U;
+}
 
 static bool isMacUnset(const uint8_t mac[6])
 {
@@ -91,133 +221,421 @@ static void exitPairingMode()
 /**
  * @brief ESP-NOW data receive callback from Master
  *
- * This function is called automatically by ESP-NOW upon receiving
- * a packet from Master. It handles various commands and schedules
- * appropriate actions using a timer.
+ * Runs in the WiFi task. Only decodes the frame (v2 header and CRC, or v1
+ * length) and hands the message to the communication task (commQueue);
+ * pairing and command dispatch happen there, so the radio stack is never
+ * held up by them.
+ *
+ * @param recv_info Sender information
+ * @param incomingData Buffer with received data
+ * @param len Length of received data
+ */
+void OnDataRecv(const esp_now_recv_info_t *recv_info, const uint8_t *incomingData, int len)
+{
+  WireFrame frame{};
+  if (wire_decode(incomingData, len, frame) != ERR_NONE)
+  {
+    return;
+  }
+  if (frame.type != WIRE_MASTER)
+  {
+    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Received message type %u, expected %u (Master)",
+      (unsigned)frame.type, (unsigned)WIRE_MASTER);
+    return;
+  }
+
+  CommEvent ev{};
+  ev.type = CommEventType::RECEIVED;
+  ev.wireType = frame.type;
+  ev.wireVersion = frame.version;
+  ev.wireSequence = frame.sequence;
+  memcpy(ev.mac, recv_info->src_addr, 6);
+  memcpy(&ev.msg.master, frame.payload, frame.length);
+  if (frame.length <= offsetof(MessageMaster, holdPercent))
+  {
+    // A master without motion profile runs the whole stroke at motorSpeed
+    ev.msg.master.holdPercent = 100;
+  }
+
+  if (xQueueSend(commQueue, &ev, 0) != pdTRUE)
+  {
+    DEBUG_W("Command queue full - command %c dropped", ev.msg.master.command);
+  }
+}
+
+/**
+ * @brief Handle a message from Master (communication task)
  *
  * @details
- * Supported commands:
+ * Pairing (CMD_PAIR / CMD_PAIR_ACK) is handled here. Replies go out in the
+ * protocol version of the last command (masterWire); a repeated v2 frame is
+ * dropped. Commands for the measurement cycle are forwarded to the
+ * measurement task:
  * - CMD_MEASURE: measurement request with motor activation
  * - CMD_UPDATE: status update request without motor
- * - CMD_MOTORTEST: motor test with parameters from msgMaster
+ * - CMD_MOTORTEST: motor test with parameters from the message
+ * - CMD_BURST: burstCount samples without motor
+ * - CMD_STREAM: start, renew or stop the telemetry subscription
+ * - CMD_OTA: cancel a running cycle, then enter OTA mode
  *
  * Measurement locking mechanism:
- * - If measurementInProgress == true, all commands are ignored
- * - The flag is set at the start of runMeasReq and cleared at the end
- * - This prevents ongoing measurements from being disrupted by new commands
- *
- * Timer mechanism:
- * - timerWorker.cancel() cancels all scheduled tasks
- * - timerWorker.in(TIMER_DELAY_MS, runMeasReq) schedules runMeasReq for execution
- * - TIMER_DELAY_MS (1ms) provides minimal delay before execution
- *
- * Note: This function should not block execution, so we use a timer
- * to defer execution of time-consuming operations.
+ * - While measurementInProgress == true, the measurement task ignores
+ *   commands (and msgMaster, which the running cycle reads, is left untouched)
+ * - The flag is set at the start of runMeasReq and cleared when the
+ *   measurement cycle is back in IDLE
  *
- * @param recv_info Sender information (unused)
- * @param incomingData Buffer with received data
- * @param len Length of received data
+ * @param ev RECEIVED event from OnDataRecv
  */
-void OnDataRecv(const esp_now_recv_info_t *recv_info, const uint8_t *incomingData, int len)
+static void handleReceived(const CommEvent &ev)
 {
-  uint8_t src_addr[6];
-  memcpy(src_addr, recv_info->src_addr, 6);
+  const MessageMaster &tmpMsg = ev.msg.master;
+  const uint8_t *src_addr = ev.mac;
 
-  if (len == sizeof(MessageMaster))
+  // Pairing broadcasts reach paired slaves as well; they must not switch the version
+  if (tmpMsg.command == CMD_PAIR && !pairingMode)
   {
-    MessageMaster tmpMsg{};
-    memcpy(&tmpMsg, incomingData, sizeof(tmpMsg));
+    return;
+  }
+  if (!wire_peer_accept(masterWire, ev.wireVersion, ev.wireSequence))
+  {
+    DEBUG_W("Repeated frame %u from Master dropped", (unsigned)ev.wireSequence);
+    return;
+  }
 
-    if (pairingMode && tmpMsg.command == CMD_PAIR)
+  if (pairingMode && tmpMsg.command == CMD_PAIR)
+  {
+    if (hasStoredMasterMac)
     {
-      if (hasStoredMasterMac)
-      {
-        esp_now_del_peer(masterAddress);
-      }
-      memcpy(masterAddress, src_addr, 6);
+      esp_now_del_peer(masterAddress);
+    }
+    memcpy(masterAddress, src_addr, 6);
 
-      memset(&peerInfo, 0, sizeof(peerInfo));
-      memcpy(peerInfo.peer_addr, masterAddress, 6);
-      peerInfo.channel = ESPNOW_WIFI_CHANNEL;
-      peerInfo.encrypt = false;
-      espnow_add_peer_with_retry(&peerInfo);
+    memset(&peerInfo, 0, sizeof(peerInfo));
+    memcpy(peerInfo.peer_addr, masterAddress, 6);
+    peerInfo.channel = ESPNOW_WIFI_CHANNEL;
+    peerInfo.encrypt = false;
+    espnow_add_peer_with_retry(&peerInfo);
+    // New master: keep the version of its CMD_PAIR, forget its sequence
+    const uint8_t pairVersion = masterWire.version;
+    wire_peer_reset(masterWire, pairVersion);
 
-      slavePrefs.putBytes("masterMac", src_addr, 6);
-      hasStoredMasterMac = true;
+    slavePrefs.putBytes("masterMac", src_addr, 6);
+    hasStoredMasterMac = true;
 
-      MessageSlave pairResp{};
-      pairResp.command = CMD_PAIR;
-      pairResp.measurement = 0;
-      pairResp.batteryVoltage = 0;
-      pairResp.angleZ = 0;
-      espnow_send_with_retry(masterAddress, &pairResp, sizeof(pairResp), ESPNOW_MAX_RETRIES, ESPNOW_RETRY_DELAY_MS);
+    MessageSlave pairResp{};
+    pairResp.command = CMD_PAIR;
+    pairResp.measurement = 0;
+    pairResp.batteryVoltage = 0;
+    pairResp.angleZ = 0;
+    pairResp.requestId = tmpMsg.requestId;
+    wire_send(masterWire, masterAddress, WIRE_SLAVE, 0, &pairResp);
 
-      exitPairingMode();
+    exitPairingMode();
 
-      DEBUG_I("Received CMD_PAIR from Master: %02X:%02X:%02X:%02X:%02X:%02X",
-        src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
-      return;
-    }
+    DEBUG_I("Received CMD_PAIR from Master: %02X:%02X:%02X:%02X:%02X:%02X",
+      src_addr[0], src_addr[1], src_addr[2], src_addr[3], src_addr[4], src_addr[5]);
+    return;
+  }
 
-    if (tmpMsg.command == CMD_PAIR_ACK)
+  switch (tmpMsg.command)
+  {
+  case CMD_PAIR_ACK:
+    slavePrefs.putBytes("masterMac", src_addr, 6);
+    hasStoredMasterMac = true;
+    exitPairingMode();
+    DEBUG_I("Pairing completed");
+    break;
+
+  case CMD_PAIR:
+    break;
+
+  case CMD_MEASURE:
+  case CMD_UPDATE:
+  case CMD_MOTORTEST:
+  case CMD_BURST:
+  case CMD_STREAM:
+  case CMD_OTA:
+    if (xQueueSend(measureQueue, &tmpMsg, 0) != pdTRUE)
     {
-      slavePrefs.putBytes("masterMac", src_addr, 6);
-      hasStoredMasterMac = true;
-      exitPairingMode();
-      DEBUG_I("Pairing completed");
-      return;
+      DEBUG_W("Measurement task busy - command %c dropped", tmpMsg.command);
     }
+    break;
+
+  default:
+    DEBUG_W("Unknown command: %c", tmpMsg.command);
+    break;
+  }
+}
+
+/**
+ * @brief Hand the buffered telemetry samples to the communication task
+ *
+ * Flow control: while the radio still has STREAM_MAX_IN_FLIGHT frames
+ * unconfirmed, or the communication queue is backed up, the samples stay
+ * buffered and the packet grows instead (streamTick() drops the oldest
+ * sample once the buffer is full). Stream packets are sent best effort,
+ * without retries; the next packet carries newer data anyway.
+ *
+ * @param force Send even if fewer than streamBatch samples are buffered
+ */
+static void flushStream(bool force)
+{
+  if (streamCount == 0 || (!force && streamCount < streamBatch))
+  {
+    return;
+  }
+  if (!force && (sendsInFlight >= STREAM_MAX_IN_FLIGHT
+    || uxQueueMessagesWaiting(commQueue) >= STREAM_QUEUE_HIGH_WATER))
+  {
+    return;
+  }
+
+  CommEvent ev{};
+  ev.type = CommEventType::SEND;
+  ev.wireType = WIRE_SLAVE_STREAM;
+  ev.wireFlags = WIRE_FLAG_BEST_EFFORT;
+  ev.attempts = 1;
+
+  MessageSlaveStream &msg = ev.msg.stream;
+  msg.command = CMD_STREAM;
+  msg.sampleCount = streamCount;
+  msg.sequence = streamSequence;
+  msg.droppedSamples = streamDropped;
+  msg.periodMs = streamPeriodMs;
+  msg.firstTimestampMs = streamTimestamps[0];
+  msg.batteryVoltage = battery.readVoltageNow();
+  for (uint8_t i = 0; i < streamCount; i++)
+  {
+    msg.samples[i] = streamSamples[i];
+    const uint32_t offsetMs = streamTimestamps[i] - streamTimestamps[0];
+    msg.samples[i].offsetMs = offsetMs > UINT16_MAX ? UINT16_MAX : (uint16_t)offsetMs;
+  }
 
-    memcpy(&msgMaster, &tmpMsg, sizeof(msgMaster));
+  if (xQueueSend(commQueue, &ev, 0) != pdTRUE)
+  {
+    // Keep the samples for the next attempt
+    return;
+  }
+  streamSequence++;
+  streamDropped = 0;
+  streamCount = 0;
+}
+
+/**
+ * @brief Telemetry sample (measurement task, every streamPeriodMs)
+ * @details Samples only the sensor's continuous stream, never a blocking
+ *          one-shot read, and only frames not sampled before; without a
+ *          new frame for MEASUREMENT_TIMEOUT_MS a CHANNEL_TIMEOUT sample is
+ *          sent. Skipped while a measurement cycle uses the sensor. Stops
+ *          by itself when Master has not renewed the subscription for
+ *          STREAM_KEEPALIVE_TIMEOUT_MS (Master gone or out of range).
+ * @return true while streaming (repeat)
+ */
+static bool streamTick(void *arg)
+{
+  (void)arg;
+  if (!streamActive)
+  {
+    return false;
+  }
+  if (millis() - streamRenewedMs >= STREAM_KEEPALIVE_TIMEOUT_MS)
+  {
+    DEBUG_W("Telemetry stopped - no renewal from Master for %u ms", (unsigned)STREAM_KEEPALIVE_TIMEOUT_MS);
+    streamActive = false;
+    return false;
+  }
+  if (measurementInProgress)
+  {
+    return true;
+  }
+
+  const uint32_t now = millis();
+  float valueMm = INVALID_MEASUREMENT_VALUE;
+  uint32_t frameUs;
+  uint32_t frameMs;
+  StreamSample sample{};
+  // isContinuous() first: readLatest() falls back to a one-shot read
+  bool fresh = caliper.isContinuous() && caliper.readLatest(valueMm, frameUs)
+    && (streamLastSampleMs == 0 || frameUs != streamLastFrameUs);
+  if (fresh)
+  {
+    frameMs = frameMillis(frameUs);
+    fresh = now - frameMs <= MEASUREMENT_TIMEOUT_MS;
+  }
+  if (fresh)
+  {
+    streamLastFrameUs = frameUs;
+    sample.status = (valueMm == INVALID_MEASUREMENT_VALUE) ? CHANNEL_INVALID
+      : (valueMm < MEASUREMENT_MIN_VALUE || valueMm > MEASUREMENT_MAX_VALUE) ? CHANNEL_OUT_OF_RANGE
+      : CHANNEL_OK;
+  }
+  else if (now - streamLastSampleMs >= MEASUREMENT_TIMEOUT_MS)
+  {
+    sample.status = CHANNEL_TIMEOUT;
+    frameMs = now;
+  }
+  else
+  {
+    return true; // No new frame yet
+  }
+  streamLastSampleMs = now;
+  sample.measurement = (sample.status == CHANNEL_OK) ? valueMm : INVALID_MEASUREMENT_VALUE;
+  accelerometer.update();
+  sample.angleZ = (uint8_t)accelerometer.getAngleZ();
 
-    if (measurementInProgress)
+  // Buffer full because flow control held the packet back: drop the oldest
+  if (streamCount == STREAM_SAMPLES_PER_FRAME)
+  {
+    memmove(&streamSamples[0], &streamSamples[1], (STREAM_SAMPLES_PER_FRAME - 1) * sizeof(StreamSample));
+    memmove(&streamTimestamps[0], &streamTimestamps[1], (STREAM_SAMPLES_PER_FRAME - 1) * sizeof(uint32_t));
+    streamCount--;
+    if (streamDropped < UINT16_MAX)
     {
-      DEBUG_W("Measurement in progress - command %c ignored", msgMaster.command);
-      return;
+      streamDropped++;
     }
+  }
+  streamSamples[streamCount] = sample;
+  streamTimestamps[streamCount] = frameMs;
+  streamCount++;
+
+  flushStream(false);
+  return true;
+}
 
-    switch (msgMaster.command)
+/**
+ * @brief Start, renew or stop the telemetry subscription (measurement task)
+ * @param cmd CMD_STREAM with streamPeriodMs (0 = stop) and streamBatch
+ */
+static void handleStreamCommand(const MessageMaster &cmd)
+{
+  if (cmd.streamPeriodMs == 0)
+  {
+    if (streamActive)
     {
-    case CMD_MEASURE:
-      DEBUG_I("CMD_MEASURE");
-      timerWorker.cancel();
-      timerWorker.in(TIMER_DELAY_MS, runMeasReq);
-      break;
+      flushStream(true);
+      timerStream.cancel();
+      streamActive = false;
+      DEBUG_I("Telemetry stopped by Master");
+    }
+    return;
+  }
 
-    case CMD_UPDATE:
-      DEBUG_I("CMD_UPDATE");
-      timerWorker.cancel();
-      timerWorker.in(TIMER_DELAY_MS, runMeasReq);
-      break;
+  const uint16_t period = cmd.streamPeriodMs < STREAM_MIN_PERIOD_MS ? STREAM_MIN_PERIOD_MS
+    : (cmd.streamPeriodMs > STREAM_MAX_PERIOD_MS ? STREAM_MAX_PERIOD_MS : cmd.streamPeriodMs);
+  // At high rates more samples go into one packet to cap the packet rate
+  const uint8_t minBatch = (uint8_t)((STREAM_MIN_PACKET_INTERVAL_MS + period - 1) / period);
+  uint8_t batch = cmd.streamBatch < minBatch ? minBatch : cmd.streamBatch;
+  if (batch > STREAM_SAMPLES_PER_FRAME)
+  {
+    batch = STREAM_SAMPLES_PER_FRAME;
+  }
 
-    case CMD_MOTORTEST:
-      DEBUG_I("CMD_MOTORTEST");
-      motorCtrlRun(msgMaster.motorSpeed, msgMaster.motorTorque, msgMaster.motorState);
-      break;
+  streamRenewedMs = millis();
+  if (streamActive && period == streamPeriodMs && batch == streamBatch)
+  {
+    return; // keepalive
+  }
 
-    case CMD_OTA:
-      DEBUG_I("CMD_OTA - entering OTA mode");
-      otaMode = true;
-      break;
+  flushStream(true);
+  timerStream.cancel();
+  streamPeriodMs = period;
+  streamBatch = batch;
+  if (!streamActive)
+  {
+    if (!caliper.isContinuous())
+    {
+      DEBUG_W("Telemetry needs continuous capture - sensor samples only on request");
+    }
+    streamSequence = 0;
+    streamDropped = 0;
+    streamCount = 0;
+    streamLastSampleMs = 0;
+  }
+  streamActive = true;
+  timerStream.every(streamPeriodMs, streamTick);
+  DEBUG_I("Telemetry every %u ms, %u samples per packet", (unsigned)streamPeriodMs, (unsigned)streamBatch);
+}
 
-    case CMD_PAIR:
-    case CMD_PAIR_ACK:
-      break;
+/**
+ * @brief Start a command from Master (measurement task)
+ * @param cmd Command forwarded by handleReceived()
+ */
+static void handleMeasureCommand(const MessageMaster &cmd)
+{
+  if (cmd.command == CMD_OTA)
+  {
+    DEBUG_I("CMD_OTA - entering OTA mode");
+    cancelMeasureCycle("OTA requested");
+    timerStream.cancel();
+    streamActive = false;
+    otaMode = true;
+    return;
+  }
 
-    default:
-      DEBUG_W("Unknown command: %c", msgMaster.command);
-      break;
-    }
+  // Telemetry runs next to the measurement cycle and does not use msgMaster
+  if (cmd.command == CMD_STREAM)
+  {
+    handleStreamCommand(cmd);
+    return;
   }
-  else
+
+  // msgMaster drives the running cycle's phases; keep it until IDLE
+  if (measurementInProgress || otaMode)
   {
-    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Received packet length: %d, expected: %d", len, (int)sizeof(MessageMaster));
+    DEBUG_W("Measurement in progress - command %c ignored", cmd.command);
+    return;
+  }
+
+  memcpy(&msgMaster, &cmd, sizeof(msgMaster));
+
+  switch (msgMaster.command)
+  {
+  case CMD_MEASURE:
+    DEBUG_I("CMD_MEASURE");
+    runMeasReq(nullptr);
+    break;
+
+  case CMD_UPDATE:
+    DEBUG_I("CMD_UPDATE");
+    runMeasReq(nullptr);
+    break;
+
+  case CMD_BURST:
+    DEBUG_I("CMD_BURST");
+    if (msgMaster.burstCount < 1 || msgMaster.burstCount > BURST_MAX_SAMPLES
+      || msgMaster.burstIntervalMs > BURST_MAX_INTERVAL_MS)
+    {
+      LOG_WARNING(ERR_VALIDATION_INVALID_PARAM, "Burst of %u samples, %u ms apart - clamped to 1..%u samples, %u ms",
+        (unsigned)msgMaster.burstCount, (unsigned)msgMaster.burstIntervalMs,
+        (unsigned)BURST_MAX_SAMPLES, (unsigned)BURST_MAX_INTERVAL_MS);
+      msgMaster.burstCount = msgMaster.burstCount < 1 ? 1
+        : (msgMaster.burstCount > BURST_MAX_SAMPLES ? BURST_MAX_SAMPLES : msgMaster.burstCount);
+      if (msgMaster.burstIntervalMs > BURST_MAX_INTERVAL_MS)
+      {
+        msgMaster.burstIntervalMs = BURST_MAX_INTERVAL_MS;
+      }
+    }
+    runMeasReq(nullptr);
+    break;
+
+  case CMD_MOTORTEST:
+    DEBUG_I("CMD_MOTORTEST");
+    motorCtrlRunProfile(msgMaster.motorSpeed, msgMaster.motorTorque, msgMaster.motorState,
+      msgMaster.rampUpMs, 0, msgMaster.motorSpeed, MOTION_PROFILE_OPEN_ENDED);
+    break;
+
+  default:
+    break;
   }
 }
 
 void OnDataSent(const wifi_tx_info_t *info, esp_now_send_status_t status)
 {
   (void)info;
+  uint8_t inFlight = sendsInFlight.load();
+  while (inFlight > 0 && !sendsInFlight.compare_exchange_weak(inFlight, inFlight - 1))
+  {
+  }
   if (status == ESP_NOW_SEND_SUCCESS)
   {
     DEBUG_I("Send status: Success");
@@ -230,29 +648,54 @@ void OnDataSent(const wifi_tx_info_t *info, esp_now_send_status_t status)
 
 bool updateMeasureData(void *arg)
 {
-  accelerometer.update();
+  // Vibration at the moment of capture, rounded up to whole mg
+  VibrationLevel vibration;
+  msgSlave.vibrationRms = accelerometer.getVibration(vibration)
+    ? (uint16_t)fminf(ceilf(vibration.rmsMg), 65535.0f)
+    : 0;
+
+#if SLAVE_MULTI_PROBE
+  caliper.performMultiMeasurement(msgSlaveMulti.measurement, msgSlaveMulti.status);
+  msgSlave.measurement = msgSlaveMulti.measurement[0];
+#else
   msgSlave.measurement = caliper.performReliableMeasurement();
+#endif
   
+  // The accelerometer is sampled in the background during the measurement;
+  // the angle comes from the window ending now
+  accelerometer.update();
+
   // Get Z angle - vertical deviation (0-90 degrees)
   float angleZ = accelerometer.getAngleZ();
   msgSlave.angleZ = (uint8_t)angleZ;
   
   msgSlave.batteryVoltage = battery.readVoltageNow();
   msgSlave.command = msgMaster.command;
+  msgSlave.requestId = msgMaster.requestId;
+
+#if SLAVE_MULTI_PROBE
+  msgSlaveMulti.batteryVoltage = msgSlave.batteryVoltage;
+  msgSlaveMulti.command = msgSlave.command;
+  msgSlaveMulti.requestId = msgSlave.requestId;
+  msgSlaveMulti.angleZ = msgSlave.angleZ;
+  msgSlaveMulti.vibrationRms = msgSlave.vibrationRms;
+  msgSlaveMulti.settleMs = msgSlave.settleMs;
+  msgSlaveMulti.channelCount = RS485_PROBE_COUNT;
+#endif
   return false; // do not repeat this task
 }
 
-bool MotorStopTimeout(void *arg)
-{
-  motorCtrlRun(0, 0, MOTOR_STOP);
-  digitalWrite(LED_GREEN, LOW);
-  DEBUG_I("Motor stopped after timeout");
-  return false; // do not repeat this task
-}
-
-bool batteryMonitorTask(void *arg)
+/**
+ * @brief Log the battery voltage and show it on the red LED (housekeeping task)
+ */
+static void updateBatteryStatus()
 {
   float voltage = battery.readVoltageNow();
+  if (voltage == 0.0f)
+  {
+    DEBUG_W("Battery: voltage unknown");
+    return;
+  }
   DEBUG_I("Battery: %.0f mV", voltage);
 
   if (voltage < 7000.0f)
@@ -265,98 +708,527 @@ bool batteryMonitorTask(void *arg)
     delay(1);
     digitalWrite(LED_RED, LOW);
   }
-  return true;
 }
 
 /**
- * @brief Callback executed on each measurement request
+ * @brief Hand msgSlave (or msgSlaveMulti) to the communication task
  *
- * This function is called by the timer after receiving CMD_MEASURE
- * or CMD_UPDATE. Performs measurement and sends result to Master.
- *
- * @details
- * Flow for CMD_MEASURE:
- * 1. Set measurementInProgress = true (blocks new commands)
- * 2. Start motor forward (MOTOR_FORWARD) with parameters from msgMaster
- * 3. Wait msgMaster.timeout ms for motor stabilization
- * 4. Perform measurement (updateMeasureData)
- * 5. Start motor reverse (MOTOR_REVERSE) to return to position
- * 6. Send result to Master
- * 7. Clear measurementInProgress = false
+ * The measurement task does not wait for the radio: the reply is copied
+ * into commQueue and sent by sendToMaster() on the WiFi core.
+ */
+static void sendMeasureResult()
+{
+  DEBUG_PLOT("measurement:%.3f", msgSlave.measurement);
+  DEBUG_PLOT("angleZ:%d", msgSlave.angleZ);
+  DEBUG_PLOT("vibrationRms:%u", (unsigned)msgSlave.vibrationRms);
+  DEBUG_PLOT("batteryVoltage:%.3f", msgSlave.batteryVoltage);
+
+  CommEvent ev{};
+  ev.type = CommEventType::SEND;
+#if SLAVE_MULTI_PROBE
+  // All channels in one packet instead of one radio round trip per probe
+  for (uint8_t ch = 0; ch < msgSlaveMulti.channelCount; ch++)
+  {
+    DEBUG_PLOT("channel%u:%.3f", (unsigned)ch, msgSlaveMulti.measurement[ch]);
+  }
+  ev.wireType = WIRE_SLAVE_MULTI;
+  ev.msg.multi = msgSlaveMulti;
+#else
+  ev.wireType = WIRE_SLAVE;
+  ev.msg.slave = msgSlave;
+#endif
+  ev.attempts = ESPNOW_MAX_RETRIES;
+
+  if (xQueueSend(commQueue, &ev, pdMS_TO_TICKS(COMM_QUEUE_SEND_TIMEOUT_MS)) != pdTRUE)
+  {
+    RECORD_ERROR(ERR_ESPNOW_SEND_FAILED, "Communication queue full - result not sent");
+  }
+}
+
+/**
+ * @brief Hand the burst samples to the communication task
  *
- * Flow for CMD_UPDATE:
- * 1. Set measurementInProgress = true
- * 2. Perform measurement without activating motor
- * 3. Send result to Master
- * 4. Clear measurementInProgress = false
+ * BURST_SAMPLES_PER_FRAME samples per MessageSlaveBurst, so a burst of up to
+ * 32 samples takes one frame instead of one round trip per sample.
  *
- * Locking mechanism:
- * - The measurementInProgress flag is set at the start of the function
- * - OnDataRecv checks this flag and ignores commands when measurement is in progress
- * - The flag is cleared after measurement completes and result is sent
+ * @param batteryVoltage Taken after the last sample, repeated in every frame
+ * @param angleZ Taken after the last sample, repeated in every frame
+ */
+static void sendBurstResult(float batteryVoltage, uint8_t angleZ)
+{
+  const uint8_t frameCount = (uint8_t)((burstTaken + BURST_SAMPLES_PER_FRAME - 1) / BURST_SAMPLES_PER_FRAME);
+
+  for (uint8_t frame = 0; frame < frameCount; frame++)
+  {
+    CommEvent ev{};
+    ev.type = CommEventType::SEND;
+    ev.wireType = WIRE_SLAVE_BURST;
+    ev.wireFlags = frame + 1 < frameCount ? WIRE_FLAG_MORE : 0;
+    ev.attempts = ESPNOW_MAX_RETRIES;
+
+    MessageSlaveBurst &msg = ev.msg.burst;
+    msg.command = CMD_BURST;
+    msg.requestId = msgMaster.requestId;
+    msg.frameIndex = frame;
+    msg.frameCount = frameCount;
+    msg.firstSample = (uint8_t)(frame * BURST_SAMPLES_PER_FRAME);
+    msg.totalSamples = burstTaken;
+    msg.sampleCount = (uint8_t)(burstTaken - msg.firstSample < BURST_SAMPLES_PER_FRAME
+      ? burstTaken - msg.firstSample : BURST_SAMPLES_PER_FRAME);
+    msg.angleZ = angleZ;
+    msg.batteryVoltage = batteryVoltage;
+    memcpy(msg.samples, &burstSamples[msg.firstSample], msg.sampleCount * sizeof(BurstSample));
+
+    if (xQueueSend(commQueue, &ev, pdMS_TO_TICKS(COMM_QUEUE_SEND_TIMEOUT_MS)) != pdTRUE)
+    {
+      RECORD_ERROR(ERR_ESPNOW_SEND_FAILED, "Communication queue full - burst frame %u/%u not sent",
+        (unsigned)(frame + 1), (unsigned)frameCount);
+    }
+  }
+}
+
+/**
+ * @brief Send a reply to Master (communication task)
  *
  * Retry mechanism on send error:
- * - First attempt: immediately after data is prepared
+ * - First attempt: immediately
  * - On error: wait ESPNOW_RETRY_DELAY_MS (100ms)
  * - Second attempt: retry send
  * - On second error: log error and continue
  *
- * Note: This function returns false, meaning the task should not be
- * repeated by timer (it is one-shot).
+ * Telemetry packets (ev.attempts == 1) get a single attempt and are not
+ * logged individually.
  *
- * @param arg Argument passed by timer (unused)
+ * @param ev SEND event from sendMeasureResult(), sendBurstResult() or flushStream()
+ */
+static void sendToMaster(const CommEvent &ev)
+{
+  // Counted before the send: OnDataSent may run before wire_send() returns
+  sendsInFlight++;
+  ErrorCode sendResult = wire_send(
+      masterWire,
+      masterAddress,
+      ev.wireType,
+      ev.wireFlags,
+      &ev.msg,
+      ev.attempts,
+      ESPNOW_RETRY_DELAY_MS
+  );
+
+  if (sendResult != ERR_NONE)
+  {
+    sendsInFlight--; // Never reached the radio, no OnDataSent
+  }
+
+  if (sendResult == ERR_NONE)
+  {
+    if (ev.attempts > 1)
+    {
+      DEBUG_I("Result sent to Master");
+    }
+  }
+  else if (ev.attempts > 1)
+  {
+    DEBUG_E("Error sending result to Master");
+  }
+}
+
+/**
+ * @brief Close the current phase and start the next one
+ */
+static void enterMeasurePhase(MeasurePhase phase)
+{
+  const uint32_t now = millis();
+  measurePhaseMs[(size_t)measurePhase] += now - measurePhaseStartMs;
+  measurePhaseStartMs = now;
+  measurePhase = phase;
+}
+
+/**
+ * @brief Back to IDLE, log the phase timing and accept commands again
+ */
+static void finishMeasureCycle()
+{
+  enterMeasurePhase(MeasurePhase::IDLE);
+  DEBUG_I("Measure cycle %u ms: forward %u, settle %u, burst %u, acquire %u, report %u, reverse %u",
+    (unsigned)(millis() - measureCycleStartMs),
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::MOTOR_FORWARD],
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::SETTLE],
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::BURST],
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::ACQUIRE],
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::REPORT],
+    (unsigned)measurePhaseMs[(size_t)MeasurePhase::MOTOR_REVERSE]);
+
+  // Clear blocking flag - measurement completed
+  measurementInProgress = false;
+}
+
+/**
+ * @brief Abort a running measurement cycle
+ *
+ * Stops the motor where it is and, if the result was not sent yet, reports
+ * INVALID_MEASUREMENT_VALUE so that Master does not wait for its timeout.
+ *
+ * @param reason Logged with the phase the cycle was in
+ */
+void cancelMeasureCycle(const char *reason)
+{
+  if (measurePhase == MeasurePhase::IDLE)
+  {
+    return;
+  }
+
+  timerWorker.cancel();
+  motorCtrlRun(0, 0, MOTOR_STOP);
+  digitalWrite(LED_GREEN, LOW);
+  DEBUG_W("Measure cycle cancelled in phase %s: %s", MEASURE_PHASE_NAMES[(size_t)measurePhase], reason);
+
+  if (measurePhase < MeasurePhase::REPORT)
+  {
+    msgSlave.measurement = INVALID_MEASUREMENT_VALUE;
+    msgSlave.command = msgMaster.command;
+    msgSlave.requestId = msgMaster.requestId;
+#if SLAVE_MULTI_PROBE
+    for (uint8_t ch = 0; ch < RS485_PROBE_COUNT; ch++)
+    {
+      msgSlaveMulti.measurement[ch] = INVALID_MEASUREMENT_VALUE;
+      msgSlaveMulti.status[ch] = CHANNEL_DISABLED;
+    }
+    msgSlaveMulti.command = msgSlave.command;
+    msgSlaveMulti.requestId = msgSlave.requestId;
+    msgSlaveMulti.channelCount = RS485_PROBE_COUNT;
+#endif
+    sendMeasureResult();
+  }
+
+  finishMeasureCycle();
+}
+
+/**
+ * @brief Take the next burst sample (BURST phase)
+ * @details A streamed sample has to be a frame not used before and at most
+ *          MEASUREMENT_TIMEOUT_MS old; without one by then the sample is
+ *          CHANNEL_TIMEOUT. Samples are due every burstIntervalMs after the
+ *          first one; a late sample does not delay the rest of the schedule.
+ * @return true when all burstCount samples are taken
+ */
+static bool takeBurstSample()
+{
+  const uint32_t now = millis();
+  float valueMm;
+  uint32_t frameUs;
+  uint32_t frameMs = now;
+  bool fresh = caliper.readLatest(valueMm, frameUs);
+  if (fresh)
+  {
+    frameMs = frameMillis(frameUs);
+  }
+  if (fresh && caliper.isContinuous())
+  {
+    fresh = (burstTaken == 0 || frameUs != burstLastFrameUs) && now - frameMs <= MEASUREMENT_TIMEOUT_MS;
+  }
+
+  BurstSample &sample = burstSamples[burstTaken];
+  if (fresh)
+  {
+    sample.status = (valueMm == INVALID_MEASUREMENT_VALUE) ? CHANNEL_INVALID
+      : (valueMm < MEASUREMENT_MIN_VALUE || valueMm > MEASUREMENT_MAX_VALUE) ? CHANNEL_OUT_OF_RANGE
+      : CHANNEL_OK;
+    sample.measurement = (sample.status == CHANNEL_OK) ? valueMm : INVALID_MEASUREMENT_VALUE;
+    burstLastFrameUs = frameUs;
+  }
+  else if (now - burstDueMs >= MEASUREMENT_TIMEOUT_MS)
+  {
+    sample.status = CHANNEL_TIMEOUT;
+    sample.measurement = INVALID_MEASUREMENT_VALUE;
+    frameMs = now;
+  }
+  else
+  {
+    timerWorker.in(BURST_POLL_MS, measureCycleStep);
+    return false;
+  }
+
+  if (burstTaken == 0)
+  {
+    burstFirstFrameMs = frameMs;
+  }
+  const uint32_t offsetMs = frameMs - burstFirstFrameMs;
+  sample.offsetMs = offsetMs > UINT16_MAX ? UINT16_MAX : (uint16_t)offsetMs;
+  burstTaken++;
+
+  if (burstTaken >= msgMaster.burstCount)
+  {
+    return true;
+  }
+
+  // Back to back (or behind schedule): next sample right away
+  burstDueMs += msgMaster.burstIntervalMs;
+  const uint32_t nowMs = millis();
+  if ((int32_t)(burstDueMs - nowMs) < 0)
+  {
+    burstDueMs = nowMs;
+  }
+  timerWorker.in(burstDueMs - nowMs, measureCycleStep);
+  return false;
+}
+
+/**
+ * @brief Start of the measurement cycle, on each measurement request
+ *
+ * Called by the measurement task for CMD_MEASURE or CMD_UPDATE. It only
+ * starts the cycle; every later phase is a one-shot timerWorker task
+ * (measureCycleStep()), so the measurement task keeps taking commands
+ * (CMD_OTA cancels the cycle) between phases.
+ *
+ * @details
+ * Phases for CMD_MEASURE (MeasurePhase):
+ * 1. MOTOR_FORWARD: motor forward (MOTOR_FORWARD) with parameters from
+ *    msgMaster for msgMaster.timeout ms: rampUpMs to motorSpeed, then
+ *    rampDownMs to motorSpeed * holdPercent / 100, which keeps the probe
+ *    pressed during the measurement; a motor fault cancels the cycle.
+ *    With SETTLE_DETECTION the length sensor is read every SETTLE_POLL_MS
+ *    and the phase ends as soon as the jaw has settled (SettleDetector);
+ *    msgMaster.timeout is then only the upper bound. The settle time is
+ *    reported as settleMs
+ *    Without SETTLE_DETECTION the vibration gate is polled every
+ *    VIB_POLL_MS instead, and the phase ends at the first quiet window that
+ *    started after rampUpMs
+ * 2. SETTLE: vibration polled every VIB_POLL_MS until quiet, at most
+ *    VIB_MAX_WAIT_MS
+ * 3. ACQUIRE: updateMeasureData()
+ * 4. REPORT: motor reverse (MOTOR_REVERSE, same ramps, decelerating to a
+ *    stop at msgMaster.timeout) started first, then the result
+ *    is sent to Master while the probe moves back (MessageSlaveMulti with
+ *    all channels when several RS485 probes are configured)
+ * 5. MOTOR_REVERSE: motor stopped msgMaster.timeout ms after the reverse
+ *    start, independent of how long the send took
+ *
+ * Phases for CMD_UPDATE: ACQUIRE and REPORT only, without motor.
+ *
+ * Phases for CMD_BURST: BURST (msgMaster.burstCount samples,
+ * msgMaster.burstIntervalMs apart, by the fastest acquisition path instead
+ * of the consensus read), then REPORT with MessageSlaveBurst frames,
+ * without motor. Several RS485 probes: channel 0 only.
+ *
+ * Locking mechanism:
+ * - measurementInProgress is set here and cleared when the cycle is back
+ *   in IDLE (after the reverse stroke, or after cancelMeasureCycle())
+ * - handleMeasureCommand() checks this flag and ignores commands when measurement is in progress
+ *
+ * @param arg Unused (timer handler signature)
  * @return false (task is not repeated)
  */
 bool runMeasReq(void *arg)
 {
   // Set flag blocking new commands
   measurementInProgress = true;
-  
+
+  measureCycleStartMs = millis();
+  measurePhaseStartMs = measureCycleStartMs;
+  memset(measurePhaseMs, 0, sizeof(measurePhaseMs));
+  msgSlave.settleMs = 0;
+
   if (msgMaster.command == CMD_MEASURE)
   {
-    timerMotorStopTimeout.cancel();
-
     digitalWrite(LED_GREEN, HIGH);
-    motorCtrlRun(msgMaster.motorSpeed, msgMaster.motorTorque, MOTOR_FORWARD);
+    // Ramp up, cruise, ramp down to the pressure held while measuring
+    const uint8_t holdPercent = msgMaster.holdPercent < 100 ? msgMaster.holdPercent : 100;
+    motorCtrlRunProfile(msgMaster.motorSpeed, msgMaster.motorTorque, MOTOR_FORWARD,
+      msgMaster.rampUpMs, msgMaster.rampDownMs,
+      (uint8_t)((msgMaster.motorSpeed * holdPercent) / 100U), msgMaster.timeout);
+    enterMeasurePhase(MeasurePhase::MOTOR_FORWARD);
+#if SETTLE_ACTIVE
+    DEBUG_I("Waiting for the jaw to settle, at most %u ms...", msgMaster.timeout);
+    settleDetector.reset();
+    timerWorker.in(SETTLE_POLL_MS, measureCycleStep);
+#elif VIB_MAX_WAIT_MS > 0
+    DEBUG_I("Waiting for a quiet fixture, at most %u ms...", msgMaster.timeout);
+    timerWorker.in(VIB_POLL_MS, measureCycleStep);
+#else
     DEBUG_I("Waiting %u ms for motor stabilization...", msgMaster.timeout);
-    delay(msgMaster.timeout); // wait for motor to stabilize
+    timerWorker.in(msgMaster.timeout, measureCycleStep);
+#endif
+    return false; // do not repeat this task
+  }
 
-    digitalWrite(LED_GREEN, LOW);
-    updateMeasureData(nullptr);
-    digitalWrite(LED_GREEN, HIGH);
+  if (msgMaster.command == CMD_BURST)
+  {
+    DEBUG_I("Burst of %u samples, %u ms apart", (unsigned)msgMaster.burstCount, (unsigned)msgMaster.burstIntervalMs);
+    burstTaken = 0;
+    burstDueMs = measureCycleStartMs;
+    enterMeasurePhase(MeasurePhase::BURST);
+    return measureCycleStep(nullptr);
+  }
+
+  enterMeasurePhase(MeasurePhase::ACQUIRE);
+  return measureCycleStep(nullptr);
+}
 
-    motorCtrlRun(msgMaster.motorSpeed, msgMaster.motorTorque, MOTOR_REVERSE);
-    timerMotorStopTimeout.in(msgMaster.timeout, MotorStopTimeout);
+/**
+ * @brief Advance the measurement cycle by one or more phases
+ * @details Runs from timerWorker; a phase that has to wait schedules this
+ *          function again instead of blocking.
+ * @param arg Argument passed by timer (unused)
+ * @return false (task is not repeated)
+ */
+bool measureCycleStep(void *arg)
+{
+  switch (measurePhase)
+  {
+  case MeasurePhase::MOTOR_FORWARD:
+  {
+    if (motorCtrlCheckFault())
+    {
+      cancelMeasureCycle("motor fault");
+      return false;
+    }
+#if SETTLE_ACTIVE
+    float valueMm;
+    uint32_t frameUs;
+    if (caliper.readLatest(valueMm, frameUs))
+    {
+      settleDetector.feed(valueMm, frameUs);
+    }
+
+    const uint32_t elapsedMs = millis() - measureCycleStartMs;
+    if (!settleDetector.settled() && elapsedMs < msgMaster.timeout)
+    {
+      const uint32_t leftMs = msgMaster.timeout - elapsedMs;
+      timerWorker.in(leftMs < SETTLE_POLL_MS ? leftMs : SETTLE_POLL_MS, measureCycleStep);
+      return false;
+    }
+
+    if (settleDetector.settled())
+    {
+      const int32_t settleMs = (int32_t)(frameMillis(settleDetector.settledAtUs()) - measureCycleStartMs);
+      msgSlave.settleMs = settleMs <= 0 ? 1 : (settleMs > UINT16_MAX ? UINT16_MAX : (uint16_t)settleMs);
+      DEBUG_I("Jaw settled after %u ms at %.3f mm (confirmed after %u ms, %u frames)",
+        (unsigned)msgSlave.settleMs, settleDetector.value(), (unsigned)elapsedMs,
+        (unsigned)settleDetector.frames());
+    }
+    else
+    {
+      DEBUG_W("Jaw not settled within %u ms (%u frames, %s) - capturing anyway",
+        (unsigned)msgMaster.timeout, (unsigned)settleDetector.frames(),
+        settleDetector.hasMoved() ? "moving" : "no motion");
+    }
+#elif VIB_MAX_WAIT_MS > 0
+    // No settle detection: the probe rests on the part once the fixture is
+    // quiet again. Only a window that started after the ramp-up counts, the
+    // still fixture before the motor starts does not
+    const uint32_t elapsedMs = millis() - measureCycleStartMs;
+    VibrationLevel level;
+    const bool rested = accelerometer.isSampling()
+      && accelerometer.isQuiet(VIB_QUIET_RMS_MG, VIB_QUIET_PEAK_MG, level)
+      && (int32_t)(level.windowStartMs - (measureCycleStartMs + msgMaster.rampUpMs)) >= 0;
+    if (!rested && elapsedMs < msgMaster.timeout)
+    {
+      const uint32_t leftMs = msgMaster.timeout - elapsedMs;
+      timerWorker.in(leftMs < VIB_POLL_MS ? leftMs : VIB_POLL_MS, measureCycleStep);
+      return false;
+    }
+    if (rested)
+    {
+      DEBUG_I("Fixture quiet after %u ms of the forward stroke", (unsigned)elapsedMs);
+    }
+#endif
+    enterMeasurePhase(MeasurePhase::SETTLE);
   }
-  else if (msgMaster.command == CMD_UPDATE)
+    [[fallthrough]];
+
+  case MeasurePhase::SETTLE:
   {
-    updateMeasureData(nullptr);
+#if VIB_MAX_WAIT_MS > 0
+    // Capture at a quiet moment instead of retrying readings of a shaking fixture
+    VibrationLevel level = {};
+    const bool quiet = !accelerometer.isSampling()
+      || accelerometer.isQuiet(VIB_QUIET_RMS_MG, VIB_QUIET_PEAK_MG, level);
+    const uint32_t waitedMs = millis() - measurePhaseStartMs;
+    if (!quiet && waitedMs < VIB_MAX_WAIT_MS)
+    {
+      timerWorker.in(VIB_POLL_MS, measureCycleStep);
+      return false;
+    }
+    if (quiet)
+    {
+      DEBUG_I("Vibration quiet after %u ms (RMS %.1f mg, peak %.1f mg)",
+        (unsigned)waitedMs, level.rmsMg, level.peakMg);
+    }
+    else
+    {
+      DEBUG_W("Vibration still RMS %.1f mg, peak %.1f mg after %u ms - capturing anyway",
+        level.rmsMg, level.peakMg, (unsigned)waitedMs);
+    }
+#endif
+    enterMeasurePhase(MeasurePhase::ACQUIRE);
   }
+    [[fallthrough]];
 
-  DEBUG_PLOT("measurement:%.3f", msgSlave.measurement);
-  DEBUG_PLOT("angleZ:%d", msgSlave.angleZ);
-  DEBUG_PLOT("batteryVoltage:%.3f", msgSlave.batteryVoltage);
+  case MeasurePhase::ACQUIRE:
+    digitalWrite(LED_GREEN, LOW);
+    updateMeasureData(nullptr);
+    enterMeasurePhase(MeasurePhase::REPORT);
 
-  ErrorCode sendResult = espnow_send_with_retry(
-      masterAddress,
-      &msgSlave,
-      sizeof(msgSlave),
-      ESPNOW_MAX_RETRIES,
-      ESPNOW_RETRY_DELAY_MS
-  );
+    // Overlap the send with the reverse stroke
+    if (msgMaster.command == CMD_MEASURE)
+    {
+      digitalWrite(LED_GREEN, HIGH);
+      reverseStartMs = millis();
+      motorCtrlRunProfile(msgMaster.motorSpeed, msgMaster.motorTorque, MOTOR_REVERSE,
+        msgMaster.rampUpMs, msgMaster.rampDownMs, 0, msgMaster.timeout);
+    }
+    sendMeasureResult();
 
-  if (sendResult == ERR_NONE)
+    if (msgMaster.command == CMD_MEASURE)
+    {
+      enterMeasurePhase(MeasurePhase::MOTOR_REVERSE);
+      const uint32_t elapsedMs = millis() - reverseStartMs;
+      timerWorker.in(elapsedMs < msgMaster.timeout ? msgMaster.timeout - elapsedMs : 0, measureCycleStep);
+      return false;
+    }
+    finishMeasureCycle();
+    return false;
+
+  case MeasurePhase::BURST:
   {
-    DEBUG_I("Result sent to Master");
+    if (!takeBurstSample())
+    {
+      return false;
+    }
+
+    accelerometer.update();
+    const uint8_t angleZ = (uint8_t)accelerometer.getAngleZ();
+    const float batteryVoltage = battery.readVoltageNow();
+    enterMeasurePhase(MeasurePhase::REPORT);
+
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < burstTaken; i++)
+    {
+      valid += (burstSamples[i].status == CHANNEL_OK);
+    }
+    DEBUG_I("Burst %u: %u of %u samples valid in %u ms", (unsigned)msgMaster.requestId, (unsigned)valid,
+      (unsigned)burstTaken, (unsigned)burstSamples[burstTaken - 1].offsetMs);
+    DEBUG_PLOT("burstSamples:%u", (unsigned)burstTaken);
+
+    sendBurstResult(batteryVoltage, angleZ);
+    finishMeasureCycle();
+    return false;
   }
-  else
-  {
-    DEBUG_E("Error sending result to Master");
+
+  case MeasurePhase::MOTOR_REVERSE:
+    motorCtrlRun(0, 0, MOTOR_STOP);
+    digitalWrite(LED_GREEN, LOW);
+    DEBUG_I("Motor stopped after timeout");
+    finishMeasureCycle();
+    return false;
+
+  case MeasurePhase::IDLE:
+  case MeasurePhase::REPORT:
+  case MeasurePhase::COUNT:
+    break;
   }
 
-  // Clear blocking flag - measurement completed
-  measurementInProgress = false;
-  
   return false; // do not repeat this task
 }
 
@@ -397,6 +1269,126 @@ void scanI2C()
   DEBUG_I("=== End of I2C scan ===");
 }
 
+//==============================================================================
+// Tasks
+//==============================================================================
+
+/**
+ * @brief Measurement task: commands from Master and the measurement cycle
+ *
+ * Pinned to MEASURE_TASK_CORE, away from the WiFi stack, so sensor reads
+ * and motor timing are not delayed by radio activity. Owns msgMaster,
+ * msgSlave, the sensors and the motor during a cycle, and takes the
+ * telemetry samples between cycles. Sleeps in
+ * xQueueReceive() until the next command or the next due phase.
+ */
+static void measureTaskEntry(void *arg)
+{
+  (void)arg;
+  for (;;)
+  {
+    // Run due phases and telemetry samples; the time to the next one bounds
+    // the wait for a command. tick() of an empty timer returns 0, which
+    // means "nothing scheduled" here, not "due now".
+    unsigned long nextMs = MEASURE_TASK_IDLE_MS;
+    const unsigned long phaseMs = timerWorker.tick();
+    if (timerWorker.size() > 0 && phaseMs < nextMs)
+    {
+      nextMs = phaseMs;
+    }
+    const unsigned long streamMs = timerStream.tick();
+    if (timerStream.size() > 0 && streamMs < nextMs)
+    {
+      nextMs = streamMs;
+    }
+    // At least one tick, so a phase due now does not starve the idle task
+    TickType_t wait = pdMS_TO_TICKS(nextMs);
+    if (wait == 0)
+    {
+      wait = 1;
+    }
+
+    MessageMaster cmd;
+    if (xQueueReceive(measureQueue, &cmd, wait) == pdTRUE)
+    {
+      handleMeasureCommand(cmd);
+    }
+  }
+}
+
+/**
+ * @brief Communication task: ESP-NOW receive handling, replies and pairing
+ *
+ * Runs next to the WiFi stack on COMM_TASK_CORE. Blocking sends with
+ * retries happen here instead of in the measurement cycle.
+ */
+static void commTaskEntry(void *arg)
+{
+  (void)arg;
+  for (;;)
+  {
+    // A stored Master MAC limits pairing to PAIRING_WINDOW_MS after boot
+    TickType_t wait = portMAX_DELAY;
+    if (pairingMode && hasStoredMasterMac)
+    {
+      const uint32_t elapsed = millis() - pairingModeStartMs;
+      wait = pdMS_TO_TICKS(elapsed < PAIRING_WINDOW_MS ? PAIRING_WINDOW_MS - elapsed : 0);
+    }
+
+    CommEvent ev;
+    if (xQueueReceive(commQueue, &ev, wait) == pdTRUE)
+    {
+      if (ev.type == CommEventType::RECEIVED)
+      {
+        handleReceived(ev);
+      }
+      else
+      {
+        sendToMaster(ev);
+      }
+    }
+
+    if (pairingMode && hasStoredMasterMac && millis() - pairingModeStartMs >= PAIRING_WINDOW_MS)
+    {
+      exitPairingMode();
+    }
+  }
+}
+
+/**
+ * @brief Housekeeping task: battery status and the pairing LED
+ */
+static void housekeepingTaskEntry(void *arg)
+{
+  (void)arg;
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastBatteryMs = millis();
+  bool blinking = false;
+
+  for (;;)
+  {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(HOUSEKEEPING_PERIOD_MS));
+
+    // Continuous pairing (no Master known yet) - blink green LED as visual indicator
+    if (pairingMode && !hasStoredMasterMac)
+    {
+      blinking = true;
+      digitalWrite(LED_GREEN, (millis() / 100) % 2 ? HIGH : LOW);
+    }
+    else if (blinking)
+    {
+      blinking = false;
+      digitalWrite(LED_GREEN, LOW);
+    }
+
+    if (millis() - lastBatteryMs >= BATTERY_UPDATE_INTERVAL_MS)
+    {
+      lastBatteryMs = millis();
+      updateBatteryStatus();
+    }
+  }
+}
+
 void setup()
 {
   DEBUG_BEGIN();
@@ -430,6 +1422,11 @@ void setup()
     LOG_WARNING(ERR_ACCEL_INIT_FAILED, "Accelerometer not initialized - continuing without angle data");
   }
 
+  if (!battery.begin())
+  {
+    LOG_WARNING(ERR_ADC_READ_FAILED, "Battery ADC continuous mode not started - falling back to analogRead");
+  }
+
   WiFi.mode(WIFI_STA);
   delay(WIFI_INIT_DELAY_MS);
 
@@ -459,6 +1456,16 @@ void setup()
   }
   DEBUG_I("ESP-NOW OK");
 
+  commQueue = xQueueCreate(COMM_QUEUE_LENGTH, sizeof(CommEvent));
+  measureQueue = xQueueCreate(MEASURE_QUEUE_LENGTH, sizeof(MessageMaster));
+  if (commQueue == nullptr || measureQueue == nullptr)
+  {
+    RECORD_ERROR(ERR_SYSTEM_MEMORY_ALLOC_FAILED, "Task queues could not be created");
+    return;
+  }
+
+  // v1 until Master speaks v2 (replies follow the version of the command)
+  wire_peer_reset(masterWire, WIRE_VERSION_1);
   esp_now_register_recv_cb(OnDataRecv);
   esp_now_register_send_cb(OnDataSent);
 
@@ -493,15 +1500,43 @@ void setup()
   pinMode(LED_GREEN, OUTPUT);
   digitalWrite(LED_RED, LOW);
   digitalWrite(LED_GREEN, LOW);
-  timerBattery.every(BATTERY_UPDATE_INTERVAL_MS, batteryMonitorTask);
 
   enterPairingMode();
 
+#if defined(ENABLE_BENCHMARK) && defined(RS485)
+  runBenchmarks(caliper);
+#elif defined(ENABLE_BENCHMARK)
+  runBenchmarks();
+#endif
+
+#if CALIPER_CONTINUOUS_CAPTURE
+  if (SensorType::hasCapability(SENSOR_CAP_CONTINUOUS))
+  {
+    caliper.startContinuous();
+  }
+#endif
+
+  if (xTaskCreatePinnedToCore(measureTaskEntry, "measure", MEASURE_TASK_STACK_SIZE, nullptr,
+        MEASURE_TASK_PRIORITY, &measureTaskHandle, MEASURE_TASK_CORE) != pdPASS
+    || xTaskCreatePinnedToCore(commTaskEntry, "comm", COMM_TASK_STACK_SIZE, nullptr,
+        COMM_TASK_PRIORITY, &commTaskHandle, COMM_TASK_CORE) != pdPASS
+    || xTaskCreatePinnedToCore(housekeepingTaskEntry, "housekeeping", HOUSEKEEPING_TASK_STACK_SIZE, nullptr,
+        HOUSEKEEPING_TASK_PRIORITY, &housekeepingTaskHandle, HOUSEKEEPING_TASK_CORE) != pdPASS)
+  {
+    RECORD_ERROR(ERR_SYSTEM_MEMORY_ALLOC_FAILED, "Slave tasks could not be created");
+    return;
+  }
+
   DEBUG_I("Waiting for measurement requests...");
 }
 
+/**
+ * @brief Only OTA is left to the Arduino loop; everything else runs in the
+ *        measurement, communication and housekeeping tasks
+ */
 void loop()
 {
+  // otaMode is set by the measurement task after it cancelled the cycle
   if (otaMode && !otaUpdate.isActive())
   {
     otaUpdate.startOTAMode();
@@ -512,26 +1547,5 @@ void loop()
     return;
   }
 
-  if (pairingMode)
-  {
-    if (!hasStoredMasterMac)
-    {
-      // Continuous pairing — blink green LED as visual indicator
-      uint32_t blink = (millis() / 100) % 2;
-      digitalWrite(LED_GREEN, blink ? HIGH : LOW);
-    }
-    else
-    {
-      digitalWrite(LED_GREEN, LOW);
-      uint32_t elapsed = millis() - pairingModeStartMs;
-      if (elapsed >= PAIRING_WINDOW_MS)
-      {
-        exitPairingMode();
-      }
-    }
-  }
-
-  timerWorker.tick();
-  timerMotorStopTimeout.tick();
-  timerBattery.tick();
+  vTaskDelay(pdMS_TO_TICKS(LOOP_IDLE_MS));
 }
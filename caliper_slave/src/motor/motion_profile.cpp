@@ -0,0 +1,106 @@
+/**
+ * @file motion_profile.cpp
+ * @brief Trapezoidal PWM ramp generator for the STSPIN250 motor
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ */
+
+#include "motion_profile.h"
+
+// ============================================================================
+// Golden vectors (checked at compile time)
+// ============================================================================
+
+namespace {
+
+// 200 PWM cruise, 100 ms ramps, 1 s stroke ending at 50 PWM
+constexpr MotionProfile TRAPEZOID(200, 50, 100, 100, 1000);
+// Ramps of 400 ms each do not fit into 500 ms: peak where they cross
+constexpr MotionProfile TRIANGLE(200, 0, 400, 400, 500);
+// Step profile, same as the original motorCtrlRun()
+constexpr MotionProfile STEP(120, 120, 0, 0, 1000);
+// Manual run: ramp up, then cruise until stopped
+constexpr MotionProfile OPEN(255, 0, 50, 100, MOTION_PROFILE_OPEN_ENDED);
+
+/**
+ * @brief Largest duty change between two consecutive milliseconds
+ */
+constexpr uint32_t maxStep(const MotionProfile &p, uint32_t horizonMs)
+{
+    uint32_t worst = 0;
+    for (uint32_t t = 1; t <= horizonMs; t++)
+    {
+        const uint32_t a = p.pwmAt(t - 1);
+        const uint32_t b = p.pwmAt(t);
+        const uint32_t step = a > b ? a - b : b - a;
+        if (step > worst)
+        {
+            worst = step;
+        }
+    }
+    return worst;
+}
+
+/**
+ * @brief Highest duty over the stroke
+ */
+constexpr uint8_t peak(const MotionProfile &p, uint32_t horizonMs)
+{
+    uint8_t best = 0;
+    for (uint32_t t = 0; t <= horizonMs; t++)
+    {
+        if (p.pwmAt(t) > best)
+        {
+            best = p.pwmAt(t);
+        }
+    }
+    return best;
+}
+
+static_assert(TRAPEZOID.pwmAt(0) == 0, "starts from standstill");
+static_assert(TRAPEZOID.pwmAt(50) == 100, "half way up the ramp");
+static_assert(TRAPEZOID.pwmAt(100) == 200, "cruise reached after accelMs");
+static_assert(TRAPEZOID.pwmAt(500) == 200, "cruise");
+static_assert(TRAPEZOID.pwmAt(900) == 200, "deceleration starts decelMs before the end");
+static_assert(TRAPEZOID.pwmAt(950) == 125, "half way down the ramp");
+static_assert(TRAPEZOID.pwmAt(1000) == 50, "end PWM at durationMs");
+static_assert(TRAPEZOID.pwmAt(5000) == 50, "end PWM is held");
+static_assert(maxStep(TRAPEZOID, 1200) == 2, "no jumps: 200 PWM over 100 ms");
+static_assert(TRAPEZOID.segmentAt(10) == MotionSegment::ACCEL, "segment: accel");
+static_assert(TRAPEZOID.segmentAt(500) == MotionSegment::CRUISE, "segment: cruise");
+static_assert(TRAPEZOID.segmentAt(950) == MotionSegment::DECEL, "segment: decel");
+static_assert(TRAPEZOID.segmentAt(1000) == MotionSegment::HOLD, "segment: hold");
+static_assert(!TRAPEZOID.finished(999) && TRAPEZOID.finished(1000), "finished at durationMs");
+
+static_assert(TRIANGLE.pwmAt(250) == 125, "triangle peak where the ramps cross");
+static_assert(peak(TRIANGLE, 600) == 125, "triangle never reaches cruise");
+static_assert(TRIANGLE.pwmAt(500) == 0, "triangle ends stopped");
+static_assert(maxStep(TRIANGLE, 600) == 1, "triangle has no jumps");
+
+static_assert(STEP.pwmAt(0) == 120 && STEP.pwmAt(999) == 120 && STEP.pwmAt(1000) == 120,
+              "zero ramps and endPwm == cruisePwm: constant duty");
+static_assert(STEP.finished(1000) && STEP.finalPwm() == 120, "step profile final duty");
+static_assert(MotionProfile(100, 200, 0, 0, 10).pwmAt(20) == 100, "endPwm clamped to cruisePwm");
+
+static_assert(OPEN.pwmAt(25) == 128, "open-ended: ramp up");
+static_assert(OPEN.pwmAt(100000) == 255, "open-ended: never decelerates");
+static_assert(OPEN.finished(50) && OPEN.finalPwm() == 255, "open-ended: finished after accelMs");
+
+} // namespace
+
+const char *motionSegmentName(MotionSegment segment)
+{
+    switch (segment)
+    {
+    case MotionSegment::ACCEL:
+        return "accel";
+    case MotionSegment::CRUISE:
+        return "cruise";
+    case MotionSegment::DECEL:
+        return "decel";
+    case MotionSegment::HOLD:
+        return "hold";
+    }
+    return "unknown";
+}
@@ -0,0 +1,153 @@
+/**
+ * @file motion_profile.h
+ * @brief Trapezoidal PWM ramp generator for the STSPIN250 motor
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Describes one motor stroke as PWM duty over time:
+ *
+ *     PWM
+ *  cruise |     ___________
+ *         |    /           \
+ *     end |   /             \______
+ *         |  /
+ *       0 |_/__________________________ t
+ *           |accel|         |decel|
+ *           0                     duration
+ *
+ * - acceleration: 0 -> cruise over accelMs
+ * - cruise: constant cruise PWM
+ * - deceleration: cruise -> end over the last decelMs before durationMs
+ * - hold: end PWM from durationMs on (0 stops the motor, a non-zero value
+ *   keeps the probe pressed onto the part)
+ *
+ * The duty is the minimum of the three ramps, so a stroke too short for
+ * both ramps degrades to a triangle with a lower peak instead of a jump.
+ * durationMs = MOTION_PROFILE_OPEN_ENDED has no deceleration (the stroke is
+ * ended by the caller).
+ *
+ * Integer-only and constexpr, so the golden vectors in motion_profile.cpp
+ * are checked at compile time. No Arduino dependency; builds on the host.
+ */
+
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <stdint.h>
+
+#define MOTION_PROFILE_OPEN_ENDED 0 // durationMs: run at cruise until stopped
+
+/**
+ * @brief Part of the stroke a point in time falls into
+ */
+enum class MotionSegment : uint8_t {
+    ACCEL,  /**< Ramping up from 0 */
+    CRUISE, /**< Constant cruise PWM */
+    DECEL,  /**< Ramping down to the end PWM */
+    HOLD    /**< Stroke finished, end PWM (or cruise when open-ended) */
+};
+
+const char *motionSegmentName(MotionSegment segment);
+
+class MotionProfile {
+public:
+    constexpr MotionProfile() = default;
+
+    /**
+     * @param cruisePwm PWM duty of the constant-speed part (0-255)
+     * @param endPwm PWM duty after the deceleration (clamped to cruisePwm)
+     * @param accelMs Ramp 0 -> cruisePwm (0 = step)
+     * @param decelMs Ramp cruisePwm -> endPwm, ending at durationMs (0 = step)
+     * @param durationMs Stroke length from the start of the acceleration
+     */
+    constexpr MotionProfile(uint8_t cruisePwm, uint8_t endPwm, uint16_t accelMs,
+                            uint16_t decelMs, uint32_t durationMs)
+        : cruise(cruisePwm), end(endPwm < cruisePwm ? endPwm : cruisePwm),
+          accel(accelMs), decel(decelMs), duration(durationMs)
+    {
+    }
+
+    /**
+     * @brief PWM duty at a point of the stroke
+     * @param t Milliseconds since the start of the stroke
+     */
+    constexpr uint8_t pwmAt(uint32_t t) const
+    {
+        uint32_t pwm = cruise;
+
+        if (t < accel)
+        {
+            pwm = ramp(0, cruise, t, accel);
+        }
+
+        if (duration != MOTION_PROFILE_OPEN_ENDED)
+        {
+            const uint32_t down = (t >= duration) ? end
+                : (duration - t < decel) ? ramp(end, cruise, duration - t, decel)
+                : cruise;
+            if (down < pwm)
+            {
+                pwm = down;
+            }
+        }
+        return (uint8_t)pwm;
+    }
+
+    /**
+     * @brief Segment of the stroke at a point in time (for logging)
+     */
+    constexpr MotionSegment segmentAt(uint32_t t) const
+    {
+        if (duration != MOTION_PROFILE_OPEN_ENDED && t >= duration)
+        {
+            return MotionSegment::HOLD;
+        }
+        if (duration != MOTION_PROFILE_OPEN_ENDED && duration - t < decel && end < cruise)
+        {
+            return MotionSegment::DECEL;
+        }
+        if (t < accel)
+        {
+            return MotionSegment::ACCEL;
+        }
+        return duration == MOTION_PROFILE_OPEN_ENDED ? MotionSegment::HOLD : MotionSegment::CRUISE;
+    }
+
+    /**
+     * @brief true once the duty no longer changes (pwmAt() == finalPwm())
+     */
+    constexpr bool finished(uint32_t t) const
+    {
+        return t >= accel && (duration == MOTION_PROFILE_OPEN_ENDED || t >= duration);
+    }
+
+    /**
+     * @brief Duty from finished() on
+     */
+    constexpr uint8_t finalPwm() const
+    {
+        return duration == MOTION_PROFILE_OPEN_ENDED ? cruise : end;
+    }
+
+    constexpr uint8_t cruisePwm() const { return cruise; }
+    constexpr uint32_t durationMs() const { return duration; }
+
+private:
+    uint8_t cruise = 0;
+    uint8_t end = 0;
+    uint16_t accel = 0;
+    uint16_t decel = 0;
+    uint32_t duration = MOTION_PROFILE_OPEN_ENDED;
+
+    /**
+     * @brief Linear interpolation from -> to at t of span, rounded to nearest
+     */
+    static constexpr uint32_t ramp(uint32_t from, uint32_t to, uint32_t t, uint32_t span)
+    {
+        return from + ((to - from) * t + span / 2) / span;
+    }
+};
+
+#endif // MOTION_PROFILE_H
@@ -3,18 +3,114 @@
  * @brief STSPIN250 DC Motor Controller Implementation for ESP32
  * @author System Generated
  * @date 2026-02-23
- * @version 3.0
+ * @version 3.2
  *
  * @details
  * Implementation for STSPIN250 single H-Bridge DC motor driver.
  * Provides full motor control with speed, direction, current limiting,
  * enable/disable, and fault detection.
+ *
+ * @version 3.1 - Trapezoidal PWM ramps (motorCtrlRunProfile) stepped by an
+ *                esp_timer every MOTOR_PROFILE_PERIOD_MS; all pin writes are
+ *                serialised by a mutex shared with the timer callback
+ * @version 3.2 - Calls before motorCtrlInit() or after a failed mutex
+ *                allocation run unlocked (step profiles only) instead of
+ *                taking a null mutex
  */
 
 #include "motor_ctrl.h"
 
 #include <MacroDebugger.h>
 #include <error_handler.h>
+#include <esp_timer.h>
+#include <freertos/semphr.h>
+#include "../config.h"
+
+//==============================================================================
+// Ramp Executor State
+//==============================================================================
+
+static SemaphoreHandle_t motorMutex = nullptr;    // Guards the pins and the profile state
+static esp_timer_handle_t profileTimer = nullptr;
+static MotionProfile profile;
+static uint32_t profileStartMs = 0;
+static uint8_t profilePwm = 0;                     // Duty last written by the executor
+static bool profileActive = false;
+
+static bool motorCtrlApply(uint8_t speed, uint8_t torque, MotorState direction);
+
+/**
+ * @brief Take motorMutex if it exists
+ * @return true if taken; without the mutex there is no profile timer, so
+ *         the caller is the only writer and runs unlocked
+ */
+static bool motorLock()
+{
+    return motorMutex != nullptr && xSemaphoreTake(motorMutex, portMAX_DELAY) == pdTRUE;
+}
+
+static void motorUnlock(bool locked)
+{
+    if (locked)
+    {
+        xSemaphoreGive(motorMutex);
+    }
+}
+
+/**
+ * @brief Stop stepping the current profile (caller holds motorMutex)
+ */
+static void profileStop()
+{
+    if (profileActive)
+    {
+        esp_timer_stop(profileTimer);
+        profileActive = false;
+    }
+}
+
+/**
+ * @brief esp_timer callback: write the duty of the running profile
+ */
+static void profileTick(void *arg)
+{
+    (void)arg;
+    bool fault = false;
+
+    if (!motorLock())
+    {
+        return;
+    }
+    if (profileActive)
+    {
+        if (digitalRead(MOTOR_FAULT_PIN) == LOW)
+        {
+            analogWrite(MOTOR_PWM_PIN, 0);
+            profileStop();
+            fault = true;
+        }
+        else
+        {
+            const uint32_t t = millis() - profileStartMs;
+            const uint8_t pwm = profile.pwmAt(t);
+            if (pwm != profilePwm)
+            {
+                analogWrite(MOTOR_PWM_PIN, pwm);
+                profilePwm = pwm;
+            }
+            if (profile.finished(t))
+            {
+                profileStop();
+            }
+        }
+    }
+    motorUnlock(true);
+
+    if (fault)
+    {
+        RECORD_ERROR(ERR_MOTOR_FAULT, "Motor fault during profile - stroke aborted");
+    }
+}
 
 //==============================================================================
 // Public Function Implementations
@@ -39,6 +135,19 @@ void motorCtrlInit(void)
     digitalWrite(MOTOR_PH_PIN, LOW);
     analogWrite(MOTOR_REF_PIN, 0);
 
+    motorMutex = xSemaphoreCreateMutex();
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = profileTick;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "motor_profile";
+    timerArgs.skip_unhandled_events = true;
+    if (motorMutex == nullptr || esp_timer_create(&timerArgs, &profileTimer) != ESP_OK)
+    {
+        RECORD_ERROR(ERR_MOTOR_HARDWARE_FAILURE, "Motor profile timer init failed - ramps disabled");
+        profileTimer = nullptr;
+    }
+
     DEBUG_I("STSPIN250 Motor Controller initialized (disabled)");
 }
 
@@ -83,6 +192,60 @@ bool motorCtrlCheckFault(void)
  * @param direction Motor direction (MotorState enum)
  */
 void motorCtrlRun(uint8_t speed, uint8_t torque, MotorState direction)
+{
+    const bool locked = motorLock();
+    profileStop();
+    motorCtrlApply(speed, torque, direction);
+    motorUnlock(locked);
+}
+
+void motorCtrlRunProfile(uint8_t speed, uint8_t torque, MotorState direction,
+                         uint16_t rampUpMs, uint16_t rampDownMs, uint8_t endSpeed, uint32_t durationMs)
+{
+    const bool locked = motorLock();
+    profileStop();
+
+    if (direction != MOTOR_FORWARD && direction != MOTOR_REVERSE)
+    {
+        motorCtrlApply(speed, torque, direction);
+        motorUnlock(locked);
+        return;
+    }
+
+    profile = MotionProfile(speed, endSpeed, rampUpMs, rampDownMs, durationMs);
+    if (profileTimer == nullptr)
+    {
+        // No executor: plain step to cruise, like motorCtrlRun()
+        profile = MotionProfile(speed, speed, 0, 0, MOTION_PROFILE_OPEN_ENDED);
+    }
+
+    profilePwm = profile.pwmAt(0);
+    if (motorCtrlApply(profilePwm, torque, direction) && !profile.finished(0))
+    {
+        profileStartMs = millis();
+        profileActive = true;
+        esp_timer_start_periodic(profileTimer, (uint64_t)MOTOR_PROFILE_PERIOD_MS * 1000ULL);
+        DEBUG_I("Motor profile: cruise=%u end=%u up=%u ms down=%u ms duration=%u ms",
+                (unsigned)profile.cruisePwm(), (unsigned)profile.finalPwm(),
+                (unsigned)rampUpMs, (unsigned)rampDownMs, (unsigned)durationMs);
+    }
+    motorUnlock(locked);
+}
+
+bool motorCtrlProfileActive(void)
+{
+    const bool locked = motorLock();
+    const bool active = profileActive;
+    motorUnlock(locked);
+    return active;
+}
+
+/**
+ * @brief Write speed, current limit and direction to the driver pins
+ * @return false if the command was rejected (invalid direction or fault)
+ * @details Caller holds motorMutex.
+ */
+static bool motorCtrlApply(uint8_t speed, uint8_t torque, MotorState direction)
 {
     // Clamp speed to valid range
     speed = constrain(speed, 0, PWM_MAX_VALUE);
@@ -110,14 +273,14 @@ void motorCtrlRun(uint8_t speed, uint8_t torque, MotorState direction)
         digitalWrite(MOTOR_PH_PIN, LOW);
         analogWrite(MOTOR_REF_PIN, 0);
         digitalWrite(MOTOR_EN_PIN, LOW); // Disable on error
-        return;
+        return false;
     }
 
     // Check for fault condition
     if (motorCtrlCheckFault())
     {
         DEBUG_W("Motor fault active - command ignored");
-        return;
+        return false;
     }
 
     // Set current limit via REF pin (torque parameter)
@@ -153,4 +316,6 @@ void motorCtrlRun(uint8_t speed, uint8_t torque, MotorState direction)
         lastSpeed = speed;
         lastDirection = direction;
     }
+
+    return true;
 }
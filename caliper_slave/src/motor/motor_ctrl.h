@@ -3,7 +3,7 @@
  * @brief STSPIN250 DC Motor Controller Header for ESP32
  * @author System Generated
  * @date 2026-02-23
- * @version 3.0
+ * @version 3.1
  *
  * @details
  * Implementation for STSPIN250 single H-Bridge DC motor driver with full control.
@@ -15,6 +15,7 @@
  * - Enable/disable control via EN pin
  * - Fault detection via FAULT pin (overcurrent, thermal shutdown)
  * - STBY/RESET hardwired to VDD (no standby mode)
+ * - Trapezoidal acceleration/deceleration ramps (see motion_profile.h)
  *
  * Pin Mapping:
  * | GPIO | STSPIN250 Pin | Function |
@@ -38,6 +39,7 @@
 #include <shared_common.h>
 #include <shared_config.h>
 #include <error_handler.h>
+#include "motion_profile.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -104,6 +106,30 @@ extern "C"
      */
     void motorCtrlRun(uint8_t speed, uint8_t torque, MotorState direction);
 
+    /**
+     * @brief Run one stroke with trapezoidal PWM ramps
+     * @param speed Cruise PWM (0-255)
+     * @param torque Motor current limit (0-255), constant over the stroke
+     * @param direction MOTOR_FORWARD or MOTOR_REVERSE; other states are
+     *        applied immediately as with motorCtrlRun()
+     * @param rampUpMs Acceleration 0 -> speed (0 = step)
+     * @param rampDownMs Deceleration speed -> endSpeed, ending at durationMs (0 = step)
+     * @param endSpeed PWM held after durationMs (0 = coast to a stop)
+     * @param durationMs Stroke length, MOTION_PROFILE_OPEN_ENDED = no deceleration
+     * @details
+     * Returns immediately; the duty is updated every MOTOR_PROFILE_PERIOD_MS
+     * from an esp_timer. Any later motorCtrlRun()/motorCtrlRunProfile() call
+     * replaces the running profile. A fault during the stroke stops the PWM
+     * and records ERR_MOTOR_FAULT.
+     */
+    void motorCtrlRunProfile(uint8_t speed, uint8_t torque, MotorState direction,
+                             uint16_t rampUpMs, uint16_t rampDownMs, uint8_t endSpeed, uint32_t durationMs);
+
+    /**
+     * @brief true while a profile is still changing the PWM duty
+     */
+    bool motorCtrlProfileActive(void);
+
 #ifdef __cplusplus
 }
 #endif
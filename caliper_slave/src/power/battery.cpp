@@ -3,18 +3,32 @@
  * @brief Battery voltage monitoring implementation for ESP32
  * @author System Generated
  * @date 2025-12-27
- * @version 1.0
+ * @version 1.2
+ *
+ * @version 1.1 - Continuous DMA sampling with oversampling and eFuse calibration
+ * @version 1.2 - begin() waits for the first frame; calibration released on failure
  */
 
 #include "battery.h"
 
+#include <MacroDebugger.h>
+#include <error_handler.h>
+#include <esp_adc/adc_cali_scheme.h>
 
-uint16_t BatteryMonitor::readVoltageNow()
-{
-    int raw = analogRead(BATTERY_VOLTAGE_PIN);
+#define BATTERY_ADC_ATTEN ADC_ATTEN_DB_12
+#define FRAME_BYTES (BATTERY_ADC_OVERSAMPLING * SOC_ADC_DIGI_RESULT_BYTES)
+#define FRAME_PERIOD_MS ((BATTERY_ADC_OVERSAMPLING * 1000UL + BATTERY_ADC_SAMPLE_RATE_HZ - 1) / BATTERY_ADC_SAMPLE_RATE_HZ)
+#define FIRST_FRAME_TIMEOUT_MS (2 * FRAME_PERIOD_MS) // begin(): wait for the first published voltage
 
-    uint16_t voltage_adc_mV = (uint16_t)((raw * ADC_REFERENCE_VOLTAGE_MV) / ADC_RESOLUTION);
-    float voltage_mV = (float)((uint32_t)voltage_adc_mV * (BATTERY_DIVIDER_R1 + BATTERY_DIVIDER_R2) / BATTERY_DIVIDER_R2);
+static_assert(BATTERY_ADC_SAMPLE_RATE_HZ >= SOC_ADC_SAMPLE_FREQ_THRES_LOW
+    && BATTERY_ADC_SAMPLE_RATE_HZ <= SOC_ADC_SAMPLE_FREQ_THRES_HIGH,
+    "BATTERY_ADC_SAMPLE_RATE_HZ outside the ADC continuous range");
+static_assert(BATTERY_ADC_OVERSAMPLING * 4095ULL * 16 <= UINT32_MAX,
+    "BATTERY_ADC_OVERSAMPLING overflows the frame sum");
+
+uint16_t BatteryMonitor::filter(float pin_mV)
+{
+    float voltage_mV = pin_mV * (BATTERY_DIVIDER_R1 + BATTERY_DIVIDER_R2) / BATTERY_DIVIDER_R2;
 
     if (!filterInitialized)
     {
@@ -28,3 +42,170 @@ uint16_t BatteryMonitor::readVoltageNow()
 
     return (uint16_t)filteredVoltage_mV;
 }
+
+float BatteryMonitor::rawToPin_mV(uint32_t raw16) const
+{
+    const int raw = (int)(raw16 >> 4);
+    const float fraction = (raw16 & 0x0F) * (1.0f / 16.0f);
+
+    if (caliHandle == nullptr)
+    {
+        return (raw + fraction) * ADC_REFERENCE_VOLTAGE_MV / ADC_RESOLUTION;
+    }
+
+    // The calibration curve takes whole codes; interpolate the oversampled fraction
+    int low_mV = 0;
+    int high_mV = 0;
+    adc_cali_raw_to_voltage(caliHandle, raw, &low_mV);
+    adc_cali_raw_to_voltage(caliHandle, raw < ADC_RESOLUTION ? raw + 1 : raw, &high_mV);
+    return low_mV + fraction * (high_mV - low_mV);
+}
+
+void BatteryMonitor::samplerTaskEntry(void *arg)
+{
+    BatteryMonitor *self = static_cast<BatteryMonitor *>(arg);
+    static uint8_t frame[FRAME_BYTES];
+
+    for (;;)
+    {
+        uint32_t length = 0;
+        if (adc_continuous_read(self->adcHandle, frame, FRAME_BYTES, &length, ADC_MAX_DELAY) != ESP_OK)
+        {
+            vTaskDelay(pdMS_TO_TICKS(BATTERY_UPDATE_INTERVAL_MS));
+            continue;
+        }
+
+        uint32_t sum = 0;
+        uint32_t count = 0;
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_output_data_t *result = reinterpret_cast<const adc_digi_output_data_t *>(&frame[i]);
+            if (result->type2.channel == self->channel)
+            {
+                sum += result->type2.data;
+                count++;
+            }
+        }
+        if (count == 0)
+        {
+            continue;
+        }
+
+        // Mean with 4 extra bits from the oversampling
+        const uint32_t raw16 = (sum * 16 + count / 2) / count;
+        self->latest_mV.store(self->filter(self->rawToPin_mV(raw16)), std::memory_order_relaxed);
+    }
+}
+
+bool BatteryMonitor::begin()
+{
+    adc_unit_t unit = ADC_UNIT_1;
+    esp_err_t err = adc_continuous_io_to_channel(BATTERY_VOLTAGE_PIN, &unit, &channel);
+    if (err != ESP_OK || unit != ADC_UNIT_1)
+    {
+        RECORD_ERROR(ERR_ADC_READ_FAILED, "GPIO %d is not an ADC1 channel", BATTERY_VOLTAGE_PIN);
+        return false;
+    }
+
+    adc_continuous_handle_cfg_t handleConfig = {};
+    handleConfig.max_store_buf_size = FRAME_BYTES * 2;
+    handleConfig.conv_frame_size = FRAME_BYTES;
+    err = adc_continuous_new_handle(&handleConfig, &adcHandle);
+    if (err != ESP_OK)
+    {
+        adcHandle = nullptr;
+        RECORD_ERROR(ERR_ADC_READ_FAILED, "ADC continuous init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = BATTERY_ADC_ATTEN;
+    pattern.channel = channel;
+    pattern.unit = unit;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_continuous_config_t adcConfig = {};
+    adcConfig.pattern_num = 1;
+    adcConfig.adc_pattern = &pattern;
+    adcConfig.sample_freq_hz = BATTERY_ADC_SAMPLE_RATE_HZ;
+    adcConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    adcConfig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    err = adc_continuous_config(adcHandle, &adcConfig);
+
+    // eFuse calibration; without it the nominal ADC_REFERENCE_VOLTAGE_MV scale is used
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t caliConfig = {};
+    caliConfig.unit_id = unit;
+    caliConfig.chan = channel;
+    caliConfig.atten = BATTERY_ADC_ATTEN;
+    caliConfig.bitwidth = ADC_BITWIDTH_12;
+    if (adc_cali_create_scheme_curve_fitting(&caliConfig, &caliHandle) != ESP_OK)
+    {
+        caliHandle = nullptr;
+    }
+#endif
+    if (caliHandle == nullptr)
+    {
+        LOG_WARNING(ERR_ADC_READ_FAILED, "No ADC eFuse calibration - using nominal %u mV scale", ADC_REFERENCE_VOLTAGE_MV);
+    }
+
+    if (err == ESP_OK)
+    {
+        err = adc_continuous_start(adcHandle);
+    }
+    if (err == ESP_OK)
+    {
+        BaseType_t created = xTaskCreatePinnedToCore(samplerTaskEntry, "battery", BATTERY_TASK_STACK_SIZE,
+            this, BATTERY_TASK_PRIORITY, &samplerTask, BATTERY_TASK_CORE);
+        if (created != pdPASS)
+        {
+            samplerTask = nullptr;
+            adc_continuous_stop(adcHandle);
+            err = ESP_ERR_NO_MEM;
+        }
+    }
+
+    if (err != ESP_OK)
+    {
+        adc_continuous_deinit(adcHandle);
+        adcHandle = nullptr;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+        if (caliHandle != nullptr)
+        {
+            adc_cali_delete_scheme_curve_fitting(caliHandle);
+            caliHandle = nullptr;
+        }
+#endif
+        RECORD_ERROR(ERR_ADC_READ_FAILED, "ADC continuous start failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    // The first frame takes FRAME_PERIOD_MS; wait for it so that the first
+    // readVoltageNow() already reports a voltage
+    const uint32_t startMs = millis();
+    while (latest_mV.load(std::memory_order_relaxed) == 0 && millis() - startMs < FIRST_FRAME_TIMEOUT_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    if (latest_mV.load(std::memory_order_relaxed) == 0)
+    {
+        LOG_WARNING(ERR_ADC_READ_FAILED, "No battery ADC frame within %lu ms", (unsigned long)FIRST_FRAME_TIMEOUT_MS);
+    }
+
+    DEBUG_I("Battery ADC: continuous %u Hz, %u conversions per reading, %s",
+        BATTERY_ADC_SAMPLE_RATE_HZ, BATTERY_ADC_OVERSAMPLING, caliHandle ? "eFuse calibrated" : "uncalibrated");
+    return true;
+}
+
+uint16_t BatteryMonitor::readVoltageNow()
+{
+    if (adcHandle != nullptr)
+    {
+        return latest_mV.load(std::memory_order_relaxed);
+    }
+
+    int raw = analogRead(BATTERY_VOLTAGE_PIN);
+
+    uint16_t voltage_adc_mV = (uint16_t)((raw * ADC_REFERENCE_VOLTAGE_MV) / ADC_RESOLUTION);
+    return filter((float)voltage_adc_mV);
+}
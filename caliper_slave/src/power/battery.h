@@ -3,17 +3,34 @@
  * @brief Battery voltage monitoring interface for ESP32
  * @author System Generated
  * @date 2025-12-27
- * @version 1.0
+ * @version 1.2
  * 
  * @details
  * Provides interface for reading battery voltage with caching
  * and averaging for better accuracy.
+ *
+ * begin() starts the ADC continuous (DMA) driver on BATTERY_VOLTAGE_PIN.
+ * A background task averages every frame of BATTERY_ADC_OVERSAMPLING
+ * conversions, converts it with the eFuse calibration (curve fitting) and
+ * updates the filtered voltage, so readVoltageNow() only returns the latest
+ * value and never waits for a conversion. begin() waits (bounded) for the
+ * first frame, so the value is valid from the first call. If the continuous
+ * driver cannot be started, readVoltageNow() falls back to one analogRead()
+ * per call.
+ *
+ * @version 1.1 - Continuous DMA sampling with oversampling and eFuse calibration
+ * @version 1.2 - begin() waits for the first frame; 0 mV means unknown
  */
 
 #ifndef BATTERY_H
 #define BATTERY_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_adc/adc_continuous.h>
+#include <esp_adc/adc_cali.h>
 #include "../config.h"
 
 class BatteryMonitor {
@@ -26,15 +43,49 @@ public:
     BatteryMonitor(){}
 
     /**
-     * @brief Force a new voltage reading
-     * @return Voltage in millivolts
-     * @details Bypasses cache and performs immediate measurement
+     * @brief Start continuous sampling and the filter task
+     * @details Blocks until the first frame is converted (two frame periods
+     *          at most, BATTERY_ADC_OVERSAMPLING / BATTERY_ADC_SAMPLE_RATE_HZ each)
+     * @return true if the continuous driver runs
+     *
+     * Possible errors:
+     * - ERR_ADC_READ_FAILED: continuous ADC or task could not be started
+     */
+    bool begin();
+
+    /**
+     * @brief Latest filtered battery voltage
+     * @return Voltage in millivolts; 0 = unknown (no frame converted yet)
+     * @details Non-blocking with the continuous driver; without it performs
+     *          an immediate analogRead() measurement
      */
     uint16_t readVoltageNow();
 
 private:
     float filteredVoltage_mV = 0.0f;
     bool filterInitialized = false;
+
+    adc_continuous_handle_t adcHandle = nullptr;
+    adc_cali_handle_t caliHandle = nullptr;
+    adc_channel_t channel = ADC_CHANNEL_0;
+    TaskHandle_t samplerTask = nullptr;
+    std::atomic<uint16_t> latest_mV{0};
+
+    /**
+     * @brief Feed one pin voltage to the EMA filter
+     * @return Filtered battery voltage in millivolts
+     */
+    uint16_t filter(float pin_mV);
+
+    /**
+     * @brief Pin voltage of an averaged raw value (1/16 LSB resolution)
+     */
+    float rawToPin_mV(uint32_t raw16) const;
+
+    /**
+     * @brief Filter task: average each DMA frame and publish the voltage
+     */
+    static void samplerTaskEntry(void *arg);
 };
 
 #endif // BATTERY_H
@@ -3,10 +3,15 @@
  * @brief IIS328DQ accelerometer sensor implementation for ESP32
  * @author System Generated
  * @date 2025-12-27
- * @version 3.0
+ * @version 3.5
  *
  * @version 2.0 - Integrated comprehensive error code system
  * @version 3.0 - Migrated from ADXL345 to IIS328DQ
+ * @version 3.1 - Background sampler, angles from the window-averaged vector
+ * @version 3.2 - INT1 data-ready pacing, STATUS_REG + XYZ burst read
+ * @version 3.3 - Vibration monitor and quiet wait
+ * @version 3.4 - Single-precision tilt kernel on the count sums
+ * @version 3.5 - Non-blocking isQuiet() replaces waitForQuiet()
  */
 
 #include "accelerometer.h"
@@ -14,17 +19,40 @@
 #include <MacroDebugger.h>
 #include <error_handler.h>
 #include <math.h>
+#include "tilt_kernel.h"
 
 // Register addresses for IIS328DQ
 #define IIS328DQ_WHO_AM_I_REG 0x0F
 #define IIS328DQ_CTRL_REG1 0x20
+#define IIS328DQ_CTRL_REG3 0x22
 #define IIS328DQ_CTRL_REG4 0x23
+#define IIS328DQ_STATUS_REG 0x27
 #define IIS328DQ_OUT_X_L 0x28
 
 // Control register values
-#define CTRL_REG1_VALUE 0x27  // PM=001 (normal mode), DR=00 (50Hz), Zen=Yen=Xen=1
+#define CTRL_REG1_VALUE (0x27 | ((ACCEL_ODR_SELECT & 0x03) << 3))  // PM=001 (normal mode), DR=ACCEL_ODR_SELECT, Zen=Yen=Xen=1
+#define CTRL_REG3_VALUE 0x02  // IHL=0 (active high), PP_OD=0 (push-pull), I1_CFG=10 (INT1 = data ready)
 #define CTRL_REG4_VALUE 0x80  // BDU=1 (block data update), FS=00 (±2g)
 
+#define STATUS_ZYXOR 0x80     // STATUS_REG: new X, Y, Z data overwrote unread data
+
+#define READ_SHORT 0xFF       // readVector(): fewer than 7 bytes received
+
+static constexpr uint16_t ODR_HZ[] = {50, 100, 400, 1000};
+
+// INT1 stays high until the output is read, so a lost edge would stall the
+// sampler; read anyway after two output periods without a notification
+static constexpr uint32_t DRDY_TIMEOUT_MS = 2000 / ODR_HZ[ACCEL_ODR_SELECT & 0x03] + 1;
+
+#if ACCEL_DRDY_PIN >= 0
+static constexpr float SAMPLE_RATE_HZ = ODR_HZ[ACCEL_ODR_SELECT & 0x03];
+#else
+static constexpr float SAMPLE_RATE_HZ = 1000.0f / ACCEL_SAMPLE_PERIOD_MS;
+#endif
+
+static_assert(VIB_WINDOW_SAMPLES >= 1 && VIB_WINDOW_SAMPLES <= VIB_MAX_WINDOW,
+    "VIB_WINDOW_SAMPLES must be 1..VIB_MAX_WINDOW");
+
 uint8_t AccelerometerInterface::readRegister(uint8_t reg)
 {
     Wire.beginTransmission(IIS328DQ_I2CADDR);
@@ -44,9 +72,99 @@ void AccelerometerInterface::writeRegister(uint8_t reg, uint8_t value)
     Wire.endTransmission();
 }
 
+uint8_t AccelerometerInterface::readVector(AccelSample &out, uint8_t &status)
+{
+    // Read STATUS_REG and the 6 output bytes in one burst (MSB=1: auto-increment)
+    Wire.beginTransmission(IIS328DQ_I2CADDR);
+    Wire.write(IIS328DQ_STATUS_REG | 0x80);
+    uint8_t error = Wire.endTransmission(false);
+    
+    if (error != 0)
+    {
+        return error;
+    }
+    
+    Wire.requestFrom((int)IIS328DQ_I2CADDR, 7);
+    
+    if (Wire.available() < 7)
+    {
+        return READ_SHORT;
+    }
+    
+    status = (uint8_t)Wire.read();
+    
+    // Read acceleration data (little-endian: LOW byte first, then HIGH byte)
+    out.x = (int16_t)(Wire.read() | (Wire.read() << 8));
+    out.y = (int16_t)(Wire.read() | (Wire.read() << 8));
+    out.z = (int16_t)(Wire.read() | (Wire.read() << 8));
+    out.timestampMs = millis();
+    return 0;
+}
+
+void AccelerometerInterface::samplerTaskEntry(void *arg)
+{
+    AccelerometerInterface *self = static_cast<AccelerometerInterface *>(arg);
+#if ACCEL_DRDY_PIN < 0
+    TickType_t lastWake = xTaskGetTickCount();
+#endif
+    bool failing = false;
+
+    for (;;)
+    {
+#if ACCEL_DRDY_PIN >= 0
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DRDY_TIMEOUT_MS));
+#endif
+        AccelSample sample;
+        uint8_t status = 0;
+        const uint8_t error = self->readVector(sample, status);
+        if (error == 0)
+        {
+            self->samples.push(sample);
+            self->vibration.feed(sample.x, sample.y, sample.z, sample.timestampMs);
+#if ACCEL_DRDY_PIN >= 0
+            if (status & STATUS_ZYXOR)
+            {
+                self->overruns = self->overruns + 1;
+            }
+#endif
+            failing = false;
+        }
+        else
+        {
+            self->readErrors = self->readErrors + 1;
+            // Report only the first failure of a run, not every period
+            if (!failing)
+            {
+                if (error == READ_SHORT)
+                {
+                    RECORD_ERROR(ERR_ACCEL_READ_FAILED, "IIS328DQ insufficient data available");
+                }
+                else
+                {
+                    RECORD_ERROR(ERR_ACCEL_I2C_ERROR, "IIS328DQ I2C error: %d", error);
+                }
+            }
+            failing = true;
+        }
+
+#if ACCEL_DRDY_PIN < 0
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(ACCEL_SAMPLE_PERIOD_MS));
+#endif
+    }
+}
+
+void IRAM_ATTR AccelerometerInterface::onDataReady(void *arg)
+{
+    AccelerometerInterface *self = static_cast<AccelerometerInterface *>(arg);
+    BaseType_t higherPriorityWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(self->samplerTask, &higherPriorityWoken);
+    portYIELD_FROM_ISR(higherPriorityWoken);
+}
+
 bool AccelerometerInterface::begin()
 {
     Wire.begin(3, 46);
+    Wire.setClock(ACCEL_I2C_CLOCK_HZ);
 
     // Check device ID
     uint8_t deviceId = readRegister(IIS328DQ_WHO_AM_I_REG);
@@ -56,67 +174,90 @@ bool AccelerometerInterface::begin()
         return false;
     }
     
-    // Configure: Normal mode, 50Hz, all axes enabled
+    // Configure: Normal mode, ACCEL_ODR_SELECT data rate, all axes enabled
     writeRegister(IIS328DQ_CTRL_REG1, CTRL_REG1_VALUE);
     
     // Configure: BDU enabled, ±2g range
     writeRegister(IIS328DQ_CTRL_REG4, CTRL_REG4_VALUE);
     
-    DEBUG_I("IIS328DQ initialized successfully at address 0x%02X", IIS328DQ_I2CADDR);
+#if ACCEL_DRDY_PIN >= 0
+    // Configure: INT1 = data ready, active high, push-pull
+    writeRegister(IIS328DQ_CTRL_REG3, CTRL_REG3_VALUE);
+#endif
+    
+    if (samplerTask == nullptr)
+    {
+        vibration.configure(SAMPLE_RATE_HZ, VIB_HPF_CUTOFF_HZ, VIB_WINDOW_SAMPLES, MG_PER_COUNT);
+
+        BaseType_t created = xTaskCreatePinnedToCore(samplerTaskEntry, "accel", ACCEL_TASK_STACK_SIZE,
+            this, ACCEL_TASK_PRIORITY, &samplerTask, ACCEL_TASK_CORE);
+        if (created != pdPASS)
+        {
+            samplerTask = nullptr;
+            RECORD_ERROR(ERR_ACCEL_INIT_FAILED, "IIS328DQ sampler task creation failed");
+            return false;
+        }
+
+#if ACCEL_DRDY_PIN >= 0
+        pinMode(ACCEL_DRDY_PIN, INPUT);
+        attachInterruptArg(digitalPinToInterrupt(ACCEL_DRDY_PIN), onDataReady, this, RISING);
+#endif
+    }
+    
+#if ACCEL_DRDY_PIN >= 0
+    DEBUG_I("IIS328DQ initialized successfully at address 0x%02X (ODR %u Hz, INT1 data-ready on GPIO %d, window %u)",
+        IIS328DQ_I2CADDR, ODR_HZ[ACCEL_ODR_SELECT & 0x03], ACCEL_DRDY_PIN, ACCEL_WINDOW_SAMPLES);
+#else
+    DEBUG_I("IIS328DQ initialized successfully at address 0x%02X (ODR %u Hz, sampling every %u ms, window %u)",
+        IIS328DQ_I2CADDR, ODR_HZ[ACCEL_ODR_SELECT & 0x03], ACCEL_SAMPLE_PERIOD_MS, ACCEL_WINDOW_SAMPLES);
+#endif
     return true;
 }
 
 void AccelerometerInterface::update()
 {
-    // Read 6 bytes starting at OUT_X_L with auto-increment (MSB=1)
-    Wire.beginTransmission(IIS328DQ_I2CADDR);
-    Wire.write(IIS328DQ_OUT_X_L | 0x80);  // Set MSB for auto-increment
-    uint8_t error = Wire.endTransmission(false);
-    
-    if (error != 0)
+    AccelSample sample;
+    if (!samples.latest(0, sample))
     {
-        RECORD_ERROR(ERR_ACCEL_I2C_ERROR, "IIS328DQ I2C error: %d", error);
+        RECORD_ERROR(ERR_ACCEL_READ_FAILED, "IIS328DQ no samples yet");
         return;
     }
     
-    Wire.requestFrom((int)IIS328DQ_I2CADDR, 6);
-    
-    if (Wire.available() < 6)
+    const uint32_t age = millis() - sample.timestampMs;
+    if (age > ACCEL_STALE_MS)
     {
-        RECORD_ERROR(ERR_ACCEL_READ_FAILED, "IIS328DQ insufficient data available");
+        RECORD_ERROR(ERR_ACCEL_READ_FAILED, "IIS328DQ newest sample is stale (%u ms)", (unsigned)age);
         return;
     }
     
-    // Read acceleration data (little-endian: LOW byte first, then HIGH byte)
-    int16_t rawX = (int16_t)(Wire.read() | (Wire.read() << 8));
-    int16_t rawY = (int16_t)(Wire.read() | (Wire.read() << 8));
-    int16_t rawZ = (int16_t)(Wire.read() | (Wire.read() << 8));
-    
-    // Convert to g (±2g range, 0.98 mg/LSB)
-    float accX = rawX * SENSIVITY_MG_PER_LSB * 0.001f;  // Convert mg to g
-    float accY = rawY * SENSIVITY_MG_PER_LSB * 0.001f;
-    float accZ = rawZ * SENSIVITY_MG_PER_LSB * 0.001f;
-    
-    // Calculate tilt angles in degrees
-    // Roll (X-axis rotation) - angle around X-axis
-    angle.x = atan2(accY, accZ) * RAD_TO_DEG;
-    
-    // Pitch (Y-axis rotation) - angle around Y-axis
-    angle.y = atan2(-accX, sqrt(accY * accY + accZ * accZ)) * RAD_TO_DEG;
-    
-    // Z-angle (inclination from vertical) - this is what we want for angleZ
-    float magnitude = sqrt(accX * accX + accY * accY + accZ * accZ);
-    if (magnitude > 0.001f)
+    // Sum the window; fewer vectors are used right after begin()
+    int32_t sumX = 0;
+    int32_t sumY = 0;
+    int32_t sumZ = 0;
+    for (uint32_t n = 0; n < ACCEL_WINDOW_SAMPLES; n++)
     {
-        angle.z = acos(fabs(accZ) / magnitude) * RAD_TO_DEG;
-        
-        // Ensure angle.z is in range 0-90 degrees (inclination from vertical)
-        // This represents deviation from vertical (0 = perfectly vertical, 90 = horizontal)
-        // Using fabs(accZ) ensures it works regardless of sensor orientation
-        if (angle.z > 90.0f) angle.z = 90.0f;
+        if (!samples.latest(n, sample))
+        {
+            break;
+        }
+        sumX += sample.x;
+        sumY += sample.y;
+        sumZ += sample.z;
     }
-    else
+    
+    // The angles do not depend on the scale, so the sums are used directly
+    const TiltAngles tilt = tiltFromCounts(sumX, sumY, sumZ);
+    angle = {tilt.x, tilt.y, tilt.z};
+}
+
+bool AccelerometerInterface::isQuiet(float rmsMg, float peakMg, VibrationLevel &level) const
+{
+    if (!vibration.level(level))
     {
-        angle.z = 0.0f;
+        level = {0.0f, 0.0f, 0, 0};
+        return false;
     }
+    
+    return (millis() - level.timestampMs) <= ACCEL_STALE_MS
+        && level.rmsMg <= rmsMg && level.peakMg <= peakMg;
 }
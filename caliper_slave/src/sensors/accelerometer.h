@@ -3,14 +3,33 @@
  * @brief IIS328DQ accelerometer sensor interface for ESP32
  * @author System Generated
  * @date 2025-12-27
- * @version 3.0
+ * @version 3.5
  *
  * @details
  * Provides interface for reading angle measurements from IIS328DQ
  * accelerometer via I2C communication.
  *
+ * After begin() a background task samples the sensor every
+ * ACCEL_SAMPLE_PERIOD_MS into an OverwriteRing of raw XYZ vectors. update()
+ * averages the newest ACCEL_WINDOW_SAMPLES vectors and computes the angles
+ * from the mean vector, so the measurement path never waits for I2C and the
+ * angle noise is reduced by roughly sqrt(ACCEL_WINDOW_SAMPLES).
+ *
+ * With ACCEL_DRDY_PIN wired to INT1 the sampler is paced by the sensor's
+ * data-ready signal instead of a timer: the ISR only wakes the task, which
+ * reads STATUS_REG and the three axes in one 7-byte burst. Every output
+ * sample is read once and data overruns are counted.
+ *
+ * Every sampled vector also feeds a VibrationMonitor (high-pass filtered
+ * RMS / peak); isQuiet() lets the measurement cycle wait for a still fixture.
+ *
  * @version 2.0 - Integrated comprehensive error code system
  * @version 3.0 - Migrated from ADXL345 to IIS328DQ
+ * @version 3.1 - Background sampler, angles from the window-averaged vector
+ * @version 3.2 - INT1 data-ready pacing, STATUS_REG + XYZ burst read
+ * @version 3.3 - Vibration monitor and quiet wait
+ * @version 3.4 - Single-precision tilt kernel on the count sums
+ * @version 3.5 - Non-blocking isQuiet() replaces waitForQuiet()
  */
 
 #ifndef ACCELEROMETER_H
@@ -18,9 +37,13 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "../config.h"
 #include <shared_common.h>
 #include <error_handler.h>
+#include <overwrite_ring.h>
+#include "vibration_monitor.h"
 
 /**
  * @brief Simple 3-axis float structure for angle data
@@ -31,6 +54,16 @@ struct AngleData {
     float z;
 };
 
+/**
+ * @brief One raw IIS328DQ vector as read by the sampler
+ */
+struct AccelSample {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint32_t timestampMs;   /**< millis() when the vector was read */
+};
+
 /**
  * @brief IIS328DQ accelerometer driver class
  * 
@@ -48,15 +81,46 @@ private:
     // Register addresses
     static constexpr uint8_t REG_WHO_AM_I = 0x0F;
     static constexpr uint8_t REG_CTRL_REG1 = 0x20;
+    static constexpr uint8_t REG_CTRL_REG3 = 0x22;
     static constexpr uint8_t REG_CTRL_REG4 = 0x23;
+    static constexpr uint8_t REG_STATUS_REG = 0x27;
     static constexpr uint8_t REG_OUT_X_L = 0x28;
     static constexpr uint8_t REG_OUT_X_H = 0x29;
     
     // Sensitivity for ±2g range: 0.98 mg/LSB
     static constexpr float SENSIVITY_MG_PER_LSB = 0.98f;
     
+    // Output registers hold the 12-bit value left-justified (16 counts per LSB)
+    static constexpr float MG_PER_COUNT = SENSIVITY_MG_PER_LSB / 16.0f;
+    
     // Angle data - initialized to zero for safety
     AngleData angle = {0.0f, 0.0f, 0.0f};
+
+    // Newest raw vectors, written only by the sampler task
+    OverwriteRing<AccelSample, ACCEL_RING_SIZE> samples;
+    TaskHandle_t samplerTask = nullptr;
+    volatile uint32_t readErrors = 0;
+    volatile uint32_t overruns = 0;
+    VibrationMonitor vibration;
+    
+    /**
+     * @brief One 7-byte burst read of STATUS_REG..OUT_Z_H (sampler task only)
+     * @param out Receives the vector
+     * @param status Receives STATUS_REG
+     * @return I2C error code from endTransmission, or 0xFF on a short read
+     */
+    uint8_t readVector(AccelSample &out, uint8_t &status);
+
+    /**
+     * @brief Sampler task: readVector() into the ring on every data-ready
+     *        notification (or every ACCEL_SAMPLE_PERIOD_MS without INT1)
+     */
+    static void samplerTaskEntry(void *arg);
+
+    /**
+     * @brief INT1 data-ready ISR, wakes the sampler task
+     */
+    static void IRAM_ATTR onDataReady(void *arg);
     
     /**
      * @brief Read a single register
@@ -73,9 +137,13 @@ private:
     void writeRegister(uint8_t reg, uint8_t value);
     
 public:
+    static_assert(ACCEL_WINDOW_SAMPLES >= 1 && ACCEL_WINDOW_SAMPLES <= ACCEL_RING_SIZE,
+        "ACCEL_WINDOW_SAMPLES must fit the sample ring");
+
     /**
      * @brief Initialize accelerometer
-     * @details Initializes I2C communication and configures IIS328DQ
+     * @details Initializes I2C communication, configures IIS328DQ and starts
+     *          the background sampler task
      *
      * Possible errors:
      * - ERR_ACCEL_INIT_FAILED: IIS328DQ initialization failed
@@ -87,12 +155,56 @@ public:
     
     /**
      * @brief Read current angle values
-     * @details Updates internal angle values from accelerometer
+     * @details Updates internal angle values from the average of the newest
+     *          ACCEL_WINDOW_SAMPLES sampled vectors. No I2C traffic; the
+     *          previous angles are kept when no fresh window is available.
      *
      * Possible errors:
-     * - ERR_ACCEL_READ_FAILED: Read operation failed
+     * - ERR_ACCEL_READ_FAILED: No samples yet or newest sample is stale
      */
     void update();
+
+    /**
+     * @brief Copy the n-th newest raw vector (0 = newest)
+     * @return false if not available (see OverwriteRing::latest)
+     */
+    bool readLatest(AccelSample &out, uint32_t n = 0) const { return samples.latest(n, out); }
+
+    /**
+     * @brief Number of vectors sampled since begin()
+     */
+    uint32_t getSampleCount() const { return samples.pushed(); }
+
+    /**
+     * @brief Number of failed sampler reads since begin()
+     */
+    uint32_t getReadErrors() const { return readErrors; }
+
+    /**
+     * @brief Number of output samples overwritten before they were read
+     *        (INT1 pacing only, STATUS_REG ZYXOR)
+     */
+    uint32_t getOverruns() const { return overruns; }
+
+    /**
+     * @brief Newest vibration level
+     * @return false until the sampler has filled one vibration window
+     */
+    bool getVibration(VibrationLevel &out) const { return vibration.level(out); }
+
+    /**
+     * @brief Check whether the fixture is still (non-blocking)
+     * @param rmsMg Maximum RMS in mg
+     * @param peakMg Maximum peak in mg
+     * @param level Receives the newest level (zero if none)
+     * @return true if a fresh level is within both limits
+     */
+    bool isQuiet(float rmsMg, float peakMg, VibrationLevel &level) const;
+
+    /**
+     * @brief true once begin() has started the sampler task
+     */
+    bool isSampling() const { return samplerTask != nullptr; }
     
     /**
      * @brief Get X-axis angle (Roll)
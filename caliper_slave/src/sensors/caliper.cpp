@@ -6,33 +6,62 @@
  * @version 2.0
  *
  * @version 2.0 - Integrated comprehensive error code system
+ * @version 2.1 - Register-level capture ISR with bit-packed 64-bit frame word
+ * @version 2.2 - Free-running capture mode with lock-free frame ring
+ * @version 2.3 - Optional SPI-slave DMA capture backend (SPC_CAPTURE_SPI)
+ * @version 2.4 - Reliable measurement via configurable consensus engine
+ * @version 2.5 - Edge-timing frame synchroniser with glitch rejection
+ * @version 2.6 - LengthSensor (CRTP) backend
+ * @version 2.7 - Capture ISR on falling edges only
+ * @version 2.8 - readLatest(valueMm, timestampUs) of the LengthSensor interface
  */
 
 #include "caliper.h"
+#include "spc_decoder.h"
 
 #if defined(SPC)
 
 #include <MacroDebugger.h>
 #include <error_handler.h>
 
+#include <soc/gpio_reg.h>
+#include <esp_cpu.h>
+
+// The capture ISR samples both lines from a single read of GPIO_IN_REG,
+// which only covers GPIO0..31.
+static_assert(CLOCK_PIN < 32 && DATA_PIN < 32, "SPC capture pins must be in GPIO0..31");
+
+static constexpr uint32_t CLOCK_PIN_MASK = 1UL << CLOCK_PIN;
+static constexpr uint32_t DATA_PIN_MASK = 1UL << DATA_PIN;
+
 // Static member initialization
-volatile uint8_t CaliperInterface::bitBuffer[CALIPER_BIT_BUFFER_SIZE] = {0};
-volatile int CaliperInterface::bitCount = 0;
+volatile uint64_t CaliperInterface::frameWord = 0;
 volatile bool CaliperInterface::dataReady = false;
-volatile uint8_t bit;
+SpcFrameSync CaliperInterface::frameSync;
+volatile bool CaliperInterface::continuousMode = false;
+volatile uint32_t CaliperInterface::droppedFrames = 0;
+SpscRing<SpcRawFrame, CALIPER_FRAME_RING_SIZE> CaliperInterface::frameRing;
 
 /**
  * @brief Interrupt Service Routine (ISR) for caliper clock signal
  *
- * This function is called automatically on each falling edge
- * of the clock signal (CLOCK_PIN). Reads a bit from the data line
- * and stores it to the buffer.
+ * This function is called automatically on every falling edge of the clock
+ * signal (CLOCK_PIN), once per bit. It timestamps the edge and hands it to
+ * frameSync, which assembles bits into the packed frame word.
  *
  * @details
  * - ISR runs in IRAM (Instruction RAM) for maximum performance
- * - Reads bit from DATA_PIN on each clock edge
- * - Stores bits to bitBuffer[0..51] (52 bits total)
- * - Sets dataReady flag after receiving all bits
+ * - CLOCK and DATA are sampled with one read of GPIO_IN_REG instead of
+ *   several digitalRead() calls (each of which is a function call plus
+ *   pin-to-register lookup)
+ * - Edges are timestamped with the CPU cycle counter; frameSync rejects
+ *   edges closer than SPC_MIN_BIT_PERIOD_US to the previous one and starts
+ *   at bit 0 after an idle gap longer than SPC_FRAME_GAP_US, so a capture
+ *   that starts in the middle of a frame never yields a shifted frame
+ * - Bit n of the frame is stored at bit n of the frame word (LSB-first)
+ * - One-shot mode: copies the frame to frameWord and sets dataReady
+ * - Free-running mode: pushes the completed frame with a micros() timestamp
+ *   into frameRing; frameSync continues with the next frame
  *
  * Caliper data format:
  * - 52 bits total (including header)
@@ -44,126 +73,27 @@ volatile uint8_t bit;
  */
 void IRAM_ATTR CaliperInterface::clockISR()
 {
-    bit = digitalRead(CLOCK_PIN);
-    if(bit == HIGH) return; // Only process on falling edge
+    const uint32_t now = esp_cpu_get_cycle_count();
+    const uint32_t in = REG_READ(GPIO_IN_REG);
 
-    if (bitCount < CALIPER_BIT_BUFFER_SIZE)
+    if (!frameSync.onFalling(now, (in & CLOCK_PIN_MASK) == 0, (in & DATA_PIN_MASK) != 0))
     {
-        bit = digitalRead(DATA_PIN);
-        bit = digitalRead(DATA_PIN);
-        bit = digitalRead(DATA_PIN);
-
-        bitBuffer[bitCount] = bit;
-        bitCount = bitCount + 1;
-        if (bitCount == CALIPER_BIT_BUFFER_SIZE)
-        {
-            dataReady = true;
-        }
+        return;
     }
-}
 
-/**
- * @brief Reverses the bit order in the buffer
- *
- * This function reverses the bit order received from the caliper.
- * This is necessary because the caliper protocol sends bits
- * in reverse order to what the decoder expects.
- *
- * @details
- * Algorytm:
- * - Iterates through the first half of the buffer (0 to 25)
- * - Zamienia miejscami bit[i] z bit[51-i]
- * - Po zamianie: bit[0] ↔ bit[51], bit[1] ↔ bit[50], itd.
- *
- * Example for 8 bits:
- * Before: [0, 1, 0, 1, 1, 0, 0, 1]
- * Po:     [1, 0, 0, 1, 1, 0, 1, 0]
- *
- * Note: This function operates on bitBuffer, which is volatile,
- * but is safe because it is called after ISR completes
- * (when interrupts are detached).
- */
-void CaliperInterface::reverseBits()
-{
-    for (int i = 0; i < CALIPER_BIT_BUFFER_SIZE / 2; i++)
-    {
-        uint8_t temp = bitBuffer[i];
-        bitBuffer[i] = bitBuffer[CALIPER_BIT_BUFFER_SIZE - 1 - i];
-        bitBuffer[CALIPER_BIT_BUFFER_SIZE - 1 - i] = temp;
-    }
-}
-
-/**
- * @brief Decodes caliper data to value in millimeters
- *
- * This function decodes the raw bits received from the caliper and converts
- * them into a measurement value in millimeters.
- *
- * @details
- * Caliper data format (after bit reversal):
- * - 52 bits total
- * - First 8 bits (0-7): header (ignored)
- * - Next 44 bits (8-51): measurement data
- *
- * Step 1: Bit shift
- * - Removes 8-bit header
- * - shifted[0] = bitBuffer[8], shifted[1] = bitBuffer[9], itd.
- *
- * Step 2: Grouping into nibbles (4 bits)
- * - 44 bity = 11 nibbli po 4 bity
- * - Each nibble represents one BCD digit
- * - nibbles[0..4]: decimal digits (0-9)
- * - nibbles[5]: units (0-9)
- * - nibbles[6]: flags (bit 2: inch mode, bit 3: negative)
- *
- * Step 3: BCD decoding
- * - BCD (Binary Coded Decimal): each digit is encoded as 4 bits
- * - Value = Σ(nibbles[i] × 10^i) for i = 0..4
- * - Example: nibbles = [5, 4, 3, 2, 1] → 1×10⁴ + 2×10³ + 3×10² + 4×10¹ + 5×10⁰ = 12345
- *
- * Step 4: Flag handling
- * - negative (nibbles[6] & 0x08): if true, value is negative
- * - inchMode (nibbles[6] & 0x04): if true, value is in inches
- *
- * Step 5: Unit conversion
- * - Dividing by CALIPER_VALUE_DIVISOR (1000.0) converts to millimeters
- * - If inchMode: multiplication by INCH_TO_MM_FACTOR (25.4) converts inches → mm
- *
- * Examples:
- * - nibbles = [5, 4, 3, 2, 1, 0, 0x00] → 123.456 mm
- * - nibbles = [5, 4, 3, 2, 1, 0, 0x04] → 123.456 mm (inch mode, but already in mm)
- * - nibbles = [5, 4, 3, 2, 1, 0, 0x08] → -123.456 mm
- *
- * @return Measurement value in millimeters
- */
-float CaliperInterface::decodeCaliper()
-{
-    uint8_t shifted[CALIPER_BIT_BUFFER_SIZE];
-    for (int i = 0; i < CALIPER_BIT_BUFFER_SIZE; i++)
+    if (continuousMode)
     {
-        if (i + CALIPER_BIT_SHIFT < CALIPER_BIT_BUFFER_SIZE)
-            shifted[i] = bitBuffer[i + CALIPER_BIT_SHIFT];
-        else
-            shifted[i] = 0;
+        const SpcRawFrame raw = {frameSync.frameWord(), (uint32_t)micros()};
+        if (!frameRing.push(raw))
+        {
+            droppedFrames = droppedFrames + 1;
+        }
     }
-    uint8_t nibbles[CALIPER_NIBBLE_COUNT];
-    for (int i = 0; i < CALIPER_NIBBLE_COUNT; i++)
+    else if (!dataReady)
     {
-        nibbles[i] = 0;
-        for (int j = 0; j < BITS_PER_NIBBLE; j++)
-            nibbles[i] |= (shifted[i * BITS_PER_NIBBLE + (BITS_PER_NIBBLE - 1 - j)] << j);
+        frameWord = frameSync.frameWord();
+        dataReady = true;
     }
-    long value = 0;
-    for (int i = 0; i < CALIPER_DECIMAL_DIGITS; i++)
-        value += nibbles[i] * pow(10, i);
-    bool negative = nibbles[6] & 0x08;
-    bool inchMode = nibbles[6] & 0x04;
-    float measurement = value / CALIPER_VALUE_DIVISOR;
-    if (negative)
-        measurement = -measurement;
-    if (inchMode)
-        measurement *= INCH_TO_MM_FACTOR;
-    return measurement;
 }
 
 void CaliperInterface::begin()
@@ -172,10 +102,17 @@ void CaliperInterface::begin()
     pinMode(CLOCK_PIN, INPUT_PULLUP);
     pinMode(TRIG_PIN, OUTPUT);
     digitalWrite(TRIG_PIN, HIGH);
+
+    const uint32_t cyclesPerUs = getCpuFrequencyMhz();
+    frameSync.configure(SPC_MIN_BIT_PERIOD_US * cyclesPerUs, SPC_FRAME_GAP_US * cyclesPerUs);
+
+#if defined(SPC_CAPTURE_SPI)
+    spiCapture.begin();
+#endif
 }
 
 /**
- * @brief Performs a single caliper measurement
+ * @brief Performs a single triggered caliper measurement (one-shot mode)
  *
  * This function triggers a measurement, waits for data reception, decodes it
  * and returns the value in millimeters.
@@ -188,10 +125,10 @@ void CaliperInterface::begin()
  *    - Caliper starts sending data via CLOCK_PIN
  *
  * 2. Waiting for data:
- *    - Reset bit counter (bitCount = 0)
+ *    - Reset frame word and frame synchroniser
  *    - Reset ready flag (dataReady = false)
- *    - Attach ISR to CLOCK_PIN (falling edge)
- *    - ISR (clockISR) reads bits to bitBuffer
+ *    - Attach ISR to CLOCK_PIN (falling edges)
+ *    - ISR (clockISR) assembles bits and stores the frame in frameWord
  *
  * 3. Timeout:
  *    - Maximum time: MEASUREMENT_TIMEOUT_MS (200ms)
@@ -203,8 +140,7 @@ void CaliperInterface::begin()
  *    - TRIG_PIN → HIGH (deactivates caliper)
  *
  * 5. Decoding (if dataReady):
- *    - Reverse bit order (reverseBits)
- *    - BCD decoding (decodeCaliper)
+ *    - BCD decoding of the packed frame (spcDecodeFrame)
  *
  * 6. Result validation:
  *    - Range check: MEASUREMENT_MIN_VALUE to MEASUREMENT_MAX_VALUE
@@ -223,13 +159,29 @@ void CaliperInterface::begin()
  *
  * @return Measurement value in millimeters or INVALID_MEASUREMENT_VALUE on error
  */
-float CaliperInterface::performMeasurement()
+float CaliperInterface::performOneShotMeasurement()
 {
     DEBUG_I("Triggering measurement TRIG...");
 
-    bitCount = 0;
+    frameWord = 0;
     dataReady = false;
 
+#if defined(SPC_CAPTURE_SPI)
+    SpcRawFrame raw;
+    spiCapture.arm(1);
+    digitalWrite(TRIG_PIN, LOW);
+
+    if (spiCapture.waitFrame(raw, MEASUREMENT_TIMEOUT_MS))
+    {
+        frameWord = raw.frame;
+        dataReady = true;
+    }
+
+    digitalWrite(TRIG_PIN, HIGH);
+    spiCapture.disarm();
+#else
+    // TRIG is still high, so the caliper is silent: the next edge is bit 0
+    frameSync.reset(esp_cpu_get_cycle_count(), true);
     attachInterrupt(digitalPinToInterrupt(CLOCK_PIN), clockISR, FALLING);
     digitalWrite(TRIG_PIN, LOW);
 
@@ -241,13 +193,13 @@ float CaliperInterface::performMeasurement()
 
     detachInterrupt(digitalPinToInterrupt(CLOCK_PIN));
     digitalWrite(TRIG_PIN, HIGH);
+#endif
 
     if (dataReady)
     {
-        reverseBits();
-        float result = decodeCaliper();
+        float result = spcDecodeFrame(frameWord);
 
-        if (result >= MEASUREMENT_MIN_VALUE && result <= MEASUREMENT_MAX_VALUE && !isnan(result) && !isinf(result))
+        if (isValidValue(result))
         {
             DEBUG_I("Measurement: %.3f mm", result);
             return result;
@@ -267,52 +219,197 @@ float CaliperInterface::performMeasurement()
 }
 
 /**
- * @brief Perform a reliable measurement with two consecutive identical readings
+ * @brief Perform a reliable measurement using the consensus engine
  *
- * Calls performMeasurement() repeatedly and accepts the result only when two
- * consecutive readings return the same value, to filter out sporadic bad
- * readings from the caliper.
+ * Takes readings with performMeasurement() until the configured consensus
+ * criterion is met or the consensus timeout expires.
  *
  * @details
- * Loop behavior:
- * - Each iteration calls performMeasurement().
- * - A reading equal to INVALID_MEASUREMENT_VALUE is treated as a failed
- *   attempt and does not count as a candidate; the loop continues.
- * - A valid reading is compared with the last valid reading. If they match,
- *   the value is returned as the reliable result.
- * - The whole procedure is bounded by RELIABLE_MEASUREMENT_TIMEOUT_MS (1s).
- * - On timeout (no two consecutive identical readings), returns
- *   INVALID_MEASUREMENT_VALUE and records ERR_CALIPER_INVALID_DATA.
+ * - One-shot mode: every reading is a full trigger/capture cycle.
+ * - Free-running mode: every reading is the next frame completed after the
+ *   previous one, so consecutive readings are consecutive frames.
+ * - Readings equal to INVALID_MEASUREMENT_VALUE count as attempts but are
+ *   not used for the decision.
+ * - With the default K_OF_M (k = 2, m = 2, tolerance 0) this is the original
+ *   "two consecutive identical readings" rule.
+ * - Value, attempts, spread and elapsed time are kept in lastConsensus.
  *
  * @return Measurement value in millimeters or INVALID_MEASUREMENT_VALUE on error
  */
 float CaliperInterface::performReliableMeasurement()
 {
+    lastConsensus = runConsensus(consensusConfig,
+        [this]() { return performMeasurement(); },
+        []() { return (uint32_t)millis(); });
+
+    if (!lastConsensus.ok)
+    {
+        RECORD_ERROR(ERR_CALIPER_INVALID_DATA,
+            "Reliable measurement failed: no consensus within %u ms (%u attempts)",
+            (unsigned)consensusConfig.timeoutMs, (unsigned)lastConsensus.attempts);
+        return INVALID_MEASUREMENT_VALUE;
+    }
+
+    DEBUG_I("Reliable measurement: %.3f mm (attempts=%u spread=%.3f elapsed=%u ms)",
+        lastConsensus.value, (unsigned)lastConsensus.attempts,
+        lastConsensus.spread, (unsigned)lastConsensus.elapsedMs);
+    return lastConsensus.value;
+}
+
+/**
+ * @brief Performs a caliper measurement in the active capture mode
+ *
+ * One-shot mode delegates to performOneShotMeasurement(). In free-running
+ * mode the caliper is already sending frames, so the call only waits for the
+ * first frame that completes after it was made (at most one frame period)
+ * and returns its decoded value.
+ *
+ * @return Measurement value in millimeters or INVALID_MEASUREMENT_VALUE on error
+ */
+float CaliperInterface::performMeasurement()
+{
+    if (!continuousMode)
+    {
+        return performOneShotMeasurement();
+    }
+
+    const uint32_t startUs = micros();
     unsigned long startTime = millis();
-    float lastValid = INVALID_MEASUREMENT_VALUE;
 
-    while (millis() - startTime < RELIABLE_MEASUREMENT_TIMEOUT_MS)
+    while (millis() - startTime < MEASUREMENT_TIMEOUT_MS)
     {
-        float current = performMeasurement();
+        drainFrames();
 
-        if (current == INVALID_MEASUREMENT_VALUE)
+        SpcSample newest;
+        if (getHistory(0, newest) && (int32_t)(newest.timestampUs - startUs) >= 0)
         {
+            DEBUG_I("Measurement: %.3f mm", newest.value);
+            return newest.value;
+        }
+
+        delay(POLL_DELAY_MS);
+    }
+
+    RECORD_ERROR(ERR_CALIPER_TIMEOUT, "No frame within %u ms (free-running)", MEASUREMENT_TIMEOUT_MS);
+    return INVALID_MEASUREMENT_VALUE;
+}
+
+void CaliperInterface::startContinuous()
+{
+    if (continuousMode)
+    {
+        return;
+    }
+
+    frameRing.clear();
+    historyHead = 0;
+    historyCount = 0;
+    droppedFrames = 0;
+
+    frameWord = 0;
+    dataReady = false;
+    continuousMode = true;
+
+#if defined(SPC_CAPTURE_SPI)
+    spiCapture.arm(CALIPER_FRAME_RING_SIZE);
+#else
+    // TRIG is still high, so the caliper is silent: the next edge is bit 0
+    frameSync.reset(esp_cpu_get_cycle_count(), true);
+    attachInterrupt(digitalPinToInterrupt(CLOCK_PIN), clockISR, FALLING);
+#endif
+    digitalWrite(TRIG_PIN, LOW);
+
+    DEBUG_I("Caliper free-running capture started");
+}
+
+void CaliperInterface::stopContinuous()
+{
+    if (!continuousMode)
+    {
+        return;
+    }
+
+#if defined(SPC_CAPTURE_SPI)
+    spiCapture.disarm();
+#else
+    detachInterrupt(digitalPinToInterrupt(CLOCK_PIN));
+#endif
+    digitalWrite(TRIG_PIN, HIGH);
+    continuousMode = false;
+
+    DEBUG_I("Caliper free-running capture stopped (dropped frames: %u)", (unsigned)droppedFrames);
+}
+
+bool CaliperInterface::readLatest(SpcSample &out)
+{
+    if (!continuousMode)
+    {
+        return false;
+    }
+
+    drainFrames();
+    return getHistory(0, out);
+}
+
+bool CaliperInterface::readLatest(float &valueMm, uint32_t &timestampUs)
+{
+    if (continuousMode)
+    {
+        SpcSample sample;
+        if (!readLatest(sample))
+        {
+            return false;
+        }
+        valueMm = sample.value;
+        timestampUs = sample.timestampUs;
+        return true;
+    }
+
+    valueMm = performMeasurement();
+    timestampUs = micros();
+    return true;
+}
+
+void CaliperInterface::drainFrames()
+{
+    SpcRawFrame raw;
+#if defined(SPC_CAPTURE_SPI)
+    while (spiCapture.pop(raw))
+#else
+    while (frameRing.pop(raw))
+#endif
+    {
+        const float value = spcDecodeFrame(raw.frame);
+        if (!isValidValue(value))
+        {
+            RECORD_ERROR(ERR_CALIPER_INVALID_DATA, "Frame value: %.3f (range: %.1f to %.1f)",
+                value, MEASUREMENT_MIN_VALUE, MEASUREMENT_MAX_VALUE);
             continue;
         }
 
-        if (lastValid != INVALID_MEASUREMENT_VALUE && current == lastValid)
+        history[historyHead] = {value, raw.timestampUs};
+        historyHead = (historyHead + 1) % CALIPER_HISTORY_SIZE;
+        if (historyCount < CALIPER_HISTORY_SIZE)
         {
-            DEBUG_I("Reliable measurement: %.3f mm", current);
-            return current;
+            historyCount++;
         }
+    }
+}
 
-        lastValid = current;
+bool CaliperInterface::getHistory(uint8_t n, SpcSample &out) const
+{
+    if (n >= historyCount)
+    {
+        return false;
     }
 
-    RECORD_ERROR(ERR_CALIPER_INVALID_DATA,
-        "Reliable measurement failed: no two consecutive identical readings within %u ms",
-        RELIABLE_MEASUREMENT_TIMEOUT_MS);
-    return INVALID_MEASUREMENT_VALUE;
+    out = history[(historyHead + CALIPER_HISTORY_SIZE - 1 - n) % CALIPER_HISTORY_SIZE];
+    return true;
+}
+
+bool CaliperInterface::isValidValue(float value)
+{
+    return value >= MEASUREMENT_MIN_VALUE && value <= MEASUREMENT_MAX_VALUE && !isnan(value) && !isinf(value);
 }
 
 #endif // defined(SPC)
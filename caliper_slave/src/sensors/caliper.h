@@ -10,6 +10,14 @@
  * using clock/data protocol with interrupt-based data capture.
  *
  * @version 2.0 - Integrated comprehensive error code system
+ * @version 2.1 - Register-level capture ISR with bit-packed 64-bit frame word
+ * @version 2.2 - Free-running capture mode with lock-free frame ring
+ * @version 2.3 - Optional SPI-slave DMA capture backend (SPC_CAPTURE_SPI)
+ * @version 2.4 - Reliable measurement via configurable consensus engine
+ * @version 2.5 - Edge-timing frame synchroniser with glitch rejection
+ * @version 2.6 - LengthSensor (CRTP) backend
+ * @version 2.7 - Capture ISR on falling edges only
+ * @version 2.8 - readLatest(valueMm, timestampUs) of the LengthSensor interface
  */
 
 #ifndef CALIPER_H
@@ -21,18 +29,78 @@
 #include "../config.h"
 #include <shared_common.h>
 #include <error_handler.h>
+#include <spsc_ring.h>
+#include "spc_decoder.h"
+#include "consensus.h"
+#include "spc_frame_sync.h"
+#include "length_sensor.h"
+#if defined(SPC_CAPTURE_SPI)
+#include "spc_spi_capture.h"
+#endif
 
-class CaliperInterface {
+/**
+ * @brief Decoded frame kept in the consumer-side history
+ */
+struct SpcSample {
+    float value;           /**< Measurement in millimeters */
+    uint32_t timestampUs;  /**< micros() when the frame completed */
+};
+
+class CaliperInterface : public LengthSensor<CaliperInterface> {
 private:
-    static volatile uint8_t bitBuffer[52];
-    static volatile int bitCount;
+    /**
+     * @brief Last completed frame, one bit per position (one-shot mode)
+     * @details Bit i holds the i-th bit shifted out by the caliper (LSB-first),
+     *          so no reversal pass is needed before decoding.
+     */
+    static volatile uint64_t frameWord;
     static volatile bool dataReady;
+
+    // Bit assembly, frame alignment and glitch rejection for clockISR
+    static SpcFrameSync frameSync;
+
+    // Free-running mode: ISR is the producer, the measurement task the consumer
+    static volatile bool continuousMode;
+    static volatile uint32_t droppedFrames;
+    static SpscRing<SpcRawFrame, CALIPER_FRAME_RING_SIZE> frameRing;
+
+#if defined(SPC_CAPTURE_SPI)
+    // Peripheral capture replaces clockISR/frameRing as the frame source
+    SpcSpiCapture spiCapture;
+#endif
+
+    // Consumer-side history of decoded frames (newest at historyHead - 1)
+    SpcSample history[CALIPER_HISTORY_SIZE] = {};
+    uint8_t historyHead = 0;
+    uint8_t historyCount = 0;
     
     static void IRAM_ATTR clockISR();
-    void reverseBits();
-    float decodeCaliper();
+    static bool isValidValue(float value);
+
+    /**
+     * @brief Move all queued frames from the ring into the decoded history
+     * @details Frames that decode out of range are dropped and logged.
+     */
+    void drainFrames();
+
+    /**
+     * @brief Get the n-th newest decoded frame (0 = newest)
+     * @return false if fewer than n + 1 frames are in the history
+     */
+    bool getHistory(uint8_t n, SpcSample &out) const;
+
+    float performOneShotMeasurement();
+
+    ConsensusConfig consensusConfig = CONSENSUS_DEFAULT_CONFIG;
+    ConsensusResult lastConsensus = {};
+
+#if defined(ENABLE_BENCHMARK)
+    friend void benchSpcCapture();
+#endif
     
 public:
+    static constexpr uint32_t CAPABILITIES = SENSOR_CAP_ONE_SHOT | SENSOR_CAP_RELIABLE | SENSOR_CAP_CONTINUOUS;
+
     /**
      * @brief Initialize caliper interface
      * @details Configures pins for clock, data, and trigger signals
@@ -42,7 +110,8 @@ public:
     /**
      * @brief Perform a measurement
      * @return Measured value in millimeters, or INVALID_MEASUREMENT_VALUE on error
-     * @details Triggers measurement, captures data via interrupt, and decodes result
+     * @details Triggers measurement, captures data via interrupt, and decodes result.
+     *          In free-running mode returns the first frame completed after the call.
      *
      * Possible errors:
      * - ERR_CALIPER_TIMEOUT: Measurement timeout after MEASUREMENT_TIMEOUT_MS
@@ -52,15 +121,68 @@ public:
     float performMeasurement();
     
     /**
-     * @brief Perform a reliable measurement with two consecutive identical readings
+     * @brief Perform a reliable measurement using the consensus engine
      * @return Measured value in millimeters, or INVALID_MEASUREMENT_VALUE on error
-     * @details Calls performMeasurement() repeatedly and accepts the result only
-     *          when two consecutive readings return the same value. Timeout:
-     *          RELIABLE_MEASUREMENT_TIMEOUT_MS (1s). If no two identical readings
-     *          are obtained within the timeout, returns INVALID_MEASUREMENT_VALUE
-     *          and records ERR_CALIPER_INVALID_DATA.
+     * @details Calls performMeasurement() repeatedly and feeds the readings into
+     *          a ConsensusEngine (see consensus.h) until its criterion is met.
+     *          The default criterion (CONSENSUS_DEFAULT_CONFIG) is two consecutive
+     *          identical readings. In free-running mode every call returns a new
+     *          frame, so the result is available after about k frame periods.
+     *          Timeout: consensus timeoutMs (RELIABLE_MEASUREMENT_TIMEOUT_MS by
+     *          default). Statistics are available from getLastConsensus().
+     *
+     * Possible errors:
+     * - ERR_CALIPER_INVALID_DATA: no consensus within the timeout
      */
     float performReliableMeasurement();
+
+    /**
+     * @brief Select the consensus strategy used by performReliableMeasurement()
+     */
+    void setConsensusConfig(const ConsensusConfig &config) { consensusConfig = config; }
+
+    /**
+     * @brief Statistics of the last performReliableMeasurement() call
+     */
+    const ConsensusResult &getLastConsensus() const { return lastConsensus; }
+
+    /**
+     * @brief Start free-running capture
+     * @details Attaches the ISR and holds TRIG low so the caliper keeps
+     *          sending frames. Every complete frame is pushed with a timestamp
+     *          into a lock-free SPSC ring; performMeasurement() and
+     *          performReliableMeasurement() then answer from the newest frames
+     *          instead of triggering the caliper for each read.
+     */
+    void startContinuous();
+
+    /**
+     * @brief Stop free-running capture and return to one-shot mode
+     */
+    void stopContinuous();
+
+    /**
+     * @brief Check if free-running capture is active
+     */
+    bool isContinuous() const { return continuousMode; }
+
+    /**
+     * @brief Get the newest decoded frame without waiting
+     * @param out Receives value and timestamp of the newest frame
+     * @return false if no frame has been received yet (or not in free-running mode)
+     */
+    bool readLatest(SpcSample &out);
+
+    /**
+     * @brief Newest position: newest frame when free-running, otherwise a
+     *        one-shot performMeasurement() stamped with micros()
+     */
+    bool readLatest(float &valueMm, uint32_t &timestampUs);
+
+    /**
+     * @brief Number of frames lost because the ring was full
+     */
+    uint32_t getDroppedFrames() const { return droppedFrames; }
     
     /**
      * @brief Check if measurement data is ready
@@ -0,0 +1,156 @@
+/**
+ * @file consensus.cpp
+ * @brief N-of-M consensus engine for reliable length measurements
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Default constructor and configure() for engine arrays
+ */
+
+#include "consensus.h"
+
+#include <algorithm>
+
+ConsensusEngine::ConsensusEngine(const ConsensusConfig &cfg)
+{
+    configure(cfg);
+}
+
+ConsensusEngine::ConsensusEngine()
+{
+    configure({ConsensusStrategy::K_OF_M, 2, 2, 0, 0.0f, RELIABLE_MEASUREMENT_TIMEOUT_MS});
+}
+
+void ConsensusEngine::configure(const ConsensusConfig &cfg)
+{
+    config = cfg;
+    if (config.m < 1) config.m = 1;
+    if (config.m > CONSENSUS_MAX_WINDOW) config.m = CONSENSUS_MAX_WINDOW;
+    if (config.k < 1) config.k = 1;
+    if (config.k > config.m) config.k = config.m;
+    if (2 * config.trim >= config.m) config.trim = (config.m - 1) / 2;
+    if (config.tolerance < 0.0f) config.tolerance = 0.0f;
+    reset();
+}
+
+void ConsensusEngine::reset()
+{
+    head = 0;
+    count = 0;
+    attemptCount = 0;
+    decidedValue = INVALID_MEASUREMENT_VALUE;
+    decidedSpread = 0.0f;
+}
+
+bool ConsensusEngine::add(float sample)
+{
+    attemptCount++;
+    if (sample == INVALID_MEASUREMENT_VALUE)
+    {
+        return false;
+    }
+
+    window[head] = sample;
+    head = (head + 1) % config.m;
+    if (count < config.m)
+    {
+        count++;
+    }
+
+    float sorted[CONSENSUS_MAX_WINDOW];
+    for (uint8_t i = 0; i < count; i++)
+    {
+        sorted[i] = window[i];
+    }
+    std::sort(sorted, sorted + count);
+
+    switch (config.strategy)
+    {
+    case ConsensusStrategy::MEDIAN:
+        return evaluateMedian(sorted);
+    case ConsensusStrategy::TRIMMED_MEAN:
+        return evaluateTrimmedMean(sorted);
+    case ConsensusStrategy::K_OF_M:
+    default:
+        return evaluateKOfM(sorted);
+    }
+}
+
+/**
+ * @details Sliding window over the sorted readings: the widest run whose
+ *          extremes differ by at most `tolerance` is the largest cluster.
+ *          Can succeed before the window is full (early exit).
+ */
+bool ConsensusEngine::evaluateKOfM(const float *sorted)
+{
+    uint8_t bestFirst = 0;
+    uint8_t bestSize = 0;
+    uint8_t first = 0;
+
+    for (uint8_t last = 0; last < count; last++)
+    {
+        while (sorted[last] - sorted[first] > config.tolerance)
+        {
+            first++;
+        }
+        if (last - first + 1 > bestSize)
+        {
+            bestFirst = first;
+            bestSize = last - first + 1;
+        }
+    }
+
+    if (bestSize < config.k)
+    {
+        return false;
+    }
+
+    decidedValue = sorted[bestFirst + bestSize / 2];
+    decidedSpread = sorted[bestFirst + bestSize - 1] - sorted[bestFirst];
+    return true;
+}
+
+bool ConsensusEngine::evaluateMedian(const float *sorted)
+{
+    if (count < config.m)
+    {
+        return false;
+    }
+
+    const float spread = sorted[count - 1] - sorted[0];
+    if (config.tolerance > 0.0f && spread > config.tolerance)
+    {
+        return false;
+    }
+
+    decidedValue = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0f;
+    decidedSpread = spread;
+    return true;
+}
+
+bool ConsensusEngine::evaluateTrimmedMean(const float *sorted)
+{
+    if (count < config.m)
+    {
+        return false;
+    }
+
+    const uint8_t first = config.trim;
+    const uint8_t last = count - 1 - config.trim;
+    const float spread = sorted[last] - sorted[first];
+    if (config.tolerance > 0.0f && spread > config.tolerance)
+    {
+        return false;
+    }
+
+    float sum = 0.0f;
+    for (uint8_t i = first; i <= last; i++)
+    {
+        sum += sorted[i];
+    }
+
+    decidedValue = sum / (last - first + 1);
+    decidedSpread = spread;
+    return true;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file consensus.h
+ * @brief N-of-M consensus engine for reliable length measurements
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Collects single readings from a sensor and decides when enough of them
+ * agree to report one value. Used by performReliableMeasurement() of every
+ * sensor backend (CaliperInterface, RS485Interface).
+ *
+ * Strategies (ConsensusStrategy):
+ * - K_OF_M: accept as soon as k of the last m valid readings lie within
+ *   `tolerance` of each other; value = median of that cluster.
+ *   k = 2, m = 2, tolerance = 0 reproduces the original "two consecutive
+ *   identical readings" rule.
+ * - MEDIAN: accept once m valid readings are collected; value = median.
+ * - TRIMMED_MEAN: accept once m valid readings are collected; the `trim`
+ *   lowest and highest are discarded, value = mean of the rest.
+ *
+ * For MEDIAN and TRIMMED_MEAN a tolerance > 0 additionally requires the
+ * spread of the used readings to be within tolerance; the window keeps
+ * sliding until it is (or the timeout expires).
+ *
+ * The engine itself has no Arduino dependency and builds on the host;
+ * time and readings are injected through runConsensus().
+ *
+ * @version 1.1 - Default constructor and configure() for engine arrays
+ */
+
+#ifndef CONSENSUS_H
+#define CONSENSUS_H
+
+#include <stdint.h>
+#include <shared_config.h>
+
+/**
+ * @brief Maximum window size m supported by ConsensusEngine
+ */
+#define CONSENSUS_MAX_WINDOW 16
+
+enum class ConsensusStrategy : uint8_t {
+    K_OF_M = 0,
+    MEDIAN = 1,
+    TRIMMED_MEAN = 2
+};
+
+struct ConsensusConfig {
+    ConsensusStrategy strategy;
+    uint8_t k;            /**< Agreeing readings required (K_OF_M) */
+    uint8_t m;            /**< Window size, 1..CONSENSUS_MAX_WINDOW */
+    uint8_t trim;         /**< Readings dropped on each side (TRIMMED_MEAN) */
+    float tolerance;      /**< Max spread in mm (0 = exact / not checked) */
+    uint32_t timeoutMs;   /**< Upper bound for the whole acquisition */
+};
+
+struct ConsensusResult {
+    float value;          /**< Agreed value in mm, INVALID_MEASUREMENT_VALUE on failure */
+    uint16_t attempts;    /**< Readings taken, including invalid ones */
+    float spread;         /**< max - min of the readings the value is based on */
+    uint32_t elapsedMs;   /**< Time from start to decision */
+    bool ok;              /**< true if the criterion was met before the timeout */
+};
+
+class ConsensusEngine {
+public:
+    explicit ConsensusEngine(const ConsensusConfig &config);
+
+    /**
+     * @brief Engine with the two-identical-readings rule; call configure()
+     *        to select another strategy (e.g. for arrays of engines)
+     */
+    ConsensusEngine();
+
+    /**
+     * @brief Replace the strategy and limits and discard all readings
+     */
+    void configure(const ConsensusConfig &config);
+
+    /**
+     * @brief Discard all readings and statistics
+     */
+    void reset();
+
+    /**
+     * @brief Add one reading and evaluate the criterion
+     * @param sample Reading in mm; INVALID_MEASUREMENT_VALUE counts as an
+     *               attempt but is not added to the window
+     * @return true as soon as the criterion is met (value() is then valid)
+     */
+    bool add(float sample);
+
+    float value() const { return decidedValue; }
+    float spread() const { return decidedSpread; }
+    uint16_t attempts() const { return attemptCount; }
+
+private:
+    ConsensusConfig config;
+    float window[CONSENSUS_MAX_WINDOW];
+    uint8_t head = 0;
+    uint8_t count = 0;
+    uint16_t attemptCount = 0;
+    float decidedValue = INVALID_MEASUREMENT_VALUE;
+    float decidedSpread = 0.0f;
+
+    bool evaluateKOfM(const float *sorted);
+    bool evaluateMedian(const float *sorted);
+    bool evaluateTrimmedMean(const float *sorted);
+};
+
+/**
+ * @brief Take readings until the engine reaches consensus or time runs out
+ * @param config Strategy and limits
+ * @param read Callable returning one reading in mm (or INVALID_MEASUREMENT_VALUE)
+ * @param nowMs Callable returning a millisecond clock
+ * @return Result with statistics; ok == false on timeout
+ */
+template <typename ReadFn, typename ClockFn>
+ConsensusResult runConsensus(const ConsensusConfig &config, ReadFn &&read, ClockFn &&nowMs)
+{
+    ConsensusEngine engine(config);
+    const uint32_t start = nowMs();
+    bool ok = false;
+
+    while ((uint32_t)(nowMs() - start) < config.timeoutMs)
+    {
+        if (engine.add(read()))
+        {
+            ok = true;
+            break;
+        }
+    }
+
+    ConsensusResult result;
+    result.value = ok ? engine.value() : INVALID_MEASUREMENT_VALUE;
+    result.attempts = engine.attempts();
+    result.spread = engine.spread();
+    result.elapsedMs = (uint32_t)(nowMs() - start);
+    result.ok = ok;
+    return result;
+}
+
+#endif // CONSENSUS_H
@@ -0,0 +1,133 @@
+/**
+ * @file length_sensor.h
+ * @brief Compile-time interface shared by all length sensor backends
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Every backend (CaliperInterface, RS485Interface, SimulatedSensor) derives
+ * from LengthSensor<Backend> (CRTP) and provides:
+ * - void begin()
+ * - float performMeasurement()          one-shot read, mm or INVALID_MEASUREMENT_VALUE
+ * - float performReliableMeasurement()  consensus read, mm or INVALID_MEASUREMENT_VALUE
+ * - bool readLatest(float &valueMm, uint32_t &timestampUs)
+ *                                       newest position and its capture time (newest
+ *                                       streamed frame, otherwise a one-shot read)
+ * - static constexpr uint32_t CAPABILITIES  (SensorCapability bit mask)
+ *
+ * The base class forwards to the backend with a static_cast, so there is no
+ * vtable and every call resolves at compile time. Missing or mistyped
+ * members are reported by static_assert instead of by an unrelated error
+ * somewhere in main.cpp.
+ *
+ * Optional features have no-op defaults here (e.g. startContinuous()), so
+ * code guarded by hasCapability() compiles for every backend.
+ *
+ * No Arduino dependency; builds on the host.
+ *
+ * @version 1.0 - Initial implementation
+ * @version 1.1 - readLatest(valueMm, timestampUs) for every backend
+ */
+
+#ifndef LENGTH_SENSOR_H
+#define LENGTH_SENSOR_H
+
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Capability bits reported by LengthSensor::CAPABILITIES
+ */
+enum SensorCapability : uint32_t {
+    SENSOR_CAP_ONE_SHOT   = 1u << 0, /**< performMeasurement() triggers a fresh reading */
+    SENSOR_CAP_RELIABLE   = 1u << 1, /**< performReliableMeasurement() uses the consensus engine */
+    SENSOR_CAP_CONTINUOUS = 1u << 2, /**< startContinuous()/stopContinuous() are implemented */
+    SENSOR_CAP_SIMULATED  = 1u << 3  /**< No hardware attached (SimulatedSensor) */
+};
+
+template <typename Derived>
+class LengthSensor;
+
+/**
+ * @brief Class declaring the readLatest(float &, uint32_t &) that S resolves to
+ * @details The backend also has a sample-type readLatest() overload, so the
+ *          member pointer type alone cannot be compared as for the others.
+ */
+template <typename C>
+constexpr C *readLatestOwner(bool (C::*)(float &, uint32_t &)) { return nullptr; }
+
+/**
+ * @brief Compile-time check that S is a complete LengthSensor backend
+ * @details A member the backend does not declare resolves to the base
+ *          class version, whose type differs, so the check fails cleanly.
+ */
+template <typename S>
+constexpr bool isLengthSensor()
+{
+    return std::is_base_of<LengthSensor<S>, S>::value
+        && std::is_same<decltype(&S::begin), void (S::*)()>::value
+        && std::is_same<decltype(&S::performMeasurement), float (S::*)()>::value
+        && std::is_same<decltype(&S::performReliableMeasurement), float (S::*)()>::value
+        && std::is_same<decltype(readLatestOwner(&S::readLatest)), S *>::value
+        && std::is_same<decltype(S::CAPABILITIES), const uint32_t>::value;
+}
+
+template <typename Derived>
+class LengthSensor {
+public:
+    /**
+     * @brief Check capability bits of the backend at compile time
+     */
+    static constexpr bool hasCapability(uint32_t caps)
+    {
+        return (Derived::CAPABILITIES & caps) == caps;
+    }
+
+    void begin()
+    {
+        static_assert(isLengthSensor<Derived>(), "incomplete LengthSensor backend");
+        self().begin();
+    }
+
+    float performMeasurement()
+    {
+        static_assert(isLengthSensor<Derived>(), "incomplete LengthSensor backend");
+        return self().performMeasurement();
+    }
+
+    float performReliableMeasurement()
+    {
+        static_assert(isLengthSensor<Derived>(), "incomplete LengthSensor backend");
+        return self().performReliableMeasurement();
+    }
+
+    /**
+     * @brief Newest position with its capture time, without waiting for a
+     *        frame when the backend streams
+     * @param valueMm Position in mm, or INVALID_MEASUREMENT_VALUE
+     * @param timestampUs micros() when the position was captured; unique per
+     *        frame, so callers polling faster than the sensor can de-duplicate
+     * @return false if streaming and no frame has arrived yet
+     */
+    bool readLatest(float &valueMm, uint32_t &timestampUs)
+    {
+        static_assert(isLengthSensor<Derived>(), "incomplete LengthSensor backend");
+        return self().readLatest(valueMm, timestampUs);
+    }
+
+    /**
+     * @brief Defaults for backends without SENSOR_CAP_CONTINUOUS
+     */
+    void startContinuous() {}
+    void stopContinuous() {}
+    bool isContinuous() const { return false; }
+
+protected:
+    LengthSensor() = default;
+
+private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+};
+
+#endif // LENGTH_SENSOR_H
@@ -0,0 +1,101 @@
+/**
+ * @file p12d_parser.cpp
+ * @brief Streaming fixed-point parser for S_Probe P12D ASCII positions
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ */
+
+#include "p12d_parser.h"
+
+// ============================================================================
+// Golden vectors (checked at compile time)
+// ============================================================================
+
+namespace {
+
+struct ParseOutcome {
+    P12dParseStatus status;
+    int32_t micrometers;
+    P12dParseError error;
+};
+
+/**
+ * @brief Feed a NUL-terminated string and return the first non-PENDING
+ *        status (or the result of finish() if the input runs out)
+ */
+constexpr ParseOutcome parse(const char *text)
+{
+    P12dParser parser;
+    for (; *text != '\0'; text++)
+    {
+        const P12dParseStatus status = parser.feed(*text);
+        if (status != P12dParseStatus::PENDING)
+        {
+            return {status, parser.micrometers(), parser.error()};
+        }
+    }
+    const P12dParseStatus status = parser.finish();
+    return {status, parser.micrometers(), parser.error()};
+}
+
+constexpr bool parsesTo(const char *text, int32_t micrometers)
+{
+    const ParseOutcome r = parse(text);
+    return r.status == P12dParseStatus::VALUE && r.micrometers == micrometers;
+}
+
+constexpr bool rejected(const char *text, P12dParseError error)
+{
+    const ParseOutcome r = parse(text);
+    return r.status == P12dParseStatus::INVALID && r.error == error;
+}
+
+static_assert(parsesTo("0\r", 0), "zero");
+static_assert(parsesTo("12.345\r", 12345), "mm, three decimals");
+static_assert(parsesTo("+12.345\r", 12345), "explicit plus");
+static_assert(parsesTo("-0.001\r", -1), "negative, 1 µm");
+static_assert(parsesTo("  -7.5 mm  \r", -7500), "spaces and unit");
+static_assert(parsesTo("7.5mm\n", 7500), "unit without space, LF");
+static_assert(parsesTo("12.3454\r", 12345), "sub-µm rounded down");
+static_assert(parsesTo("12.3455\r", 12346), "sub-µm half rounded up");
+static_assert(parsesTo("-12.3455\r", -12346), "rounding is symmetric");
+static_assert(parsesTo("999999.999999\r", 1000000000), "full scale mm");
+static_assert(parsesTo("1.000 in\r", 25400), "inch");
+static_assert(parsesTo("-0.50000in\r", -12700), "negative inch");
+static_assert(parsesTo("0.00001 in\r", 0), "10 µin rounds to 0 µm");
+static_assert(parsesTo("0.00002in\r", 1), "20 µin rounds to 1 µm");
+static_assert(parsesTo("12.345", 12345), "no terminator (finish)");
+static_assert(parsesTo("\r\r  \r12.345\r", 12345), "blank lines are skipped");
+static_assert(parse("\r").status == P12dParseStatus::PENDING, "empty line is not an error");
+static_assert(rejected("abc\r", P12dParseError::SYNTAX), "text");
+static_assert(rejected("-\r", P12dParseError::SYNTAX), "sign only");
+static_assert(rejected("12.\r", P12dParseError::SYNTAX), "point without decimals");
+static_assert(rejected(".5\r", P12dParseError::SYNTAX), "no integer digit");
+static_assert(rejected("1.2.3\r", P12dParseError::SYNTAX), "two points");
+static_assert(rejected("1e3\r", P12dParseError::SYNTAX), "exponent");
+static_assert(rejected("+-1\r", P12dParseError::SYNTAX), "two signs");
+static_assert(rejected("12.345 m\r", P12dParseError::SYNTAX), "truncated unit");
+static_assert(rejected("12.345 mm x\r", P12dParseError::SYNTAX), "garbage after unit");
+static_assert(rejected("12.345 cm\r", P12dParseError::SYNTAX), "unknown unit");
+static_assert(rejected("1234567\r", P12dParseError::TOO_LONG), "too many integer digits");
+static_assert(rejected("1.1234567\r", P12dParseError::TOO_LONG), "too many decimals");
+static_assert(rejected("999999 in\r", P12dParseError::OUT_OF_RANGE), "inch overflow");
+
+} // namespace
+
+const char *p12dParseErrorString(P12dParseError error)
+{
+    switch (error)
+    {
+    case P12dParseError::NONE:
+        return "none";
+    case P12dParseError::SYNTAX:
+        return "syntax";
+    case P12dParseError::TOO_LONG:
+        return "too many digits";
+    case P12dParseError::OUT_OF_RANGE:
+        return "out of range";
+    }
+    return "unknown";
+}
@@ -0,0 +1,296 @@
+/**
+ * @file p12d_parser.h
+ * @brief Streaming fixed-point parser for S_Probe P12D ASCII positions
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Consumes the probe output one byte at a time, as it comes out of the UART,
+ * and yields the position as an exact int32_t micrometre value. No line
+ * buffer, no allocation and no libc float parsing (strtof is locale
+ * dependent and comparatively slow).
+ *
+ * Accepted line (terminated by CR or LF):
+ *
+ *     [spaces] [+|-] digits [. digits] [spaces] [mm|in] [spaces]
+ *
+ * - 1..P12D_MAX_INT_DIGITS integer digits, 1..P12D_MAX_FRAC_DIGITS decimals
+ *   after the point (a point must be followed by at least one digit)
+ * - no unit means millimetres; "in" values are converted (1 in = 25400 µm)
+ * - digits beyond the micrometre are rounded half away from zero
+ * - empty or blank lines are skipped silently
+ * - anything else makes the whole line invalid; the error is reported when
+ *   its terminator arrives, so the parser is always aligned to lines
+ *
+ * All methods are constexpr, so the golden vectors in p12d_parser.cpp are
+ * checked at compile time. No Arduino dependency; builds on the host.
+ */
+
+#ifndef P12D_PARSER_H
+#define P12D_PARSER_H
+
+#include <stdint.h>
+
+#define P12D_MAX_INT_DIGITS 6   // 999999 mm / in
+#define P12D_MAX_FRAC_DIGITS 6  // 1 nm / 1 µin resolution before rounding
+
+/**
+ * @brief Result of feeding one byte
+ */
+enum class P12dParseStatus : uint8_t {
+    PENDING, /**< Line not finished yet (or blank line skipped) */
+    VALUE,   /**< Line finished with a valid value, see micrometers() */
+    INVALID  /**< Line finished but invalid, see error() */
+};
+
+/**
+ * @brief Reason of the last INVALID status
+ */
+enum class P12dParseError : uint8_t {
+    NONE,
+    SYNTAX,     /**< Unexpected character or missing digits */
+    TOO_LONG,   /**< More digits than P12D_MAX_INT_DIGITS / P12D_MAX_FRAC_DIGITS */
+    OUT_OF_RANGE /**< Value does not fit int32_t micrometres */
+};
+
+const char *p12dParseErrorString(P12dParseError error);
+
+class P12dParser {
+public:
+    constexpr P12dParser() = default;
+
+    /**
+     * @brief Start a new line
+     */
+    constexpr void reset()
+    {
+        state = State::LEADING;
+        negative = false;
+        inch = false;
+        intDigits = 0;
+        fracDigits = 0;
+        mantissa = 0;
+    }
+
+    /**
+     * @brief Discard input up to and including the next terminator without
+     *        reporting it (e.g. output joined in the middle of a line)
+     */
+    constexpr void skipLine()
+    {
+        reset();
+        state = State::SKIP;
+    }
+
+    /**
+     * @brief Consume one byte
+     * @return VALUE or INVALID on a line terminator, PENDING otherwise
+     */
+    constexpr P12dParseStatus feed(char c)
+    {
+        if (c == '\r' || c == '\n')
+        {
+            return finish();
+        }
+
+        switch (state)
+        {
+        case State::LEADING:
+            if (c == ' ') return P12dParseStatus::PENDING;
+            if (c == '+' || c == '-')
+            {
+                negative = (c == '-');
+                state = State::SIGN;
+                return P12dParseStatus::PENDING;
+            }
+            [[fallthrough]];
+        case State::SIGN:
+        case State::INT:
+            if (isDigit(c))
+            {
+                if (intDigits == P12D_MAX_INT_DIGITS) return fail(P12dParseError::TOO_LONG);
+                mantissa = mantissa * 10 + (c - '0');
+                intDigits++;
+                state = State::INT;
+                return P12dParseStatus::PENDING;
+            }
+            if (state == State::INT) return afterNumber(c);
+            return fail(P12dParseError::SYNTAX);
+
+        case State::POINT:
+        case State::FRAC:
+            if (isDigit(c))
+            {
+                if (fracDigits == P12D_MAX_FRAC_DIGITS) return fail(P12dParseError::TOO_LONG);
+                mantissa = mantissa * 10 + (c - '0');
+                fracDigits++;
+                state = State::FRAC;
+                return P12dParseStatus::PENDING;
+            }
+            if (state == State::FRAC) return afterNumber(c);
+            return fail(P12dParseError::SYNTAX);
+
+        case State::UNIT_SPACE:
+            if (c == ' ') return P12dParseStatus::PENDING;
+            return unitStart(c);
+
+        case State::UNIT_M:
+            if (c != 'm') return fail(P12dParseError::SYNTAX);
+            state = State::TRAILING;
+            return P12dParseStatus::PENDING;
+
+        case State::UNIT_N:
+            if (c != 'n') return fail(P12dParseError::SYNTAX);
+            inch = true;
+            state = State::TRAILING;
+            return P12dParseStatus::PENDING;
+
+        case State::TRAILING:
+            if (c == ' ') return P12dParseStatus::PENDING;
+            return fail(P12dParseError::SYNTAX);
+
+        case State::FAILED:
+        case State::SKIP:
+            return P12dParseStatus::PENDING;
+        }
+        return P12dParseStatus::PENDING;
+    }
+
+    /**
+     * @brief End the current line without a terminator (e.g. receive timeout)
+     * @return Same as feeding a terminator; the parser is reset either way
+     *         (micrometers() / error() keep the result)
+     */
+    constexpr P12dParseStatus finish()
+    {
+        const State last = state;
+        const bool blank = (last == State::LEADING || last == State::SKIP);
+        P12dParseStatus status = P12dParseStatus::PENDING;
+
+        if (last == State::FAILED)
+        {
+            status = P12dParseStatus::INVALID;
+        }
+        else if (!blank)
+        {
+            const bool incomplete = (last == State::SIGN || last == State::POINT
+                || last == State::UNIT_M || last == State::UNIT_N);
+            status = incomplete ? setError(P12dParseError::SYNTAX) : convert();
+        }
+
+        reset();
+        return status;
+    }
+
+    /**
+     * @brief true between lines (nothing of the current line consumed yet)
+     */
+    constexpr bool idle() const { return state == State::LEADING; }
+
+    /**
+     * @brief Value of the last VALUE status in micrometres
+     */
+    constexpr int32_t micrometers() const { return value; }
+
+    /**
+     * @brief Reason of the last INVALID status
+     */
+    constexpr P12dParseError error() const { return lastError; }
+
+private:
+    enum class State : uint8_t {
+        LEADING,    /**< Spaces before the number */
+        SIGN,       /**< After '+' / '-' */
+        INT,        /**< Integer digits */
+        POINT,      /**< After '.', digit required */
+        FRAC,       /**< Decimal digits */
+        UNIT_SPACE, /**< Spaces between number and unit */
+        UNIT_M,     /**< After 'm', expecting 'm' */
+        UNIT_N,     /**< After 'i', expecting 'n' */
+        TRAILING,   /**< Spaces after the unit */
+        FAILED,     /**< Invalid line, waiting for its terminator */
+        SKIP        /**< Discarded line, waiting for its terminator */
+    };
+
+    State state = State::LEADING;
+    bool negative = false;
+    bool inch = false;
+    uint8_t intDigits = 0;
+    uint8_t fracDigits = 0;
+    int64_t mantissa = 0;
+    int32_t value = 0;
+    P12dParseError lastError = P12dParseError::NONE;
+
+    static constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    constexpr P12dParseStatus afterNumber(char c)
+    {
+        if (c == '.' && state == State::INT)
+        {
+            state = State::POINT;
+            return P12dParseStatus::PENDING;
+        }
+        if (c == ' ')
+        {
+            state = State::UNIT_SPACE;
+            return P12dParseStatus::PENDING;
+        }
+        return unitStart(c);
+    }
+
+    constexpr P12dParseStatus unitStart(char c)
+    {
+        if (c == 'm')
+        {
+            state = State::UNIT_M;
+            return P12dParseStatus::PENDING;
+        }
+        if (c == 'i')
+        {
+            state = State::UNIT_N;
+            return P12dParseStatus::PENDING;
+        }
+        return fail(P12dParseError::SYNTAX);
+    }
+
+    constexpr P12dParseStatus fail(P12dParseError error)
+    {
+        lastError = error;
+        state = State::FAILED;
+        return P12dParseStatus::PENDING;
+    }
+
+    constexpr P12dParseStatus setError(P12dParseError error)
+    {
+        lastError = error;
+        return P12dParseStatus::INVALID;
+    }
+
+    /**
+     * @brief Scale the digits to micrometres with rounding
+     */
+    constexpr P12dParseStatus convert()
+    {
+        // mantissa * 10^(6 - fracDigits) = value in 1e-6 units (mm or in)
+        int64_t scaled = mantissa;
+        for (uint8_t i = fracDigits; i < P12D_MAX_FRAC_DIGITS; i++)
+        {
+            scaled *= 10;
+        }
+
+        const int64_t um = inch
+            ? (scaled * 254 + 5000) / 10000 // 1e-6 in -> µm: x 25400 / 1e6
+            : (scaled + 500) / 1000;       // 1e-6 mm (nm) -> µm
+        if (um > INT32_MAX)
+        {
+            return setError(P12dParseError::OUT_OF_RANGE);
+        }
+
+        value = negative ? -(int32_t)um : (int32_t)um;
+        lastError = P12dParseError::NONE;
+        return P12dParseStatus::VALUE;
+    }
+};
+
+#endif // P12D_PARSER_H
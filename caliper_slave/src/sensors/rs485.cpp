@@ -12,6 +12,17 @@
  * full specification.
  *
  * @version 1.0 - Initial implementation for RS485 ASCII interface
+ * @version 1.1 - Reliable measurement via configurable consensus engine
+ * @version 1.2 - LengthSensor (CRTP) backend
+ * @version 1.3 - Event-driven reception (UART onReceive + task notification), latency histogram
+ * @version 1.4 - Optional UART hardware RS485 half-duplex direction control
+ * @version 1.5 - Continuous-output streaming mode with a ring of the newest positions
+ * @version 1.6 - Fixed-point streaming parser (P12dParser) instead of line buffer + strtof
+ * @version 1.7 - Multi-drop bus: addressed probes, pipelined round-robin polling
+ * @version 1.8 - Streaming start: the partial line is skipped by the parser owner (UART task)
+ * @version 1.9 - Parser guarded by parserMux (timeout path of readResponse())
+ * @version 2.0 - Poll cycle: guard window after a channel timeout drops late replies
+ * @version 2.1 - readLatest(valueMm, timestampUs) of the LengthSensor interface
  */
 
 #if defined(RS485)
@@ -20,7 +31,11 @@
 
 #include <MacroDebugger.h>
 #include <error_handler.h>
-#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Duration of one 8N1 character on the wire
+static constexpr uint32_t RS485_CHAR_TIME_US = 10UL * 1000000UL / RS485_BAUD_RATE;
 
 void RS485Interface::setTransmitMode()
 {
@@ -34,10 +49,28 @@ void RS485Interface::setReceiveMode()
 
 bool RS485Interface::sendQuery()
 {
+#if RS485_PROBE_COUNT > 1
+    return sendAddressedQuery(0);
+#else
+    const char query[] = {RS485_QUERY_CHAR, '\0'};
+    return sendCommand(query);
+#endif
+}
+
+bool RS485Interface::sendCommand(const char *command)
+{
+    const size_t length = strlen(command);
+
+    if (hardwareDirection)
+    {
+        bool ok = Serial1.write((const uint8_t *)command, length) == length;
+        return Serial1.write((uint8_t)RS485_CR) == 1 && ok;
+    }
+
     setTransmitMode();
 
-    Serial1.write(RS485_QUERY_CHAR);
-    Serial1.write(RS485_CR);
+    Serial1.write((const uint8_t *)command, length);
+    Serial1.write((uint8_t)RS485_CR);
     Serial1.flush();
 
     // Guard delay (~1 char time at 115200 Bd ~= 87 us) to ensure the last
@@ -48,63 +81,526 @@ bool RS485Interface::sendQuery()
     return true;
 }
 
-float RS485Interface::readResponse()
+void RS485Interface::configureDirection(bool hardware)
 {
-    char buffer[RS485_RESPONSE_BUFFER_SIZE];
-    size_t index = 0;
+    if (hardware)
+    {
+        Serial1.setPins(-1, -1, -1, RS485_DE_RE_PIN);
+        hardwareDirection = Serial1.setMode(UART_MODE_RS485_HALF_DUPLEX);
+        if (!hardwareDirection)
+        {
+            LOG_WARNING(ERR_RS485_INIT_FAILED, "RS485 half-duplex mode unavailable, using GPIO direction control");
+        }
+    }
+    else
+    {
+        Serial1.setMode(UART_MODE_UART);
+        hardwareDirection = false;
+    }
 
-    unsigned long startTime = millis();
-    while (millis() - startTime < RS485_RESPONSE_TIMEOUT_MS)
+    if (!hardwareDirection)
+    {
+        pinMode(RS485_DE_RE_PIN, OUTPUT);
+        setReceiveMode();
+    }
+}
+
+P12dParser RS485Interface::parser;
+volatile bool RS485Interface::lineComplete = false;
+volatile P12dParseStatus RS485Interface::responseStatus = P12dParseStatus::PENDING;
+volatile int32_t RS485Interface::responseUm = 0;
+volatile P12dParseError RS485Interface::responseError = P12dParseError::NONE;
+volatile TaskHandle_t RS485Interface::waitingTask = nullptr;
+volatile bool RS485Interface::parserResync = false;
+volatile bool RS485Interface::parserSkipLine = false;
+portMUX_TYPE RS485Interface::parserMux = portMUX_INITIALIZER_UNLOCKED;
+
+portMUX_TYPE RS485Interface::pollMux = portMUX_INITIALIZER_UNLOCKED;
+RS485Interface *RS485Interface::pollOwner = nullptr;
+volatile bool RS485Interface::pollActive = false;
+volatile bool RS485Interface::pollGuard = false;
+uint8_t RS485Interface::pollQueue[RS485_MAX_PROBES];
+uint8_t RS485Interface::pollQueueLength = 0;
+volatile uint8_t RS485Interface::pollIndex = 0;
+Rs485ChannelReading RS485Interface::pollResults[RS485_MAX_PROBES];
+
+volatile bool RS485Interface::streaming = false;
+OverwriteRing<Rs485Sample, RS485_STREAM_RING_SIZE> RS485Interface::streamRing;
+volatile uint32_t RS485Interface::streamErrors = 0;
+
+bool RS485Interface::isValidMicrometers(int32_t micrometers)
+{
+    static constexpr int32_t MIN_UM = (int32_t)(MEASUREMENT_MIN_VALUE * CALIPER_VALUE_DIVISOR);
+    static constexpr int32_t MAX_UM = (int32_t)(MEASUREMENT_MAX_VALUE * CALIPER_VALUE_DIVISOR);
+    return micrometers >= MIN_UM && micrometers <= MAX_UM;
+}
+
+void RS485Interface::onUartReceive()
+{
+    uint8_t chunk[RS485_RESPONSE_BUFFER_SIZE];
+    size_t available;
+
+    portENTER_CRITICAL(&parserMux);
+    if (parserResync)
+    {
+        parserResync = false;
+        parser.reset(); // Drop a partial reply of a channel that timed out
+    }
+    if (parserSkipLine)
     {
-        while (Serial1.available())
+        parserSkipLine = false;
+        parser.skipLine(); // Streamed output may start in the middle of a line
+    }
+    portEXIT_CRITICAL(&parserMux);
+
+    while ((available = Serial1.available()) > 0)
+    {
+        const size_t length = Serial1.read(chunk, available < sizeof(chunk) ? available : sizeof(chunk));
+        if (length == 0)
         {
-            char c = (char)Serial1.read();
+            break;
+        }
 
-            if (c == RS485_CR || c == '\n')
+        const uint32_t nowUs = micros();
+        for (size_t i = 0; i < length; i++)
+        {
+            portENTER_CRITICAL(&parserMux);
+            const P12dParseStatus status = parser.feed((char)chunk[i]);
+            const int32_t micrometers = parser.micrometers();
+            const P12dParseError error = parser.error();
+            portEXIT_CRITICAL(&parserMux);
+
+            if (status == P12dParseStatus::PENDING)
             {
-                buffer[index] = '\0';
-                if (index > 0)
-                {
-                    char *endPtr = nullptr;
-                    float value = strtof(buffer, &endPtr);
-                    if (endPtr != buffer)
-                    {
-                        return value;
-                    }
-                    else
-                    {
-                        RECORD_ERROR(ERR_RS485_INVALID_RESPONSE, "Unparseable response: '%s'", buffer);
-                        return INVALID_MEASUREMENT_VALUE;
-                    }
-                }
-                // Empty line before terminator - keep waiting
+                continue;
             }
-            else if (index < RS485_RESPONSE_BUFFER_SIZE - 1)
+
+            // Bytes after the terminator were still on the wire at that time
+            onLine(status, micrometers, error, nowUs - (uint32_t)(length - 1 - i) * RS485_CHAR_TIME_US);
+        }
+    }
+}
+
+void RS485Interface::onLine(P12dParseStatus status, int32_t micrometers, P12dParseError error, uint32_t timestampUs)
+{
+    if (pollActive)
+    {
+        onPollLine(status, micrometers);
+        return;
+    }
+
+    if (streaming)
+    {
+        if (status != P12dParseStatus::VALUE || !isValidMicrometers(micrometers))
+        {
+            streamErrors = streamErrors + 1;
+            return;
+        }
+        streamRing.push({micrometers, timestampUs});
+    }
+    else
+    {
+        // Same lock as the timeout path of readResponse(): exactly one of
+        // them completes the pending read
+        portENTER_CRITICAL(&parserMux);
+        const bool pending = !lineComplete;
+        if (pending)
+        {
+            responseUm = micrometers;
+            responseError = error;
+            responseStatus = status;
+            lineComplete = true;
+        }
+        portEXIT_CRITICAL(&parserMux);
+
+        if (!pending)
+        {
+            return; // Lines after the reply belong to no pending read
+        }
+    }
+
+    TaskHandle_t task = waitingTask;
+    if (task != nullptr)
+    {
+        xTaskNotifyGive(task);
+    }
+}
+
+int RS485Interface::advancePoll()
+{
+    int next = -1;
+
+    portENTER_CRITICAL(&pollMux);
+    if (pollActive)
+    {
+        pollIndex = pollIndex + 1;
+        if (pollIndex < pollQueueLength)
+        {
+            next = pollQueue[pollIndex];
+        }
+        else
+        {
+            pollActive = false;
+        }
+    }
+    portEXIT_CRITICAL(&pollMux);
+
+    return next;
+}
+
+void RS485Interface::onPollLine(P12dParseStatus status, int32_t micrometers)
+{
+    portENTER_CRITICAL(&pollMux);
+    const bool active = pollActive && !pollGuard;
+    if (active)
+    {
+        Rs485ChannelReading &reading = pollResults[pollQueue[pollIndex]];
+        reading.micrometers = micrometers;
+        if (status != P12dParseStatus::VALUE)
+        {
+            reading.status = CHANNEL_INVALID;
+        }
+        else
+        {
+            reading.status = isValidMicrometers(reading.micrometers) ? CHANNEL_OK : CHANNEL_OUT_OF_RANGE;
+        }
+    }
+    portEXIT_CRITICAL(&pollMux);
+
+    if (!active)
+    {
+        return;
+    }
+
+    // Pipelining: the next probe is queried before the measurement task runs
+    const int next = advancePoll();
+    if (next >= 0)
+    {
+        pollOwner->sendAddressedQuery((uint8_t)next);
+    }
+
+    TaskHandle_t task = waitingTask;
+    if (task != nullptr)
+    {
+        xTaskNotifyGive(task);
+    }
+}
+
+bool RS485Interface::sendAddressedQuery(uint8_t channel)
+{
+    static constexpr uint8_t addresses[RS485_MAX_PROBES] = RS485_PROBE_ADDRESSES;
+
+    char command[16];
+    snprintf(command, sizeof(command), RS485_ADDRESSED_QUERY_FORMAT, (unsigned)addresses[channel]);
+    return sendCommand(command);
+}
+
+uint8_t RS485Interface::pollCycle(const bool *pending)
+{
+    pollQueueLength = 0;
+    for (uint8_t ch = 0; ch < RS485_PROBE_COUNT; ch++)
+    {
+        if (pending[ch])
+        {
+            pollQueue[pollQueueLength++] = ch;
+            pollResults[ch] = {0, CHANNEL_TIMEOUT};
+        }
+    }
+    if (pollQueueLength == 0)
+    {
+        return 0;
+    }
+
+    pollOwner = this;
+    pollIndex = 0;
+    waitingTask = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0);
+    parserResync = true;
+    pollActive = true;
+    sendAddressedQuery(pollQueue[0]);
+
+    const TickType_t timeout = pdMS_TO_TICKS(RS485_RESPONSE_TIMEOUT_MS);
+    while (pollActive)
+    {
+        if (ulTaskNotifyTake(pdTRUE, timeout) > 0)
+        {
+            continue; // A reply arrived; the next query is already out
+        }
+
+        // Current channel stayed silent (status stays CHANNEL_TIMEOUT). Its
+        // reply may still be on the way: drop whatever arrives during the
+        // guard window, so it is not stored as the next channel's value
+        portENTER_CRITICAL(&pollMux);
+        pollGuard = true;
+        portEXIT_CRITICAL(&pollMux);
+        parserResync = true;
+        vTaskDelay(pdMS_TO_TICKS(RS485_POLL_GUARD_MS));
+
+        portENTER_CRITICAL(&parserMux);
+        if (parserResync)
+        {
+            parserResync = false;
+            parser.reset(); // Nothing arrived in the window
+        }
+        else if (!parser.idle())
+        {
+            parser.skipLine(); // Late reply still arriving: drop its tail
+        }
+        portEXIT_CRITICAL(&parserMux);
+
+        portENTER_CRITICAL(&pollMux);
+        pollGuard = false;
+        portEXIT_CRITICAL(&pollMux);
+        ulTaskNotifyTake(pdTRUE, 0);
+
+        const int next = advancePoll();
+        if (next >= 0)
+        {
+            sendAddressedQuery((uint8_t)next);
+        }
+    }
+    waitingTask = nullptr;
+
+    return pollQueueLength;
+}
+
+uint8_t RS485Interface::performMultiMeasurement(float *values, uint8_t *status)
+{
+    ConsensusEngine engines[RS485_PROBE_COUNT];
+    bool pending[RS485_PROBE_COUNT];
+    ChannelStatus lastStatus[RS485_PROBE_COUNT];
+
+    for (uint8_t ch = 0; ch < RS485_MAX_PROBES; ch++)
+    {
+        values[ch] = INVALID_MEASUREMENT_VALUE;
+        status[ch] = CHANNEL_DISABLED;
+    }
+    for (uint8_t ch = 0; ch < RS485_PROBE_COUNT; ch++)
+    {
+        engines[ch].configure(consensusConfig);
+        pending[ch] = true;
+        lastStatus[ch] = CHANNEL_TIMEOUT;
+    }
+
+    const uint32_t startMs = millis();
+    uint8_t remaining = RS485_PROBE_COUNT;
+    uint16_t cycles = 0;
+
+    while (remaining > 0 && millis() - startMs < consensusConfig.timeoutMs)
+    {
+        pollCycle(pending);
+        cycles++;
+
+        for (uint8_t ch = 0; ch < RS485_PROBE_COUNT; ch++)
+        {
+            if (!pending[ch])
+            {
+                continue;
+            }
+
+            const Rs485ChannelReading &reading = pollResults[ch];
+            lastStatus[ch] = reading.status;
+            const float sample = reading.status == CHANNEL_OK
+                ? reading.micrometers / CALIPER_VALUE_DIVISOR
+                : INVALID_MEASUREMENT_VALUE;
+
+            if (engines[ch].add(sample))
             {
-                buffer[index++] = c;
+                values[ch] = engines[ch].value();
+                status[ch] = CHANNEL_OK;
+                pending[ch] = false;
+                remaining--;
             }
         }
-        delay(POLL_DELAY_MS);
     }
 
-    buffer[index] = '\0';
-    if (index > 0)
+    for (uint8_t ch = 0; ch < RS485_PROBE_COUNT; ch++)
     {
-        char *endPtr = nullptr;
-        float value = strtof(buffer, &endPtr);
-        if (endPtr != buffer)
+        if (!pending[ch])
+        {
+            continue;
+        }
+
+        switch (lastStatus[ch])
         {
-            return value;
+        case CHANNEL_OK:
+            status[ch] = CHANNEL_NO_CONSENSUS;
+            RECORD_ERROR(ERR_RS485_INVALID_RESPONSE, "Probe %u: no consensus within %u ms",
+                (unsigned)ch, (unsigned)consensusConfig.timeoutMs);
+            break;
+        case CHANNEL_OUT_OF_RANGE:
+            status[ch] = CHANNEL_OUT_OF_RANGE;
+            RECORD_ERROR(ERR_RS485_OUT_OF_RANGE, "Probe %u: value out of range", (unsigned)ch);
+            break;
+        case CHANNEL_INVALID:
+            status[ch] = CHANNEL_INVALID;
+            RECORD_ERROR(ERR_RS485_INVALID_RESPONSE, "Probe %u: unparseable response", (unsigned)ch);
+            break;
+        default:
+            status[ch] = CHANNEL_TIMEOUT;
+            RECORD_ERROR(ERR_RS485_TIMEOUT, "Probe %u: no response within %u ms",
+                (unsigned)ch, RS485_RESPONSE_TIMEOUT_MS);
+            break;
         }
-        RECORD_ERROR(ERR_RS485_INVALID_RESPONSE, "Unparseable response: '%s'", buffer);
     }
-    else
+
+    const uint8_t ok = RS485_PROBE_COUNT - remaining;
+    DEBUG_I("Multi-probe measurement: %u/%u channels ok (%u cycles, %u ms)",
+        (unsigned)ok, (unsigned)RS485_PROBE_COUNT, (unsigned)cycles, (unsigned)(millis() - startMs));
+    return ok;
+}
+
+void RS485Interface::armReceive()
+{
+    portENTER_CRITICAL(&parserMux);
+    parser.reset();
+    lineComplete = false;
+    portEXIT_CRITICAL(&parserMux);
+    waitingTask = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0); // Drop a notification left over from a late reply
+}
+
+bool RS485Interface::readResponse(int32_t &micrometers)
+{
+    const TickType_t timeout = pdMS_TO_TICKS(RS485_RESPONSE_TIMEOUT_MS);
+    const TickType_t startTick = xTaskGetTickCount();
+
+    TickType_t elapsed = 0;
+    while (!lineComplete && elapsed < timeout)
+    {
+        ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+        elapsed = xTaskGetTickCount() - startTick;
+    }
+    waitingTask = nullptr;
+
+    // The UART event task may be feeding the parser right now: end an
+    // unterminated reply under its lock, unless a line completed meanwhile
+    portENTER_CRITICAL(&parserMux);
+    if (!lineComplete)
+    {
+        // Unterminated reply: use what arrived, as before
+        responseStatus = parser.finish();
+        responseError = parser.error();
+        responseUm = parser.micrometers();
+        lineComplete = true;
+    }
+    const P12dParseStatus status = responseStatus;
+    const P12dParseError error = responseError;
+    micrometers = responseUm;
+    portEXIT_CRITICAL(&parserMux);
+
+    if (status == P12dParseStatus::VALUE)
+    {
+        return true;
+    }
+    if (status == P12dParseStatus::INVALID)
     {
-        RECORD_ERROR(ERR_RS485_TIMEOUT, "No response within %u ms", RS485_RESPONSE_TIMEOUT_MS);
+        RECORD_ERROR(ERR_RS485_INVALID_RESPONSE, "Unparseable response (%s)", p12dParseErrorString(error));
+        return false;
     }
+
+    RECORD_ERROR(ERR_RS485_TIMEOUT, "No response within %u ms", RS485_RESPONSE_TIMEOUT_MS);
+    return false;
+}
+
+float RS485Interface::readStreamSample()
+{
+    const TickType_t timeout = pdMS_TO_TICKS(RS485_RESPONSE_TIMEOUT_MS);
+    const TickType_t startTick = xTaskGetTickCount();
+
+    waitingTask = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    for (;;)
+    {
+        Rs485Sample sample;
+        uint32_t seq;
+        if (streamRing.latest(0, sample, &seq) && seq != lastStreamSeq)
+        {
+            waitingTask = nullptr;
+            lastStreamSeq = seq;
+            return sample.micrometers / CALIPER_VALUE_DIVISOR;
+        }
+
+        const TickType_t elapsed = xTaskGetTickCount() - startTick;
+        if (elapsed >= timeout)
+        {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+    }
+    waitingTask = nullptr;
+
+    RECORD_ERROR(ERR_RS485_TIMEOUT, "No streamed position within %u ms", RS485_RESPONSE_TIMEOUT_MS);
     return INVALID_MEASUREMENT_VALUE;
 }
 
+void RS485Interface::startContinuous()
+{
+    if (streaming)
+    {
+        return;
+    }
+
+    streamRing.clear();
+    parserSkipLine = true;
+    streamErrors = 0;
+    lastStreamSeq = 0;
+    streaming = true;
+
+    sendCommand(RS485_STREAM_START_CMD);
+
+    DEBUG_I("RS485 continuous output started (ring: %u positions)", (unsigned)RS485_STREAM_RING_SIZE);
+}
+
+void RS485Interface::stopContinuous()
+{
+    if (!streaming)
+    {
+        return;
+    }
+
+    // The probe is talking: send in the idle gap right after its next line
+    waitingTask = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0);
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RS485_RESPONSE_TIMEOUT_MS));
+    waitingTask = nullptr;
+
+    sendCommand(RS485_STREAM_STOP_CMD);
+    streaming = false;
+
+    DEBUG_I("RS485 continuous output stopped (%u positions, %u bad lines)",
+        (unsigned)streamRing.pushed(), (unsigned)streamErrors);
+}
+
+bool RS485Interface::readLatest(Rs485Sample &out, uint8_t n) const
+{
+    if (!streaming)
+    {
+        return false;
+    }
+    return streamRing.latest(n, out);
+}
+
+bool RS485Interface::readLatest(float &valueMm, uint32_t &timestampUs)
+{
+    if (streaming)
+    {
+        Rs485Sample sample;
+        if (!streamRing.latest(0, sample))
+        {
+            return false;
+        }
+        valueMm = sample.micrometers / CALIPER_VALUE_DIVISOR;
+        timestampUs = sample.timestampUs;
+        return true;
+    }
+
+    valueMm = performMeasurement();
+    timestampUs = micros();
+    return true;
+}
+
 void RS485Interface::begin()
 {
     pinMode(RS485_DE_RE_PIN, OUTPUT);
@@ -112,9 +608,16 @@ void RS485Interface::begin()
 
     Serial1.begin(RS485_BAUD_RATE, SERIAL_8N1, RS485_RX_PIN, RS485_TX_PIN);
     Serial1.flush();
+    configureDirection(RS485_HW_HALF_DUPLEX);
 
-    DEBUG_I("RS485 initialized: %u Bd, 8N1, TX=GPIO%d RX=GPIO%d DE/RE=GPIO%d",
-        (unsigned)RS485_BAUD_RATE, RS485_TX_PIN, RS485_RX_PIN, RS485_DE_RE_PIN);
+    // Deliver data as soon as the line goes idle after the reply instead of
+    // waiting for the FIFO-full threshold
+    Serial1.setRxTimeout(RS485_RX_TIMEOUT_SYMBOLS);
+    Serial1.onReceive(onUartReceive, false);
+
+    DEBUG_I("RS485 initialized: %u Bd, 8N1, TX=GPIO%d RX=GPIO%d DE/RE=GPIO%d (%s direction)",
+        (unsigned)RS485_BAUD_RATE, RS485_TX_PIN, RS485_RX_PIN, RS485_DE_RE_PIN,
+        hardwareDirection ? "UART RTS" : "GPIO");
 }
 
 /**
@@ -130,16 +633,22 @@ void RS485Interface::begin()
  *    - Write '?' + CR (0x0D)
  *    - Flush TX FIFO and wait for last bit to shift out
  *    - Switch MAX485 to receive mode (DE/RE LOW)
+ *    - With hardware direction control the UART does the DE/RE switching
+ *      and only the write is done here
  *
  * 2. Read response:
- *    - Read ASCII characters until CR/LF or timeout
- *    - Parse numeric value with strtof
+ *    - onUartReceive() feeds the characters to P12dParser in the UART event
+ *      task and notifies this task as soon as CR/LF arrives (no polling)
+ *    - The value arrives as exact integer micrometres (no strtof)
+ *    - Query-to-value latency is added to the latency histogram
  *
  * 3. Result validation:
  *    - Range check: MEASUREMENT_MIN_VALUE to MEASUREMENT_MAX_VALUE
- *    - NaN / Inf check
  *    - On error -> return INVALID_MEASUREMENT_VALUE
  *
+ * In streaming mode steps 1-2 are replaced by taking the newest streamed
+ * position not returned before (range was checked when it was stored).
+ *
  * Notes:
  * - This function is blocking - waits for response or timeout
  * - The probe replies in ASCII mode at 115200 Bd, 8N1
@@ -148,32 +657,80 @@ void RS485Interface::begin()
  */
 float RS485Interface::performMeasurement()
 {
+    if (streaming)
+    {
+        float value = readStreamSample();
+        if (value != INVALID_MEASUREMENT_VALUE)
+        {
+            DEBUG_I("Measurement: %.3f mm (stream)", value);
+        }
+        return value;
+    }
+
     DEBUG_I("Triggering RS485 measurement...");
 
+    const uint32_t startUs = micros();
+    armReceive();
     sendQuery();
 
-    float result = readResponse();
-    if (result == INVALID_MEASUREMENT_VALUE)
+    int32_t micrometers;
+    if (!readResponse(micrometers))
     {
         return INVALID_MEASUREMENT_VALUE;
     }
 
-    if (result >= MEASUREMENT_MIN_VALUE && result <= MEASUREMENT_MAX_VALUE && !isnan(result) && !isinf(result))
-    {
-        DEBUG_I("Measurement: %.3f mm", result);
-        return result;
-    }
-    else
+    const float result = micrometers / CALIPER_VALUE_DIVISOR;
+    if (!isValidMicrometers(micrometers))
     {
         RECORD_ERROR(ERR_RS485_OUT_OF_RANGE, "Measurement value: %.3f (range: %.1f to %.1f)",
             result, MEASUREMENT_MIN_VALUE, MEASUREMENT_MAX_VALUE);
         return INVALID_MEASUREMENT_VALUE;
     }
+
+    latency.record(micros() - startUs);
+#if RS485_LATENCY_LOG_INTERVAL > 0
+    if (latency.count() % RS485_LATENCY_LOG_INTERVAL == 0)
+    {
+        logLatencyHistogram();
+    }
+#endif
+    DEBUG_I("Measurement: %.3f mm", result);
+    return result;
+}
+
+void RS485Interface::logLatencyHistogram() const
+{
+    DEBUG_I("RS485 latency: n=%u min=%u mean=%u p50<%u p99<%u max=%u us",
+        (unsigned)latency.count(), (unsigned)latency.minUs(), (unsigned)latency.meanUs(),
+        (unsigned)latency.percentileUs(50), (unsigned)latency.percentileUs(99), (unsigned)latency.maxUs());
+
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+        if (latency.bucketCount(i) > 0)
+        {
+            DEBUG_I("  >= %6u us: %u", (unsigned)LatencyHistogram::bucketLowerUs(i), (unsigned)latency.bucketCount(i));
+        }
+    }
 }
 
 float RS485Interface::performReliableMeasurement()
 {
-    return performMeasurement();
+    lastConsensus = runConsensus(consensusConfig,
+        [this]() { return performMeasurement(); },
+        []() { return (uint32_t)millis(); });
+
+    if (!lastConsensus.ok)
+    {
+        RECORD_ERROR(ERR_RS485_INVALID_RESPONSE,
+            "Reliable measurement failed: no consensus within %u ms (%u attempts)",
+            (unsigned)consensusConfig.timeoutMs, (unsigned)lastConsensus.attempts);
+        return INVALID_MEASUREMENT_VALUE;
+    }
+
+    DEBUG_I("Reliable measurement: %.3f mm (attempts=%u spread=%.3f elapsed=%u ms)",
+        lastConsensus.value, (unsigned)lastConsensus.attempts,
+        lastConsensus.spread, (unsigned)lastConsensus.elapsedMs);
+    return lastConsensus.value;
 }
 
 #endif // defined(RS485)
@@ -16,14 +16,43 @@
  *
  * The MAX485 is a half-duplex transceiver: the DE/RE control pin selects
  * between transmit (HIGH) and receive (LOW) mode. The DE and RE signals
- * are driven together from a single GPIO (RS485_DE_RE_PIN).
+ * are driven together from a single GPIO (RS485_DE_RE_PIN). With
+ * RS485_HW_HALF_DUPLEX that GPIO is the UART RTS output and the UART
+ * switches direction itself; otherwise it is toggled in software.
  *
- * This class exposes the same public API as CaliperInterface so that
- * main.cpp can select between SPC and RS485 via conditional compilation.
+ * Received bytes are fed straight into P12dParser (p12d_parser.h), which
+ * yields exact integer micrometres per line; no line buffer is kept.
+ *
+ * Streaming mode (RS485_CONTINUOUS_OUTPUT): the probe sends its position
+ * continuously. Every parsed line is stored with a timestamp in an
+ * OverwriteRing that always holds the newest RS485_STREAM_RING_SIZE
+ * positions, so reads need no query round trip.
+ *
+ * Multi-drop (RS485_PROBE_COUNT > 1): performMultiMeasurement() polls the
+ * probes round-robin. The query for the next probe is written from the UART
+ * event task as soon as the previous reply's terminator has been parsed,
+ * so the bus never waits for the measurement task to wake up. Replies carry
+ * no address; they are matched to probes by order, which holds because
+ * only one query is outstanding at a time.
+ *
+ * This class implements the LengthSensor interface (length_sensor.h) like
+ * CaliperInterface, so main.cpp can select between SPC and RS485 via
+ * conditional compilation.
  *
  * Built only when the RS485 build flag is defined.
  *
  * @version 1.0 - Initial implementation for RS485 ASCII interface
+ * @version 1.1 - Reliable measurement via configurable consensus engine
+ * @version 1.2 - LengthSensor (CRTP) backend
+ * @version 1.3 - Event-driven reception (UART onReceive + task notification), latency histogram
+ * @version 1.4 - Optional UART hardware RS485 half-duplex direction control
+ * @version 1.5 - Continuous-output streaming mode with a ring of the newest positions
+ * @version 1.6 - Fixed-point streaming parser (P12dParser) instead of line buffer + strtof
+ * @version 1.7 - Multi-drop bus: addressed probes, pipelined round-robin polling
+ * @version 1.8 - Streaming start: the partial line is skipped by the parser owner (UART task)
+ * @version 1.9 - Parser guarded by parserMux (timeout path of readResponse())
+ * @version 2.0 - Poll cycle: guard window after a channel timeout drops late replies
+ * @version 2.1 - readLatest(valueMm, timestampUs) of the LengthSensor interface
  */
 
 #ifndef RS485_H
@@ -35,6 +64,32 @@
 #include "../config.h"
 #include <shared_common.h>
 #include <error_handler.h>
+#include "consensus.h"
+#include "length_sensor.h"
+#include <latency_histogram.h>
+#include <overwrite_ring.h>
+#include "p12d_parser.h"
+
+/**
+ * @brief Position received in streaming mode
+ */
+struct Rs485Sample {
+    int32_t micrometers;   /**< Measurement in micrometers */
+    uint32_t timestampUs;  /**< micros() when the line terminator arrived */
+};
+
+static_assert(RS485_PROBE_COUNT >= 1 && RS485_PROBE_COUNT <= RS485_MAX_PROBES,
+    "RS485_PROBE_COUNT must be 1..RS485_MAX_PROBES");
+static_assert(!(RS485_CONTINUOUS_OUTPUT && RS485_PROBE_COUNT > 1),
+    "Continuous output needs the bus to itself (single probe)");
+
+/**
+ * @brief Reading of one probe in a multi-drop poll cycle
+ */
+struct Rs485ChannelReading {
+    int32_t micrometers;   /**< Value in micrometers (valid if status == CHANNEL_OK) */
+    ChannelStatus status;
+};
 
 /**
  * @brief RS485 (MAX485) sensor interface driver
@@ -43,7 +98,7 @@
  * a MAX485 transceiver. Mirrors the public API of CaliperInterface so the
  * sensor backend can be swapped at compile time via build flags.
  */
-class RS485Interface {
+class RS485Interface : public LengthSensor<RS485Interface> {
 private:
     /**
      * @brief Switch the MAX485 into transmit mode
@@ -61,27 +116,149 @@ private:
 
     /**
      * @brief Send the position query command ('?' + CR) over RS485
-     * @details Switches to transmit mode, writes the query, waits for the TX
-     *          FIFO to drain, then switches back to receive mode.
+     *        (addressed to channel 0 on a multi-drop bus)
+     * @details Software direction: switches to transmit mode, writes the
+     *          query, waits for the TX FIFO to drain plus a guard delay, then
+     *          switches back to receive mode. Hardware direction: only queues
+     *          the query; the UART releases DE/RE after the stop bit.
      * @return true if the query was sent successfully
      */
     bool sendQuery();
 
     /**
-     * @brief Read the ASCII response line from the probe
-     * @details Reads characters from Serial1 until a CR/LF terminator or
-     *          timeout (RS485_RESPONSE_TIMEOUT_MS). Parses the numeric value
-     *          with strtof.
-     * @return Measurement value in millimeters, or INVALID_MEASUREMENT_VALUE
-     *         on timeout / empty / unparseable response.
+     * @brief Send a command string followed by CR
+     * @details Same direction handling as sendQuery().
+     */
+    bool sendCommand(const char *command);
+
+    /**
+     * @brief Select hardware (UART RTS) or software (GPIO) DE/RE control
+     * @param hardware true for UART_MODE_RS485_HALF_DUPLEX
+     */
+    void configureDirection(bool hardware);
+
+    bool hardwareDirection = false;
+
+    /**
+     * @brief Wait for the probe's response line
+     * @details Blocks on a task notification until onUartReceive() has
+     *          parsed a CR/LF-terminated line or RS485_RESPONSE_TIMEOUT_MS
+     *          expires; an unterminated line is accepted after the timeout.
+     * @param micrometers Receives the value
+     * @return false on timeout / empty / unparseable response (error recorded)
+     */
+    bool readResponse(int32_t &micrometers);
+
+    /**
+     * @brief Prepare the parser and register the calling task as the one to
+     *        wake when a line completes
+     */
+    void armReceive();
+
+    /**
+     * @brief Serial1 onReceive callback (UART event task context)
+     * @details Feeds all bytes from the UART driver to the parser and hands
+     *          every completed line to onLine().
+     */
+    static void onUartReceive();
+
+    /**
+     * @brief Deliver a completed line: to the ring in streaming mode, to the
+     *        waiting readResponse() otherwise
+     * @param micrometers, error Parser result of the line
+     * @param timestampUs micros() when the line terminator arrived
+     */
+    static void onLine(P12dParseStatus status, int32_t micrometers, P12dParseError error, uint32_t timestampUs);
+
+    /**
+     * @brief Wait until a streamed sample newer than lastStreamSeq arrives
+     * @return Value in millimeters, or INVALID_MEASUREMENT_VALUE on timeout
+     */
+    float readStreamSample();
+
+    static bool isValidMicrometers(int32_t micrometers);
+
+    /**
+     * @brief Send the addressed position query of one channel
+     */
+    bool sendAddressedQuery(uint8_t channel);
+
+    /**
+     * @brief Query every pending channel once, in channel order
+     * @details The first query is sent here; the following ones by
+     *          onPollLine() right after each reply, or here after a channel
+     *          stayed silent for RS485_RESPONSE_TIMEOUT_MS.
+     * @param pending Channels to poll (RS485_PROBE_COUNT entries)
+     * @return Number of channels polled (results in pollResults)
+     */
+    uint8_t pollCycle(const bool *pending);
+
+    /**
+     * @brief Store a reply for the current channel and send the next query
+     *        (UART event task context)
+     */
+    static void onPollLine(P12dParseStatus status, int32_t micrometers);
+
+    /**
+     * @brief Advance to the next queued channel
+     * @return Channel to query next, or -1 when the cycle is complete
      */
-    float readResponse();
+    static int advancePoll();
+
+    // Parser state is fed by onUartReceive(); the result of the line that
+    // completes a query is copied out for readResponse(). Other tasks ask
+    // for a reset or a skipped line through the flags, applied before the
+    // next received byte. parserMux guards the parser and the hand-over of
+    // the response: readResponse() ends an unterminated reply with finish()
+    // from the measurement task on timeout.
+    static portMUX_TYPE parserMux;
+    static P12dParser parser;
+    static volatile bool lineComplete;
+    static volatile P12dParseStatus responseStatus;
+    static volatile int32_t responseUm;
+    static volatile P12dParseError responseError;
+    static volatile TaskHandle_t waitingTask;
+    static volatile bool parserResync;
+    static volatile bool parserSkipLine;
+
+    // Multi-drop poll cycle: the queue is fixed before the first query;
+    // onPollLine() and the timeout path in pollCycle() advance pollIndex
+    // under pollMux, so every channel is completed exactly once. pollGuard
+    // is set for RS485_POLL_GUARD_MS after a timeout: a late reply of the
+    // silent probe is dropped instead of completing the next channel
+    static portMUX_TYPE pollMux;
+    static RS485Interface *pollOwner;
+    static volatile bool pollActive;
+    static volatile bool pollGuard;
+    static uint8_t pollQueue[RS485_MAX_PROBES];
+    static uint8_t pollQueueLength;
+    static volatile uint8_t pollIndex;
+    static Rs485ChannelReading pollResults[RS485_MAX_PROBES];
+
+    // Streaming mode: onUartReceive() is the producer, readers take the newest
+    static volatile bool streaming;
+    static OverwriteRing<Rs485Sample, RS485_STREAM_RING_SIZE> streamRing;
+    static volatile uint32_t streamErrors;
+    uint32_t lastStreamSeq = 0;
+
+    LatencyHistogram latency;
+
+#if defined(ENABLE_BENCHMARK)
+    friend void benchRs485(RS485Interface &bus);
+#endif
+
+    ConsensusConfig consensusConfig = CONSENSUS_DEFAULT_CONFIG;
+    ConsensusResult lastConsensus = {};
 
 public:
+    static constexpr uint32_t CAPABILITIES = SENSOR_CAP_ONE_SHOT | SENSOR_CAP_RELIABLE
+        | (RS485_CONTINUOUS_OUTPUT ? SENSOR_CAP_CONTINUOUS : 0);
+
     /**
      * @brief Initialize the RS485 interface
-     * @details Configures the DE/RE control pin (default receive mode) and
-     *          starts Serial1 at RS485_BAUD_RATE, 8N1, on the RS485 RX/TX pins.
+     * @details Configures the DE/RE control pin (default receive mode),
+     *          starts Serial1 at RS485_BAUD_RATE, 8N1, on the RS485 RX/TX pins
+     *          and installs the onReceive callback with a short RX timeout.
      */
     void begin();
 
@@ -89,6 +266,8 @@ public:
      * @brief Perform a measurement
      * @return Measured value in millimeters, or INVALID_MEASUREMENT_VALUE on error
      * @details Sends the '?' query, reads the response, and validates the result.
+     *          In streaming mode returns the newest position not returned by
+     *          a previous call, waiting for the next line if there is none.
      *
      * Possible errors:
      * - ERR_RS485_TIMEOUT: No response from the probe within RS485_RESPONSE_TIMEOUT_MS
@@ -98,14 +277,84 @@ public:
     float performMeasurement();
 
     /**
-     * @brief Perform a reliable measurement
+     * @brief Perform a reliable measurement using the consensus engine
      * @return Measured value in millimeters, or INVALID_MEASUREMENT_VALUE on error
-     * @details Basic implementation delegates to performMeasurement() once and
-     *          returns its result. Kept for API parity with CaliperInterface
-     *          (main.cpp calls this method). May be enhanced later with a
-     *          two-identical-readings filter like the SPC implementation.
+     * @details Queries the probe repeatedly via performMeasurement() and feeds
+     *          the readings into a ConsensusEngine (see consensus.h) until its
+     *          criterion is met. Same engine and defaults as CaliperInterface.
+     *
+     * Possible errors:
+     * - ERR_RS485_INVALID_RESPONSE: no consensus within the timeout
      */
     float performReliableMeasurement();
+
+    /**
+     * @brief Select the consensus strategy used by performReliableMeasurement()
+     */
+    void setConsensusConfig(const ConsensusConfig &config) { consensusConfig = config; }
+
+    /**
+     * @brief Statistics of the last performReliableMeasurement() call
+     */
+    const ConsensusResult &getLastConsensus() const { return lastConsensus; }
+
+    /**
+     * @brief Query-to-value latency of successful reads
+     */
+    const LatencyHistogram &getLatencyHistogram() const { return latency; }
+
+    /**
+     * @brief Print the latency histogram (non-empty buckets) via DEBUG_I
+     */
+    void logLatencyHistogram() const;
+
+    /**
+     * @brief Reliable reading of every probe on a multi-drop bus
+     * @details Runs poll cycles until each channel has reached consensus
+     *          (same engine and config as performReliableMeasurement()) or
+     *          the consensus timeout expires. Channels that already agreed
+     *          are skipped in later cycles.
+     * @param values Receives RS485_MAX_PROBES values in mm
+     *               (INVALID_MEASUREMENT_VALUE unless status is CHANNEL_OK)
+     * @param status Receives RS485_MAX_PROBES ChannelStatus values
+     * @return Number of channels with CHANNEL_OK
+     */
+    uint8_t performMultiMeasurement(float *values, uint8_t *status);
+
+    /**
+     * @brief Switch the probe to continuous position output
+     * @details Clears the ring, routes received bytes to the streaming
+     *          parser and sends RS485_STREAM_START_CMD.
+     */
+    void startContinuous();
+
+    /**
+     * @brief Switch the probe back to query mode
+     * @details Sends RS485_STREAM_STOP_CMD in the gap after a received line,
+     *          so the command does not collide with the probe's output.
+     */
+    void stopContinuous();
+
+    bool isContinuous() const { return streaming; }
+
+    /**
+     * @brief Get a streamed position without waiting
+     * @param n Age of the sample (0 = newest, up to RS485_STREAM_RING_SIZE - 1)
+     * @param out Receives value and timestamp
+     * @return false if not streaming or no such sample
+     */
+    bool readLatest(Rs485Sample &out, uint8_t n = 0) const;
+
+    /**
+     * @brief Newest position: newest streamed line when streaming, otherwise
+     *        a one-shot performMeasurement() stamped with micros()
+     */
+    bool readLatest(float &valueMm, uint32_t &timestampUs);
+
+    /**
+     * @brief Number of streamed lines that could not be parsed or were out of range
+     */
+    uint32_t getStreamErrors() const { return streamErrors; }
 };
 
 #endif // defined(RS485)
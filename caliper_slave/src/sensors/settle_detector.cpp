@@ -0,0 +1,82 @@
+/**
+ * @file settle_detector.cpp
+ * @brief Plateau detection on the length sensor stream while the jaw moves
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ */
+
+#include "settle_detector.h"
+
+// ============================================================================
+// Golden vectors (checked at compile time)
+// ============================================================================
+
+namespace {
+
+constexpr SettleConfig CONFIG = {0.002f, 3, true};
+
+struct Frame {
+    float valueMm;
+    uint32_t timestampUs;
+};
+
+struct SettleOutcome {
+    bool settled;
+    uint32_t settledAtUs;
+    uint32_t confirmedAtUs; /**< Timestamp of the frame that confirmed the plateau */
+    float valueMm;
+};
+
+template <uint32_t N>
+constexpr SettleOutcome run(const Frame (&frames)[N], SettleConfig config = CONFIG)
+{
+    SettleDetector detector(config);
+    for (uint32_t i = 0; i < N; i++)
+    {
+        if (detector.feed(frames[i].valueMm, frames[i].timestampUs))
+        {
+            return {true, detector.settledAtUs(), frames[i].timestampUs, detector.value()};
+        }
+    }
+    return {false, 0, 0, detector.value()};
+}
+
+// Jaw closing 0.5 mm per 20 ms frame, stopping on the part at 160 ms (timestamps in µs)
+constexpr Frame STROKE[] = {
+    {20.000f, 0}, {20.000f, 20000}, {19.500f, 40000}, {19.000f, 60000}, {18.500f, 80000},
+    {18.000f, 100000}, {17.500f, 120000}, {17.000f, 140000}, {16.501f, 160000}, {16.500f, 180000},
+    {16.500f, 200000}, {16.501f, 220000}, {16.500f, 240000}};
+static_assert(run(STROKE).settled, "stroke settles");
+static_assert(run(STROKE).settledAtUs == 160000, "settle time is the start of the plateau");
+static_assert(run(STROKE).confirmedAtUs == 220000, "confirmed after K steps within tolerance");
+static_assert(run(STROKE).valueMm == 16.501f, "settled value");
+
+// Standstill before the motor gets going is not a plateau ...
+constexpr Frame STANDSTILL[] = {
+    {20.000f, 0}, {20.000f, 20000}, {20.000f, 40000}, {20.000f, 60000}, {20.000f, 80000}};
+static_assert(!run(STANDSTILL).settled, "no motion, no settle");
+// ... unless motion is not required (jaw already resting on the part)
+static_assert(run(STANDSTILL, {0.002f, 3, false}).settledAtUs == 0, "motion not required");
+
+// Polling faster than the sensor: repeated frames do not count
+constexpr Frame REPEATED[] = {
+    {20.000f, 0}, {19.000f, 20000}, {18.000f, 40000}, {18.000f, 40000}, {18.000f, 40000},
+    {18.000f, 40000}, {18.000f, 60000}, {18.000f, 60000}, {18.000f, 80000}};
+static_assert(!run(REPEATED).settled, "duplicate timestamps are ignored");
+
+// A step above the tolerance restarts the plateau
+constexpr Frame BOUNCE[] = {
+    {20.000f, 0}, {19.000f, 20000}, {18.000f, 40000}, {18.000f, 60000}, {18.010f, 80000},
+    {18.010f, 100000}, {18.010f, 120000}, {18.010f, 140000}};
+static_assert(run(BOUNCE).settledAtUs == 80000, "bounce restarts the plateau");
+static_assert(run(BOUNCE).confirmedAtUs == 140000, "plateau confirmed after the bounce");
+
+// An invalid frame restarts the plateau as well
+constexpr Frame DROPOUT[] = {
+    {20.000f, 0}, {19.000f, 20000}, {18.000f, 40000}, {18.000f, 60000}, {INVALID_MEASUREMENT_VALUE, 80000},
+    {18.000f, 100000}, {18.000f, 120000}, {18.000f, 140000}, {18.000f, 160000}};
+static_assert(run(DROPOUT).settledAtUs == 100000, "invalid frame restarts the plateau");
+static_assert(run(DROPOUT).confirmedAtUs == 160000, "plateau confirmed after the dropout");
+
+} // namespace
@@ -0,0 +1,158 @@
+/**
+ * @file settle_detector.h
+ * @brief Plateau detection on the length sensor stream while the jaw moves
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Fed with every new position frame of the forward stroke. The jaw has
+ * settled when K consecutive frame-to-frame steps are all within the
+ * tolerance (K + 1 frames of a plateau). Only a plateau after the jaw has
+ * moved counts, so the standstill before the motor gets going is not
+ * mistaken for contact with the part.
+ *
+ * - Frames with the same timestamp as the previous one are ignored (the
+ *   caller may poll faster than the sensor produces frames). Timestamps are
+ *   the raw capture times in µs: a ms value derived from them jitters with
+ *   the read latency and would let one frame count twice.
+ *   Convert to ms only for reporting.
+ * - An invalid frame (INVALID_MEASUREMENT_VALUE) restarts the plateau.
+ * - settledAtUs() is the timestamp of the first frame of the plateau, i.e.
+ *   when the jaw actually stopped, not when the plateau was confirmed.
+ *
+ * All methods are constexpr, so the golden vectors in settle_detector.cpp
+ * are checked at compile time. No Arduino dependency; builds on the host.
+ *
+ * @version 1.0 - Initial implementation
+ * @version 1.1 - Frames keyed by the raw capture time in µs
+ */
+
+#ifndef SETTLE_DETECTOR_H
+#define SETTLE_DETECTOR_H
+
+#include <stdint.h>
+#include <shared_config.h>
+
+struct SettleConfig {
+    float toleranceMm;    /**< Largest frame-to-frame step that counts as standing still */
+    uint8_t frames;       /**< K: consecutive steps within the tolerance (>= 1) */
+    bool requireMotion;   /**< Ignore plateaus before the first step above the tolerance */
+};
+
+class SettleDetector {
+public:
+    constexpr SettleDetector() = default;
+    constexpr explicit SettleDetector(const SettleConfig &cfg) : config(cfg) {}
+
+    /**
+     * @brief Start a new stroke
+     */
+    constexpr void reset()
+    {
+        haveFrame = false;
+        moved = false;
+        isSettled = false;
+        stableSteps = 0;
+        lastValue = 0.0f;
+        lastTimestampUs = 0;
+        plateauStartUs = 0;
+        frameCount = 0;
+    }
+
+    /**
+     * @brief Consume one position frame
+     * @param valueMm Position in mm, or INVALID_MEASUREMENT_VALUE
+     * @param timestampUs When the frame was captured (micros(), unique per frame)
+     * @return true once the plateau is confirmed (stays true until reset())
+     */
+    constexpr bool feed(float valueMm, uint32_t timestampUs)
+    {
+        if (isSettled)
+        {
+            return true;
+        }
+        if (haveFrame && timestampUs == lastTimestampUs)
+        {
+            return false;
+        }
+
+        if (valueMm == INVALID_MEASUREMENT_VALUE)
+        {
+            haveFrame = false;
+            stableSteps = 0;
+            return false;
+        }
+
+        frameCount++;
+        if (!haveFrame)
+        {
+            haveFrame = true;
+            stableSteps = 0;
+            plateauStartUs = timestampUs;
+        }
+        else if (absDiff(valueMm, lastValue) <= config.toleranceMm)
+        {
+            if (stableSteps == 0)
+            {
+                plateauStartUs = lastTimestampUs;
+            }
+            if (stableSteps < UINT8_MAX)
+            {
+                stableSteps++;
+            }
+        }
+        else
+        {
+            moved = true;
+            stableSteps = 0;
+        }
+
+        lastValue = valueMm;
+        lastTimestampUs = timestampUs;
+
+        const uint8_t needed = config.frames ? config.frames : 1;
+        isSettled = stableSteps >= needed && (moved || !config.requireMotion);
+        return isSettled;
+    }
+
+    constexpr bool settled() const { return isSettled; }
+
+    /**
+     * @brief Position of the newest frame (the settled value once settled())
+     */
+    constexpr float value() const { return lastValue; }
+
+    /**
+     * @brief Timestamp (µs) of the first frame of the confirmed plateau
+     */
+    constexpr uint32_t settledAtUs() const { return plateauStartUs; }
+
+    /**
+     * @brief true once a step above the tolerance was seen
+     */
+    constexpr bool hasMoved() const { return moved; }
+
+    /**
+     * @brief Valid frames consumed since reset()
+     */
+    constexpr uint32_t frames() const { return frameCount; }
+
+    constexpr void setConfig(const SettleConfig &cfg) { config = cfg; }
+    constexpr const SettleConfig &getConfig() const { return config; }
+
+private:
+    SettleConfig config = {0.0f, 1, true};
+    bool haveFrame = false;
+    bool moved = false;
+    bool isSettled = false;
+    uint8_t stableSteps = 0;
+    float lastValue = 0.0f;
+    uint32_t lastTimestampUs = 0;
+    uint32_t plateauStartUs = 0;
+    uint32_t frameCount = 0;
+
+    static constexpr float absDiff(float a, float b) { return a > b ? a - b : b - a; }
+};
+
+#endif // SETTLE_DETECTOR_H
@@ -0,0 +1,123 @@
+/**
+ * @file simulated_sensor.cpp
+ * @brief Simulated length sensor backend (no hardware required)
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ */
+
+#if defined(SIM_SENSOR)
+
+#include "simulated_sensor.h"
+
+#include <math.h>
+#include <MacroDebugger.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+
+static uint32_t simMillis() { return (uint32_t)millis(); }
+static uint32_t simMicros() { return (uint32_t)micros(); }
+static void simDelay(uint32_t ms) { delay(ms); }
+#else
+#include <chrono>
+#include <thread>
+
+static uint32_t simMillis()
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+static uint32_t simMicros()
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+static void simDelay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+#endif
+
+uint32_t SimulatedSensor::nextRandom()
+{
+    // xorshift32
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+float SimulatedSensor::uniform()
+{
+    return (nextRandom() >> 8) * (1.0f / 16777216.0f);
+}
+
+float SimulatedSensor::gaussian()
+{
+    // Box-Muller; u1 is kept away from 0 for logf()
+    const float u1 = uniform() + 1.0f / 33554432.0f;
+    const float u2 = uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+void SimulatedSensor::begin()
+{
+    rngState = config.seed ? config.seed : 0x2545F491u;
+    readCount = 0;
+    failureCount = 0;
+
+    DEBUG_I("Simulated sensor: nominal=%.3f mm noise=%.4f mm latency=%u+%u ms failure=%.2f",
+        config.nominalMm, config.noiseMm, (unsigned)config.latencyMs,
+        (unsigned)config.jitterMs, config.failureRate);
+}
+
+float SimulatedSensor::performMeasurement()
+{
+    readCount++;
+
+    const uint32_t jitter = config.jitterMs ? nextRandom() % (config.jitterMs + 1) : 0;
+    simDelay(config.latencyMs + jitter);
+
+    if (uniform() < config.failureRate)
+    {
+        failureCount++;
+        return INVALID_MEASUREMENT_VALUE;
+    }
+
+    float value = config.nominalMm + config.noiseMm * gaussian();
+    if (config.resolutionMm > 0.0f)
+    {
+        value = roundf(value / config.resolutionMm) * config.resolutionMm;
+    }
+
+    if (value < MEASUREMENT_MIN_VALUE || value > MEASUREMENT_MAX_VALUE)
+    {
+        failureCount++;
+        return INVALID_MEASUREMENT_VALUE;
+    }
+    return value;
+}
+
+bool SimulatedSensor::readLatest(float &valueMm, uint32_t &timestampUs)
+{
+    valueMm = performMeasurement();
+    timestampUs = simMicros();
+    return true;
+}
+
+float SimulatedSensor::performReliableMeasurement()
+{
+    lastConsensus = runConsensus(consensusConfig,
+        [this]() { return performMeasurement(); },
+        []() { return simMillis(); });
+
+    if (!lastConsensus.ok)
+    {
+        return INVALID_MEASUREMENT_VALUE;
+    }
+
+    DEBUG_I("Reliable measurement: %.3f mm (attempts=%u spread=%.3f elapsed=%u ms)",
+        lastConsensus.value, (unsigned)lastConsensus.attempts,
+        lastConsensus.spread, (unsigned)lastConsensus.elapsedMs);
+    return lastConsensus.value;
+}
+
+#endif // defined(SIM_SENSOR)
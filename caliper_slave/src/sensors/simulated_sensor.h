@@ -0,0 +1,113 @@
+/**
+ * @file simulated_sensor.h
+ * @brief Simulated length sensor backend (no hardware required)
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Third LengthSensor backend next to CaliperInterface (SPC) and
+ * RS485Interface (RS485), selected with the SIM_SENSOR build flag.
+ * Produces readings around a configurable nominal value with:
+ * - latency: fixed base plus uniform jitter per reading
+ * - noise: Gaussian, quantised to the display resolution
+ * - failures: a reading fails (INVALID_MEASUREMENT_VALUE after the full
+ *   latency, like a timeout) with the configured probability
+ *
+ * The pseudo-random generator is seeded from the config, so runs are
+ * repeatable. The class has no Arduino dependency and also builds for the
+ * native host environment (env:native_sim), where sim/sim_main.cpp drives
+ * it as a load test of the measurement pipeline.
+ *
+ * @version 1.0 - Initial implementation
+ * @version 1.1 - readLatest(valueMm, timestampUs) of the LengthSensor interface
+ */
+
+#ifndef SIMULATED_SENSOR_H
+#define SIMULATED_SENSOR_H
+
+#if defined(SIM_SENSOR)
+
+#include <stdint.h>
+#if defined(ARDUINO)
+#include "../config.h"
+#else
+#include <shared_config.h>
+#endif
+#include "length_sensor.h"
+#include "consensus.h"
+
+// Host builds have no slave config.h; use the original two-identical rule
+#ifndef CONSENSUS_DEFAULT_CONFIG
+#define CONSENSUS_DEFAULT_CONFIG {ConsensusStrategy::K_OF_M, 2, 2, 0, 0.0f, RELIABLE_MEASUREMENT_TIMEOUT_MS}
+#endif
+
+struct SimulatedSensorConfig {
+    float nominalMm;        /**< Mean reading in mm */
+    float noiseMm;          /**< Standard deviation of the noise in mm */
+    float resolutionMm;     /**< Readings are rounded to this step (0 = off) */
+    uint32_t latencyMs;     /**< Base latency of one reading */
+    uint32_t jitterMs;      /**< Additional uniform latency 0..jitterMs */
+    float failureRate;      /**< Probability 0..1 that a reading fails */
+    uint32_t seed;          /**< PRNG seed (0 is replaced by a fixed value) */
+};
+
+/**
+ * @brief Default simulation parameters (overridable per build)
+ */
+#ifndef SIM_DEFAULT_CONFIG
+#define SIM_DEFAULT_CONFIG {10.000f, 0.001f, 0.001f, 5, 5, 0.05f, 1}
+#endif
+
+class SimulatedSensor : public LengthSensor<SimulatedSensor> {
+private:
+    SimulatedSensorConfig config = SIM_DEFAULT_CONFIG;
+    ConsensusConfig consensusConfig = CONSENSUS_DEFAULT_CONFIG;
+    ConsensusResult lastConsensus = {};
+    uint32_t rngState = 1;
+    uint32_t readCount = 0;
+    uint32_t failureCount = 0;
+
+    uint32_t nextRandom();
+    float uniform();
+    float gaussian();
+
+public:
+    static constexpr uint32_t CAPABILITIES = SENSOR_CAP_ONE_SHOT | SENSOR_CAP_RELIABLE | SENSOR_CAP_SIMULATED;
+
+    /**
+     * @brief Reset counters and seed the generator
+     */
+    void begin();
+
+    /**
+     * @brief Produce one simulated reading (blocks for the simulated latency)
+     * @return Value in mm, or INVALID_MEASUREMENT_VALUE for a simulated failure
+     */
+    float performMeasurement();
+
+    /**
+     * @brief Consensus read over simulated readings (same engine as hardware)
+     * @return Agreed value in mm, or INVALID_MEASUREMENT_VALUE on timeout
+     */
+    float performReliableMeasurement();
+
+    /**
+     * @brief One simulated reading, stamped when it completed
+     * @return true (the simulation does not stream)
+     */
+    bool readLatest(float &valueMm, uint32_t &timestampUs);
+
+    void setConfig(const SimulatedSensorConfig &cfg) { config = cfg; }
+    const SimulatedSensorConfig &getConfig() const { return config; }
+
+    void setConsensusConfig(const ConsensusConfig &cfg) { consensusConfig = cfg; }
+    const ConsensusResult &getLastConsensus() const { return lastConsensus; }
+
+    uint32_t getReadCount() const { return readCount; }
+    uint32_t getFailureCount() const { return failureCount; }
+};
+
+#endif // defined(SIM_SENSOR)
+
+#endif // SIMULATED_SENSOR_H
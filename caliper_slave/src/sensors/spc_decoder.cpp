@@ -0,0 +1,48 @@
+/**
+ * @file spc_decoder.cpp
+ * @brief Decoder for packed SPC (Digimatic) caliper frames
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.2
+ *
+ * @version 1.1 - Integer, table-driven BCD decoding (no pow()/float)
+ * @version 1.2 - Golden vectors moved to test/test_spc_decoder
+ */
+
+#include "spc_decoder.h"
+
+#include <math.h>
+
+float spcReadingToMm(const SpcReading &reading)
+{
+    if (!reading.valid)
+    {
+        return NAN;
+    }
+    return reading.micrometers / CALIPER_VALUE_DIVISOR;
+}
+
+/**
+ * @brief Decodes a packed caliper frame to value in millimeters
+ *
+ * @details
+ * Caliper data format (bit n = n-th received bit):
+ * - 52 bits total
+ * - Bits 44-51 (last 8 received): header (ignored)
+ * - Bits 0-43: measurement data, 11 nibbles of 4 bits
+ * - Nibble k occupies frame bits (40 - 4k)..(43 - 4k), LSB first
+ * - Nibbles 0..4: BCD digits, least significant first
+ * - Nibble 6: flags (bit 2: inch mode, bit 3: negative)
+ *
+ * Examples:
+ * - digits [5, 4, 3, 2, 1], flags 0x00 → 12.345 mm
+ * - digits [5, 4, 3, 2, 1], flags 0x08 → -12.345 mm
+ * - digits [4, 3, 2, 1, 0], flags 0x04 → 1.234 in → 31.344 mm
+ *
+ * @param frame Packed frame as delivered by a capture backend
+ * @return Measurement value in millimeters, NAN for non-BCD frames
+ */
+float spcDecodeFrame(uint64_t frame)
+{
+    return spcReadingToMm(spcDecodeReading(frame));
+}
@@ -0,0 +1,124 @@
+/**
+ * @file spc_decoder.h
+ * @brief Decoder for packed SPC (Digimatic) caliper frames
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Shared by all SPC capture backends (GPIO interrupt and SPI-slave DMA).
+ * A backend only has to deliver the 52 received bits packed into a 64-bit
+ * word, with bit n holding the n-th received bit (LSB-first).
+ *
+ * Decoding is done in integer arithmetic only (spcDecodeReading()); floating
+ * point is used just once, when the result is handed to the float-based
+ * measurement API (spcReadingToMm(), spcDecodeFrame()).
+ *
+ * @version 1.1 - Integer, table-driven BCD decoding (no pow()/float)
+ */
+
+#ifndef SPC_DECODER_H
+#define SPC_DECODER_H
+
+#include <stdint.h>
+#include <shared_config.h>
+
+/**
+ * @brief Raw frame as delivered by a capture backend
+ */
+struct SpcRawFrame {
+    uint64_t frame;        /**< Packed frame word (bit n = n-th received bit) */
+    uint32_t timestampUs;  /**< micros() when the last bit was received */
+};
+
+/**
+ * @brief Integer result of decoding one frame
+ */
+struct SpcReading {
+    int32_t micrometers;   /**< Signed value in µm (inch readings already converted) */
+    bool negative;         /**< Sign flag from the frame */
+    bool inch;             /**< Caliper was in inch mode */
+    bool valid;            /**< false if a digit nibble was not BCD (> 9) */
+};
+
+#define SPC_FLAG_NEGATIVE 0x08
+#define SPC_FLAG_INCH 0x04
+#define SPC_INVALID_BCD 0xFF
+
+/**
+ * @brief Lookup table: one frame byte (two adjacent digit nibbles) -> 0..99
+ * @details Digit k sits at frame bits (40 - 4k)..(43 - 4k), so in the byte
+ *          covering digits k and k+1 the lower digit is the HIGH nibble.
+ *          Bytes containing a non-BCD nibble map to SPC_INVALID_BCD.
+ */
+struct SpcBcdPairTable {
+    uint8_t value[256];
+
+    constexpr SpcBcdPairTable() : value()
+    {
+        for (int b = 0; b < 256; b++)
+        {
+            const int lowerDigit = b >> 4;
+            const int upperDigit = b & 0x0F;
+            value[b] = (lowerDigit > 9 || upperDigit > 9) ? SPC_INVALID_BCD : (uint8_t)(lowerDigit + 10 * upperDigit);
+        }
+    }
+};
+
+inline constexpr SpcBcdPairTable SPC_BCD_PAIRS{};
+
+/**
+ * @brief Decode a packed SPC frame to an integer reading
+ *
+ * @details
+ * - Digits 0..3 are resolved with two byte lookups, digit 4 directly, so
+ *   there is no per-bit or per-digit loop and no libm call.
+ * - Raw counts are thousandths of the display unit: µm in mm mode,
+ *   milli-inch in inch mode. Milli-inch are converted with
+ *   1 mil = 25.4 µm, rounded to the nearest µm.
+ * - Range checking is left to the caller.
+ *
+ * @param frame Packed frame (bit n = n-th received bit)
+ * @return Decoded reading; valid == false for non-BCD digits
+ */
+constexpr SpcReading spcDecodeReading(uint64_t frame)
+{
+    constexpr int DIGIT0_BIT = CALIPER_FRAME_BITS - CALIPER_BIT_SHIFT - BITS_PER_NIBBLE;
+
+    const uint8_t pair01 = SPC_BCD_PAIRS.value[(frame >> (DIGIT0_BIT - BITS_PER_NIBBLE)) & 0xFF];
+    const uint8_t pair23 = SPC_BCD_PAIRS.value[(frame >> (DIGIT0_BIT - 3 * BITS_PER_NIBBLE)) & 0xFF];
+    const uint8_t digit4 = (uint8_t)((frame >> (DIGIT0_BIT - 4 * BITS_PER_NIBBLE)) & 0x0F);
+    const uint8_t flags = (uint8_t)((frame >> (DIGIT0_BIT - 6 * BITS_PER_NIBBLE)) & 0x0F);
+
+    SpcReading reading = {0, (flags & SPC_FLAG_NEGATIVE) != 0, (flags & SPC_FLAG_INCH) != 0, false};
+    if (pair01 == SPC_INVALID_BCD || pair23 == SPC_INVALID_BCD || digit4 > 9)
+    {
+        return reading;
+    }
+
+    int32_t counts = (int32_t)pair01 + 100 * (int32_t)pair23 + 10000 * (int32_t)digit4;
+    if (reading.inch)
+    {
+        counts = (counts * 254 + 5) / 10;
+    }
+
+    reading.micrometers = reading.negative ? -counts : counts;
+    reading.valid = true;
+    return reading;
+}
+
+/**
+ * @brief Convert an integer reading to millimeters (API boundary)
+ * @return Value in millimeters, NAN if the reading is not valid
+ */
+float spcReadingToMm(const SpcReading &reading);
+
+/**
+ * @brief Decode a packed SPC frame to a value in millimeters
+ * @param frame Packed frame (bit n = n-th received bit)
+ * @return Measurement value in millimeters (not range-checked), NAN for
+ *         frames with non-BCD digits
+ */
+float spcDecodeFrame(uint64_t frame);
+
+#endif // SPC_DECODER_H
@@ -0,0 +1,141 @@
+/**
+ * @file spc_frame_sync.h
+ * @brief Edge-timing frame synchroniser for the SPC clock/data capture
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Falling edges only (one interrupt per bit)
+ *
+ * @details
+ * Turns timestamped falling CLOCK edges into complete, correctly aligned
+ * frames. Called from the capture ISR on every falling CLOCK edge with a
+ * free-running cycle counter timestamp and the sampled line levels.
+ *
+ * - Bit cells: DATA is sampled on the falling edge that starts each
+ *   clock-low phase, as the original capture ISR did.
+ * - Frame alignment: the idle gap is measured between the timestamps of
+ *   consecutive falling edges. An edge more than gapCycles after the
+ *   previous one is always bit 0 of a new frame. After a complete frame,
+ *   and after reset() of a line that may be busy, edges are ignored until
+ *   such a gap, so a capture started in the middle of a frame never yields
+ *   a shifted frame.
+ * - Glitch rejection: a falling edge less than minPeriodCycles after the
+ *   previous one (a high glitch inside the low phase) is dropped, and so is
+ *   an edge whose CLOCK level already reads high again in the ISR (a low
+ *   glitch shorter than the interrupt latency).
+ *
+ * Cycle arithmetic is modulo 2^32, so the counter may wrap freely.
+ * No Arduino dependency; builds on the host.
+ */
+
+#ifndef SPC_FRAME_SYNC_H
+#define SPC_FRAME_SYNC_H
+
+#include <stdint.h>
+#include <shared_config.h>
+
+#if defined(__GNUC__)
+  #define SPC_SYNC_INLINE inline __attribute__((always_inline))
+#else
+  #define SPC_SYNC_INLINE inline
+#endif
+
+class SpcFrameSync {
+public:
+    /**
+     * @brief Set timing limits (in timestamp ticks, e.g. CPU cycles)
+     * @param minPeriod Shortest accepted time between two falling edges
+     * @param gap Idle time that separates two frames
+     */
+    void configure(uint32_t minPeriod, uint32_t gap)
+    {
+        minPeriodCycles = minPeriod;
+        gapCycles = gap;
+    }
+
+    /**
+     * @brief Restart reception
+     * @param now Current timestamp; idle time is measured from here
+     * @param lineIdle true if CLOCK is known to be idle (caliper not yet
+     *                 triggered): the next edge is bit 0. false: wait for an
+     *                 inter-frame gap first.
+     */
+    SPC_SYNC_INLINE void reset(uint32_t now, bool lineIdle)
+    {
+        frame = 0;
+        bitCount = 0;
+        lastFall = now;
+        synced = lineIdle;
+    }
+
+    /**
+     * @brief Process one falling CLOCK edge
+     * @param now Timestamp of the edge
+     * @param clockLow CLOCK level read in the ISR (high: the pulse is already over)
+     * @param dataHigh DATA level sampled together with CLOCK
+     * @return true when the edge completed a frame (read it with frameWord())
+     */
+    SPC_SYNC_INLINE bool onFalling(uint32_t now, bool clockLow, bool dataHigh)
+    {
+        if (!clockLow)
+        {
+            glitchCount++;
+            return false;
+        }
+
+        const uint32_t interval = now - lastFall;
+        if (interval > gapCycles)
+        {
+            if (bitCount > 0)
+            {
+                resyncCount++; // The previous frame was truncated
+            }
+            frame = 0;
+            bitCount = 0;
+            synced = true;
+        }
+        else if (interval < minPeriodCycles)
+        {
+            glitchCount++; // Keep lastFall: the real edge is timed from the previous bit
+            return false;
+        }
+        lastFall = now;
+
+        if (!synced)
+        {
+            return false;
+        }
+
+        if (dataHigh)
+        {
+            frame |= 1ULL << bitCount;
+        }
+        if (++bitCount == CALIPER_FRAME_BITS)
+        {
+            bitCount = 0;
+            synced = false; // Surplus edges wait for the next gap
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t frameWord() const { return frame; }
+    uint8_t bits() const { return bitCount; }
+    bool isSynced() const { return synced; }
+    uint32_t glitches() const { return glitchCount; }
+    uint32_t resyncs() const { return resyncCount; }
+
+private:
+    uint32_t minPeriodCycles = 0;
+    uint32_t gapCycles = UINT32_MAX;
+
+    uint64_t frame = 0;
+    uint8_t bitCount = 0;
+    bool synced = false;
+    uint32_t lastFall = 0;
+    uint32_t glitchCount = 0;
+    uint32_t resyncCount = 0;
+};
+
+#endif // SPC_FRAME_SYNC_H
@@ -0,0 +1,311 @@
+/**
+ * @file spc_spi_capture.cpp
+ * @brief SPI-slave DMA capture backend for the SPC caliper interface
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Frame end on the 52nd rising edge, capture starts after an idle gap
+ */
+
+#include "spc_spi_capture.h"
+
+#if defined(SPC) && defined(SPC_CAPTURE_SPI)
+
+#include <MacroDebugger.h>
+#include <error_handler.h>
+#include <driver/gpio.h>
+#include <esp_rom_gpio.h>
+#include <soc/spi_periph.h>
+
+#ifndef GPIO_MATRIX_CONST_ONE_INPUT
+#define GPIO_MATRIX_CONST_ONE_INPUT 0x38
+#endif
+#ifndef GPIO_MATRIX_CONST_ZERO_INPUT
+#define GPIO_MATRIX_CONST_ZERO_INPUT 0x3C
+#endif
+
+// 64-bit receive window per frame; DMA requires word-aligned, DMA-capable memory
+static WORD_ALIGNED_ATTR DMA_ATTR uint8_t rxBuffers[CALIPER_FRAME_RING_SIZE][8];
+
+volatile bool SpcSpiCapture::synced = false;
+volatile bool SpcSpiCapture::slotLoaded = false;
+
+void IRAM_ATTR SpcSpiCapture::setChipSelect(bool asserted)
+{
+    esp_rom_gpio_connect_in_signal(
+        asserted ? GPIO_MATRIX_CONST_ZERO_INPUT : GPIO_MATRIX_CONST_ONE_INPUT,
+        spi_periph_signal[SPC_SPI_HOST].spics_in,
+        false);
+}
+
+void IRAM_ATTR SpcSpiCapture::onPostSetup(spi_slave_transaction_t *trans)
+{
+    (void)trans;
+    // Not aligned yet: onSyncTimer asserts CS at the next idle gap
+    slotLoaded = true;
+    if (synced)
+    {
+        setChipSelect(true);
+    }
+}
+
+void IRAM_ATTR SpcSpiCapture::onPostTransaction(spi_slave_transaction_t *trans)
+{
+    Slot *slot = (Slot *)trans->user;
+    slot->timestampUs = (uint32_t)micros();
+}
+
+bool IRAM_ATTR SpcSpiCapture::onFrameBits(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t *edata, void *userCtx)
+{
+    (void)unit;
+    (void)edata;
+    (void)userCtx;
+    // 52nd rising edge seen, so the SPI slave has sampled the last bit: end
+    // the transaction. The next edge is bit 0 of the next frame.
+    slotLoaded = false;
+    setChipSelect(false);
+    return false;
+}
+
+void SpcSpiCapture::onSyncTimer(void *arg)
+{
+    SpcSpiCapture *self = (SpcSpiCapture *)arg;
+
+    int count = 0;
+    pcnt_unit_get_count(self->pcntUnit, &count);
+    if (count != self->syncCount)
+    {
+        self->syncCount = count; // CLOCK edges during the last period
+        return;
+    }
+
+    // No edge for a whole SPC_FRAME_GAP_US: the next edge starts a frame
+    esp_timer_stop(self->syncTimer);
+    pcnt_unit_clear_count(self->pcntUnit);
+    synced = true;
+    if (slotLoaded)
+    {
+        setChipSelect(true);
+    }
+}
+
+void SpcSpiCapture::resync()
+{
+    synced = false;
+    setChipSelect(false);
+
+    esp_timer_stop(syncTimer);
+    pcnt_unit_get_count(pcntUnit, &syncCount);
+    esp_timer_start_periodic(syncTimer, SPC_FRAME_GAP_US);
+}
+
+bool SpcSpiCapture::begin()
+{
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = DATA_PIN;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = CLOCK_PIN;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+
+    spi_slave_interface_config_t slave = {};
+    slave.mode = 3;
+    slave.spics_io_num = SPC_SPI_CS_PIN;
+    slave.queue_size = SLOT_COUNT;
+    slave.flags = SPI_SLAVE_RXBIT_LSBFIRST;
+    slave.post_setup_cb = onPostSetup;
+    slave.post_trans_cb = onPostTransaction;
+
+    esp_err_t err = spi_slave_initialize(SPC_SPI_HOST, &bus, &slave, SPI_DMA_CH_AUTO);
+    if (err != ESP_OK)
+    {
+        RECORD_ERROR(ERR_CALIPER_HARDWARE_FAILURE, "SPI slave init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    // The driver routed the CS pad into the slave; replace it with a constant
+    setChipSelect(false);
+    gpio_set_pull_mode((gpio_num_t)CLOCK_PIN, GPIO_PULLUP_ONLY);
+    gpio_set_pull_mode((gpio_num_t)DATA_PIN, GPIO_PULLUP_ONLY);
+
+    pcnt_unit_config_t unitConfig = {};
+    unitConfig.low_limit = -1;
+    unitConfig.high_limit = CALIPER_FRAME_BITS;
+    err = pcnt_new_unit(&unitConfig, &pcntUnit);
+
+    if (err == ESP_OK)
+    {
+        pcnt_glitch_filter_config_t filter = {};
+        filter.max_glitch_ns = SPC_SPI_GLITCH_FILTER_NS;
+        pcnt_unit_set_glitch_filter(pcntUnit, &filter);
+
+        pcnt_chan_config_t channelConfig = {};
+        channelConfig.edge_gpio_num = CLOCK_PIN;
+        channelConfig.level_gpio_num = -1;
+        err = pcnt_new_channel(pcntUnit, &channelConfig, &pcntChannel);
+    }
+
+    if (err == ESP_OK)
+    {
+        // Count rising edges only (rising = increase, falling = hold), the
+        // edges SPI mode 3 samples DATA on
+        pcnt_channel_set_edge_action(pcntChannel, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+        pcnt_unit_add_watch_point(pcntUnit, CALIPER_FRAME_BITS);
+
+        pcnt_event_callbacks_t callbacks = {};
+        callbacks.on_reach = onFrameBits;
+        pcnt_unit_register_event_callbacks(pcntUnit, &callbacks, this);
+        err = pcnt_unit_enable(pcntUnit);
+    }
+
+    if (err != ESP_OK)
+    {
+        RECORD_ERROR(ERR_CALIPER_HARDWARE_FAILURE, "PCNT init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = onSyncTimer;
+    timerArgs.arg = this;
+    timerArgs.name = "spc_sync";
+    err = esp_timer_create(&timerArgs, &syncTimer);
+    if (err != ESP_OK)
+    {
+        RECORD_ERROR(ERR_CALIPER_HARDWARE_FAILURE, "Frame sync timer init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    initialized = true;
+    DEBUG_I("SPC SPI-slave capture ready: SCLK=GPIO%d MOSI=GPIO%d host=%d",
+        CLOCK_PIN, DATA_PIN, (int)SPC_SPI_HOST);
+    return true;
+}
+
+void SpcSpiCapture::queueSlot(Slot &slot)
+{
+    const size_t index = &slot - slots;
+
+    memset(&slot.trans, 0, sizeof(slot.trans));
+    slot.trans.length = sizeof(rxBuffers[0]) * 8;
+    slot.trans.rx_buffer = rxBuffers[index];
+    slot.trans.user = &slot;
+    slot.timestampUs = 0;
+
+    if (spi_slave_queue_trans(SPC_SPI_HOST, &slot.trans, 0) == ESP_OK)
+    {
+        queued++;
+    }
+}
+
+void SpcSpiCapture::arm(uint8_t depth)
+{
+    if (!initialized)
+    {
+        return;
+    }
+
+    if (depth > SLOT_COUNT) depth = SLOT_COUNT;
+
+    pcnt_unit_clear_count(pcntUnit);
+    pcnt_unit_start(pcntUnit);
+    resync();
+
+    for (uint8_t i = 0; i < depth; i++)
+    {
+        queueSlot(slots[i]);
+    }
+}
+
+void SpcSpiCapture::disarm()
+{
+    if (!initialized)
+    {
+        return;
+    }
+
+    esp_timer_stop(syncTimer);
+    pcnt_unit_stop(pcntUnit);
+
+    // Let every queued transaction assert CS when loaded and release it until
+    // all of them have completed (with whatever was received, usually nothing)
+    synced = true;
+    if (slotLoaded)
+    {
+        setChipSelect(true); // Loaded while waiting for an idle gap
+    }
+    spi_slave_transaction_t *trans = nullptr;
+    while (queued > 0)
+    {
+        setChipSelect(false);
+        if (spi_slave_get_trans_result(SPC_SPI_HOST, &trans, pdMS_TO_TICKS(MEASUREMENT_TIMEOUT_MS)) != ESP_OK)
+        {
+            RECORD_ERROR(ERR_CALIPER_HARDWARE_FAILURE, "SPI slave did not release %u transaction(s)", (unsigned)queued);
+            break;
+        }
+        queued--;
+    }
+    synced = false;
+    slotLoaded = false;
+}
+
+SpcSpiCapture::Slot *SpcSpiCapture::fetch(SpcRawFrame &out, bool &complete, TickType_t ticks)
+{
+    spi_slave_transaction_t *trans = nullptr;
+    if (spi_slave_get_trans_result(SPC_SPI_HOST, &trans, ticks) != ESP_OK)
+    {
+        return nullptr;
+    }
+    queued--;
+
+    Slot *slot = (Slot *)trans->user;
+    const uint8_t *rx = (const uint8_t *)trans->rx_buffer;
+
+    uint64_t frame = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        frame |= (uint64_t)rx[i] << (8 * i);
+    }
+
+    out.frame = frame & ((1ULL << CALIPER_FRAME_BITS) - 1);
+    out.timestampUs = slot->timestampUs;
+
+    complete = (trans->trans_len == CALIPER_FRAME_BITS);
+    if (!complete && trans->trans_len > 0)
+    {
+        RECORD_ERROR(ERR_CALIPER_INVALID_DATA, "SPI frame has %u bits (expected %u)",
+            (unsigned)trans->trans_len, (unsigned)CALIPER_FRAME_BITS);
+        resync();
+    }
+    else if (complete && !spcDecodeReading(out.frame).valid)
+    {
+        // Most likely shifted by a lost or extra edge: align to the next gap
+        RECORD_ERROR(ERR_CALIPER_INVALID_DATA, "SPI frame is not BCD - resynchronising");
+        complete = false;
+        resync();
+    }
+    return slot;
+}
+
+bool SpcSpiCapture::waitFrame(SpcRawFrame &out, uint32_t timeoutMs)
+{
+    bool complete = false;
+    return fetch(out, complete, pdMS_TO_TICKS(timeoutMs)) != nullptr && complete;
+}
+
+bool SpcSpiCapture::pop(SpcRawFrame &out)
+{
+    bool complete = false;
+    Slot *slot;
+    while ((slot = fetch(out, complete, 0)) != nullptr)
+    {
+        queueSlot(*slot);
+        if (complete)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // defined(SPC) && defined(SPC_CAPTURE_SPI)
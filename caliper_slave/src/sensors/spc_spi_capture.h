@@ -0,0 +1,124 @@
+/**
+ * @file spc_spi_capture.h
+ * @brief SPI-slave DMA capture backend for the SPC caliper interface
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Frame end on the 52nd rising edge, capture starts after an idle gap
+ *
+ * @details
+ * Alternative to the per-bit GPIO interrupt in CaliperInterface::clockISR().
+ * Selected with the SPC_CAPTURE_SPI build flag (together with SPC).
+ *
+ * The caliper CLOCK/DATA lines are routed through the GPIO matrix into the
+ * FSPI (SPI2) peripheral running as an SPI slave with DMA:
+ * - SCLK <- CLOCK_PIN, MOSI <- DATA_PIN, mode 3 (DATA sampled on the rising
+ *   edge that ends each clock-low phase, the window the ISR used to read in)
+ * - bits are stored LSB-first, so the 8-byte DMA buffer read as a
+ *   little-endian uint64_t is exactly the packed frame the decoder expects
+ *
+ * Frame boundaries come from a PCNT unit counting rising CLOCK edges (the
+ * edges the SPI slave samples on) in hardware. Its watch point at
+ * CALIPER_FRAME_BITS fires after the 52nd bit was sampled and releases the
+ * slave CS input (switched between constant-0 and constant-1 in the GPIO
+ * matrix, no pad involved), which completes the SPI transaction. The next
+ * queued transaction re-asserts CS from post_setup_cb. The CPU therefore
+ * sees two interrupts per 52-bit frame instead of 52.
+ *
+ * Frame alignment: CS is only asserted once CLOCK was idle for a whole
+ * SPC_FRAME_GAP_US, like the inter-frame gap rule of SpcFrameSync. arm()
+ * and any incomplete or non-BCD frame start an esp_timer that compares the
+ * PCNT count over one gap period; an unchanged count means the line is
+ * between frames, so the count is cleared and CS asserted. A capture armed
+ * in the middle of a frame therefore starts with the next whole frame.
+ */
+
+#ifndef SPC_SPI_CAPTURE_H
+#define SPC_SPI_CAPTURE_H
+
+#if defined(SPC) && defined(SPC_CAPTURE_SPI)
+
+#include <Arduino.h>
+#include <driver/spi_slave.h>
+#include <driver/pulse_cnt.h>
+#include <esp_timer.h>
+#include "../config.h"
+#include "spc_decoder.h"
+
+class SpcSpiCapture {
+public:
+    /**
+     * @brief Initialize SPI slave, DMA and the frame-boundary counter
+     * @return true on success
+     *
+     * Possible errors:
+     * - ERR_CALIPER_HARDWARE_FAILURE: SPI slave or PCNT could not be configured
+     */
+    bool begin();
+
+    /**
+     * @brief Queue receive transactions and start counting clock edges
+     * @param depth Number of frames queued ahead (1 for one-shot capture)
+     */
+    void arm(uint8_t depth);
+
+    /**
+     * @brief Abort pending transactions and stop counting
+     */
+    void disarm();
+
+    /**
+     * @brief Wait for the next completed frame
+     * @param out Receives packed frame and completion timestamp
+     * @param timeoutMs Maximum wait time
+     * @return true if a complete 52-bit frame was received
+     */
+    bool waitFrame(SpcRawFrame &out, uint32_t timeoutMs);
+
+    /**
+     * @brief Fetch a completed frame without waiting (free-running mode)
+     * @details The transaction slot is re-queued immediately.
+     * @param out Receives packed frame and completion timestamp
+     * @return false if no frame is pending
+     */
+    bool pop(SpcRawFrame &out);
+
+private:
+    struct Slot {
+        spi_slave_transaction_t trans;
+        uint32_t timestampUs;
+    };
+
+    static constexpr uint8_t SLOT_COUNT = CALIPER_FRAME_RING_SIZE;
+
+    Slot slots[SLOT_COUNT] = {};
+    uint8_t queued = 0;
+    pcnt_unit_handle_t pcntUnit = nullptr;
+    pcnt_channel_handle_t pcntChannel = nullptr;
+    esp_timer_handle_t syncTimer = nullptr;
+    int syncCount = -1;                 // PCNT count at the previous sync check
+    bool initialized = false;
+
+    // Shared with the SPI/PCNT callbacks, which get no object pointer
+    static volatile bool synced;        // CLOCK idle gap seen, CS may be asserted
+    static volatile bool slotLoaded;    // A transaction waits for CS
+
+    static void IRAM_ATTR setChipSelect(bool asserted);
+    static void IRAM_ATTR onPostSetup(spi_slave_transaction_t *trans);
+    static void IRAM_ATTR onPostTransaction(spi_slave_transaction_t *trans);
+    static bool IRAM_ATTR onFrameBits(pcnt_unit_handle_t unit, const pcnt_watch_event_data_t *edata, void *userCtx);
+    static void onSyncTimer(void *arg);
+
+    /**
+     * @brief Release CS and wait for the next idle gap before capturing again
+     */
+    void resync();
+
+    Slot *fetch(SpcRawFrame &out, bool &complete, TickType_t ticks);
+    void queueSlot(Slot &slot);
+};
+
+#endif // defined(SPC) && defined(SPC_CAPTURE_SPI)
+
+#endif // SPC_SPI_CAPTURE_H
@@ -0,0 +1,27 @@
+/**
+ * @file tilt_kernel.cpp
+ * @brief Fixed-cost tilt angles from raw accelerometer counts
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.0 - Initial implementation
+ * @version 1.1 - Golden vectors moved to test/test_tilt_kernel
+ */
+
+#include "tilt_kernel.h"
+
+#include <math.h>
+
+TiltAngles tiltFromCounts(int32_t x, int32_t y, int32_t z)
+{
+    const float fx = (float)x;
+    const float fy = (float)y;
+    const float fz = (float)z;
+
+    TiltAngles angles;
+    angles.x = tiltAtan2Deg(fy, fz);
+    angles.y = tiltAtan2Deg(-fx, sqrtf(fy * fy + fz * fz));
+    angles.z = tiltAtan2Deg(sqrtf(fx * fx + fy * fy), fabsf(fz));
+    return angles;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file tilt_kernel.h
+ * @brief Fixed-cost tilt angles from raw accelerometer counts
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Replaces the double-promoting atan2()/sqrt()/acos() chain of the
+ * accelerometer with single-precision float only:
+ * - atan2 is reduced to one octant (|t| <= 1, one division) and evaluated
+ *   with a 9th-order odd polynomial (Abramowitz & Stegun 4.4.47,
+ *   |error| <= 1e-5 rad = 0.0006°), the degree scaling folded into the
+ *   coefficients;
+ * - acos(|z| / |v|) is computed as atan2(sqrt(x² + y²), |z|), which is the
+ *   same angle without the magnitude or the acos.
+ *
+ * Including float rounding of the inputs (int32 counts, window sums up to
+ * 2^24 are exact) the error of every angle is well below the required
+ * 0.05°; test/test_tilt_kernel checks it against libm over the full sphere
+ * on the host, benchTilt() on the target.
+ *
+ * The angles are scale-invariant, so the counts may be raw samples or sums
+ * over an averaging window. No Arduino dependency; builds on the host.
+ */
+
+#ifndef TILT_KERNEL_H
+#define TILT_KERNEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief Tilt angles in degrees, same definitions as AccelerometerInterface
+ */
+struct TiltAngles {
+    float x;    /**< Roll: atan2(y, z), -180..180 */
+    float y;    /**< Pitch: atan2(-x, sqrt(y² + z²)), -90..90 */
+    float z;    /**< Inclination from vertical: acos(|z| / |v|), 0..90 */
+};
+
+/**
+ * @brief atan2(y, x) in degrees, single precision, |error| <= 0.001°
+ * @return -180..180; 0 for (0, 0)
+ */
+constexpr float tiltAtan2Deg(float y, float x)
+{
+    // A&S 4.4.47 coefficients times 180/pi
+    constexpr float A1 = 0.9998660f * 57.29577951f;
+    constexpr float A3 = -0.3302995f * 57.29577951f;
+    constexpr float A5 = 0.1801410f * 57.29577951f;
+    constexpr float A7 = -0.0851330f * 57.29577951f;
+    constexpr float A9 = 0.0208351f * 57.29577951f;
+
+    const float ax = x < 0.0f ? -x : x;
+    const float ay = y < 0.0f ? -y : y;
+    if (ax == 0.0f && ay == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    // Reduce to t = min / max in [0, 1]
+    const bool steep = ay > ax;
+    const float t = steep ? ax / ay : ay / ax;
+    const float s = t * t;
+    float angle = t * (A1 + s * (A3 + s * (A5 + s * (A7 + s * A9))));
+
+    if (steep) angle = 90.0f - angle;
+    if (x < 0.0f) angle = 180.0f - angle;
+    return y < 0.0f ? -angle : angle;
+}
+
+/**
+ * @brief All three tilt angles from one vector of counts
+ */
+TiltAngles tiltFromCounts(int32_t x, int32_t y, int32_t z);
+
+#endif // TILT_KERNEL_H
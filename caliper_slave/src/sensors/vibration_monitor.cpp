@@ -0,0 +1,83 @@
+/**
+ * @file vibration_monitor.cpp
+ * @brief Rolling RMS / peak of the high-pass filtered acceleration
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ */
+
+#include "vibration_monitor.h"
+
+#include <math.h>
+
+void VibrationMonitor::configure(float sampleRateHz, float cutoffHz, uint16_t windowSamples, float scale)
+{
+    // y[n] = a * (y[n-1] + x[n] - x[n-1]), a = RC / (RC + dt)
+    const float rc = 1.0f / (2.0f * (float)M_PI * cutoffHz);
+    const float dt = 1.0f / sampleRateHz;
+    alpha = rc / (rc + dt);
+    mgPerCount = scale;
+
+    if (windowSamples < 1) windowSamples = 1;
+    if (windowSamples > VIB_MAX_WINDOW) windowSamples = VIB_MAX_WINDOW;
+    window = windowSamples;
+
+    reset();
+}
+
+void VibrationMonitor::reset()
+{
+    primed = false;
+    hpX = hpY = hpZ = 0.0f;
+    next = 0;
+    filled = 0;
+    published.clear();
+}
+
+void VibrationMonitor::feed(int16_t x, int16_t y, int16_t z, uint32_t timestampMs)
+{
+    const float fx = x * mgPerCount;
+    const float fy = y * mgPerCount;
+    const float fz = z * mgPerCount;
+
+    // The first vector only seeds the filter, so gravity is not a step
+    if (!primed)
+    {
+        prevX = fx;
+        prevY = fy;
+        prevZ = fz;
+        primed = true;
+        return;
+    }
+
+    hpX = alpha * (hpX + fx - prevX);
+    hpY = alpha * (hpY + fy - prevY);
+    hpZ = alpha * (hpZ + fz - prevZ);
+    prevX = fx;
+    prevY = fy;
+    prevZ = fz;
+
+    squared[next] = hpX * hpX + hpY * hpY + hpZ * hpZ;
+    stamps[next] = timestampMs;
+    next = (next + 1 == window) ? 0 : next + 1;
+    if (filled < window)
+    {
+        filled++;
+        if (filled < window)
+        {
+            return;
+        }
+    }
+
+    // Full rescan instead of running sums: no drift, at most VIB_MAX_WINDOW MACs
+    float sum = 0.0f;
+    float peak = 0.0f;
+    for (uint16_t i = 0; i < window; i++)
+    {
+        sum += squared[i];
+        if (squared[i] > peak) peak = squared[i];
+    }
+
+    // The window is full: next is the slot of the oldest sample
+    published.push({sqrtf(sum / window), sqrtf(peak), timestampMs, stamps[next]});
+}
@@ -0,0 +1,93 @@
+/**
+ * @file vibration_monitor.h
+ * @brief Rolling RMS / peak of the high-pass filtered acceleration
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @details
+ * Fed with every raw accelerometer vector by the sampler task. Each axis
+ * goes through a first-order high-pass filter, which removes gravity and the
+ * static tilt and leaves the vibration of the fixture. The RMS and the peak
+ * of the filtered magnitude over the newest `window` samples are published
+ * after every sample; level() can be called from any task.
+ *
+ * A level is published only once a full window has been filtered since
+ * reset(), so the filter start-up never looks like a quiet fixture.
+ *
+ * No Arduino dependency; builds on the host.
+ *
+ * @version 1.0 - Initial implementation
+ * @version 1.1 - windowStartMs: lets the caller ignore windows from before an event
+ */
+
+#ifndef VIBRATION_MONITOR_H
+#define VIBRATION_MONITOR_H
+
+#include <stdint.h>
+#include <overwrite_ring.h>
+
+/**
+ * @brief Maximum window supported by VibrationMonitor
+ */
+#define VIB_MAX_WINDOW 128
+
+/**
+ * @brief Vibration over the newest window
+ */
+struct VibrationLevel {
+    float rmsMg;            /**< RMS of the filtered magnitude in mg */
+    float peakMg;           /**< Largest filtered magnitude in mg */
+    uint32_t timestampMs;   /**< Timestamp of the newest sample */
+    uint32_t windowStartMs; /**< Timestamp of the oldest sample in the window */
+};
+
+class VibrationMonitor {
+public:
+    /**
+     * @brief Set the filter and window (only while not fed), resets the state
+     * @param sampleRateHz Rate of feed() calls
+     * @param cutoffHz High-pass -3 dB frequency
+     * @param windowSamples Samples per RMS / peak window, 1..VIB_MAX_WINDOW
+     * @param scale Raw count to mg factor
+     */
+    void configure(float sampleRateHz, float cutoffHz, uint16_t windowSamples, float scale);
+
+    /**
+     * @brief Forget the filter state and the window
+     */
+    void reset();
+
+    /**
+     * @brief Add one raw vector (producer side)
+     */
+    void feed(int16_t x, int16_t y, int16_t z, uint32_t timestampMs);
+
+    /**
+     * @brief Newest published level (any task)
+     * @return false until a full window has been filtered
+     */
+    bool level(VibrationLevel &out) const { return published.latest(0, out); }
+
+private:
+    float alpha = 1.0f;
+    float mgPerCount = 1.0f;
+    uint16_t window = 1;
+
+    bool primed = false;
+    float prevX = 0.0f;
+    float prevY = 0.0f;
+    float prevZ = 0.0f;
+    float hpX = 0.0f;
+    float hpY = 0.0f;
+    float hpZ = 0.0f;
+
+    float squared[VIB_MAX_WINDOW] = {};  /**< Filtered magnitude^2 in mg^2, ring */
+    uint32_t stamps[VIB_MAX_WINDOW] = {}; /**< Timestamps of squared[] */
+    uint16_t next = 0;
+    uint16_t filled = 0;
+
+    OverwriteRing<VibrationLevel, 4> published;
+};
+
+#endif // VIBRATION_MONITOR_H
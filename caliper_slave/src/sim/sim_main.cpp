@@ -0,0 +1,95 @@
+/**
+ * @file sim_main.cpp
+ * @brief Host load test of the measurement pipeline with SimulatedSensor
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Excluded from `pio test` builds
+ *
+ * @details
+ * Entry point of env:native_sim (platform = native). Runs a series of
+ * reliable measurements through SimulatedSensor and the consensus engine
+ * for each strategy and prints acquisition statistics.
+ *
+ * Usage: program [measurements] [failure_rate] [noise_mm]
+ *
+ * Left out of `pio test -e native_sim`, where each test brings its own main().
+ */
+
+#if defined(SIM_HOST) && !defined(PIO_UNIT_TESTING)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../sensors/simulated_sensor.h"
+
+static_assert(isLengthSensor<SimulatedSensor>(), "SimulatedSensor does not implement LengthSensor");
+
+struct StrategyCase {
+    const char *name;
+    ConsensusConfig config;
+};
+
+static void runCase(const StrategyCase &c, const SimulatedSensorConfig &simConfig, unsigned count)
+{
+    SimulatedSensor sensor;
+    sensor.setConfig(simConfig);
+    sensor.setConsensusConfig(c.config);
+    sensor.begin();
+
+    unsigned ok = 0;
+    unsigned long attempts = 0;
+    unsigned long elapsed = 0;
+    uint32_t maxElapsed = 0;
+    float maxError = 0.0f;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        const float value = sensor.performReliableMeasurement();
+        const ConsensusResult &r = sensor.getLastConsensus();
+
+        attempts += r.attempts;
+        elapsed += r.elapsedMs;
+        if (r.elapsedMs > maxElapsed) maxElapsed = r.elapsedMs;
+
+        if (value != INVALID_MEASUREMENT_VALUE)
+        {
+            ok++;
+            const float error = value > simConfig.nominalMm ? value - simConfig.nominalMm : simConfig.nominalMm - value;
+            if (error > maxError) maxError = error;
+        }
+    }
+
+    printf("%-16s ok=%3u/%-3u attempts avg=%5.2f  elapsed avg=%6.1f max=%4u ms  max|err|=%.4f mm\n",
+        c.name, ok, count, (double)attempts / count, (double)elapsed / count,
+        (unsigned)maxElapsed, (double)maxError);
+}
+
+int main(int argc, char **argv)
+{
+    const unsigned count = argc > 1 ? (unsigned)atoi(argv[1]) : 100;
+
+    SimulatedSensorConfig simConfig = SIM_DEFAULT_CONFIG;
+    if (argc > 2) simConfig.failureRate = (float)atof(argv[2]);
+    if (argc > 3) simConfig.noiseMm = (float)atof(argv[3]);
+
+    const uint32_t timeout = RELIABLE_MEASUREMENT_TIMEOUT_MS;
+    const StrategyCase cases[] = {
+        {"2-of-2 exact",   {ConsensusStrategy::K_OF_M, 2, 2, 0, 0.0f, timeout}},
+        {"3-of-5 +-2um",   {ConsensusStrategy::K_OF_M, 3, 5, 0, 0.002f, timeout}},
+        {"median-5",       {ConsensusStrategy::MEDIAN, 0, 5, 0, 0.0f, timeout}},
+        {"trimmed-7/1",    {ConsensusStrategy::TRIMMED_MEAN, 0, 7, 1, 0.0f, timeout}},
+    };
+
+    printf("SimulatedSensor: %u measurements, nominal=%.3f mm noise=%.4f mm latency=%u+%u ms failure=%.2f\n",
+        count, (double)simConfig.nominalMm, (double)simConfig.noiseMm,
+        (unsigned)simConfig.latencyMs, (unsigned)simConfig.jitterMs, (double)simConfig.failureRate);
+
+    for (const StrategyCase &c : cases)
+    {
+        runCase(c, simConfig, count);
+    }
+    return 0;
+}
+
+#endif // defined(SIM_HOST) && !defined(PIO_UNIT_TESTING)
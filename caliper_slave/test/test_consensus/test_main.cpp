@@ -0,0 +1,188 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: N-of-M consensus engine
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Feeds scripted reading sequences to ConsensusEngine and runConsensus()
+ * with an injected clock: each strategy's decision point and value, the
+ * handling of invalid readings, the sliding window, parameter clamping
+ * and the timeout path.
+ *
+ * Run: pio test -e native_sim -f test_consensus
+ */
+
+#include <unity.h>
+
+#include "../../src/sensors/consensus.h"
+
+static const uint32_t TIMEOUT_MS = 1000;
+
+/**
+ * @brief Feed readings until the engine decides
+ * @return 1-based index of the deciding reading, 0 if none decided
+ */
+static int feed(ConsensusEngine &engine, const float *readings, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (engine.add(readings[i]))
+        {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_two_identical_readings(void)
+{
+    ConsensusEngine engine; // Default: 2-of-2, exact
+    const float readings[] = {10.000f, 10.010f, 10.010f};
+    TEST_ASSERT_EQUAL(3, feed(engine, readings, 3));
+    TEST_ASSERT_EQUAL_FLOAT(10.010f, engine.value());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, engine.spread());
+    TEST_ASSERT_EQUAL(3, engine.attempts());
+}
+
+void test_window_slides(void)
+{
+    // 2-of-2: the first 1.0 has left the window when the second one arrives
+    ConsensusEngine engine;
+    const float readings[] = {1.0f, 2.0f, 1.0f, 3.0f};
+    TEST_ASSERT_EQUAL(0, feed(engine, readings, 4));
+}
+
+void test_invalid_readings_count_as_attempts_only(void)
+{
+    ConsensusEngine engine;
+    const float readings[] = {5.0f, INVALID_MEASUREMENT_VALUE, INVALID_MEASUREMENT_VALUE, 5.0f};
+    TEST_ASSERT_EQUAL(4, feed(engine, readings, 4));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, engine.value());
+    TEST_ASSERT_EQUAL(4, engine.attempts());
+}
+
+void test_k_of_m_with_tolerance(void)
+{
+    ConsensusEngine engine({ConsensusStrategy::K_OF_M, 3, 5, 0, 0.0025f, TIMEOUT_MS});
+    const float readings[] = {5.000f, 5.100f, 5.001f, 4.900f, 5.002f};
+    TEST_ASSERT_EQUAL(5, feed(engine, readings, 5));
+    TEST_ASSERT_EQUAL_FLOAT(5.001f, engine.value()); // Median of the cluster, outliers ignored
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.002f, engine.spread());
+}
+
+void test_k_of_m_exits_early(void)
+{
+    ConsensusEngine engine({ConsensusStrategy::K_OF_M, 3, 5, 0, 0.0f, TIMEOUT_MS});
+    const float readings[] = {7.0f, 7.0f, 7.0f};
+    TEST_ASSERT_EQUAL(3, feed(engine, readings, 3));
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, engine.value());
+}
+
+void test_median_waits_for_full_window(void)
+{
+    ConsensusEngine odd({ConsensusStrategy::MEDIAN, 0, 5, 0, 0.0f, TIMEOUT_MS});
+    const float five[] = {1.0f, 5.0f, 2.0f, 4.0f, 3.0f};
+    TEST_ASSERT_EQUAL(5, feed(odd, five, 5));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, odd.value());
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, odd.spread());
+
+    ConsensusEngine even({ConsensusStrategy::MEDIAN, 0, 4, 0, 0.0f, TIMEOUT_MS});
+    const float four[] = {1.0f, 2.0f, 3.0f, 4.0f};
+    TEST_ASSERT_EQUAL(4, feed(even, four, 4));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, even.value());
+}
+
+void test_median_tolerance_keeps_sliding(void)
+{
+    ConsensusEngine engine({ConsensusStrategy::MEDIAN, 0, 3, 0, 0.015f, TIMEOUT_MS});
+    const float readings[] = {9.0f, 10.00f, 10.01f, 10.00f};
+    TEST_ASSERT_EQUAL(4, feed(engine, readings, 4));
+    TEST_ASSERT_EQUAL_FLOAT(10.00f, engine.value());
+}
+
+void test_trimmed_mean(void)
+{
+    ConsensusEngine engine({ConsensusStrategy::TRIMMED_MEAN, 0, 5, 1, 0.0f, TIMEOUT_MS});
+    const float readings[] = {100.0f, 2.0f, 3.0f, 4.0f, -50.0f};
+    TEST_ASSERT_EQUAL(5, feed(engine, readings, 5));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, engine.value());
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, engine.spread());
+}
+
+void test_configuration_is_clamped(void)
+{
+    // m = 0 -> 1, k > m -> m: the first valid reading decides
+    ConsensusEngine single({ConsensusStrategy::K_OF_M, 4, 0, 0, 0.0f, TIMEOUT_MS});
+    TEST_ASSERT_TRUE(single.add(1.5f));
+
+    // trim too large for the window -> (m - 1) / 2, the median remains
+    ConsensusEngine trimmed({ConsensusStrategy::TRIMMED_MEAN, 0, 3, 5, 0.0f, TIMEOUT_MS});
+    const float readings[] = {1.0f, 2.0f, 9.0f};
+    TEST_ASSERT_EQUAL(3, feed(trimmed, readings, 3));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, trimmed.value());
+
+    // m above CONSENSUS_MAX_WINDOW -> CONSENSUS_MAX_WINDOW
+    ConsensusEngine wide({ConsensusStrategy::MEDIAN, 0, 200, 0, 0.0f, TIMEOUT_MS});
+    int decidedAt = 0;
+    for (int i = 1; i <= 2 * CONSENSUS_MAX_WINDOW && decidedAt == 0; i++)
+    {
+        if (wide.add(1.0f)) decidedAt = i;
+    }
+    TEST_ASSERT_EQUAL(CONSENSUS_MAX_WINDOW, decidedAt);
+}
+
+void test_run_consensus_success(void)
+{
+    const float readings[] = {INVALID_MEASUREMENT_VALUE, 3.2f, 3.3f, 3.3f};
+    int next = 0;
+    uint32_t now = 0;
+
+    const ConsensusResult r = runConsensus(
+        {ConsensusStrategy::K_OF_M, 2, 2, 0, 0.0f, TIMEOUT_MS},
+        [&]() { now += 20; return readings[next++]; },
+        [&]() { return now; });
+
+    TEST_ASSERT_TRUE(r.ok);
+    TEST_ASSERT_EQUAL_FLOAT(3.3f, r.value);
+    TEST_ASSERT_EQUAL(4, r.attempts);
+    TEST_ASSERT_EQUAL_UINT32(80, r.elapsedMs);
+}
+
+void test_run_consensus_timeout(void)
+{
+    uint32_t now = 0xFFFFFF00u; // Clock wraps during the run
+    int reads = 0;
+
+    const ConsensusResult r = runConsensus(
+        {ConsensusStrategy::K_OF_M, 2, 2, 0, 0.0f, 100},
+        [&]() { now += 30; reads++; return INVALID_MEASUREMENT_VALUE; },
+        [&]() { return now; });
+
+    TEST_ASSERT_FALSE(r.ok);
+    TEST_ASSERT_EQUAL_FLOAT(INVALID_MEASUREMENT_VALUE, r.value);
+    TEST_ASSERT_EQUAL(4, reads);
+    TEST_ASSERT_EQUAL(4, r.attempts);
+    TEST_ASSERT_EQUAL_UINT32(120, r.elapsedMs);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_two_identical_readings);
+    RUN_TEST(test_window_slides);
+    RUN_TEST(test_invalid_readings_count_as_attempts_only);
+    RUN_TEST(test_k_of_m_with_tolerance);
+    RUN_TEST(test_k_of_m_exits_early);
+    RUN_TEST(test_median_waits_for_full_window);
+    RUN_TEST(test_median_tolerance_keeps_sliding);
+    RUN_TEST(test_trimmed_mean);
+    RUN_TEST(test_configuration_is_clamped);
+    RUN_TEST(test_run_consensus_success);
+    RUN_TEST(test_run_consensus_timeout);
+    return UNITY_END();
+}
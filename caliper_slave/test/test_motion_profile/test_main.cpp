@@ -0,0 +1,177 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: trapezoidal MotionProfile over random strokes
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * The golden vectors stay as static_asserts in motion_profile.cpp. This
+ * test sweeps random strokes (cruise and end PWM, ramps, duration) from a
+ * fixed seed, millisecond by millisecond the way the esp_timer executor
+ * samples them, and checks the properties motorCtrlRunProfile() relies
+ * on: no duty jumps, never above cruise, the end PWM once both durationMs
+ * and accelMs have passed, finished() only once the duty is constant, and
+ * consistent segments.
+ *
+ * Run: pio test -e native_sim -f test_motion_profile
+ */
+
+#include <unity.h>
+#include <string.h>
+
+#include "../../src/motor/motion_profile.h"
+
+#define RANDOM_STROKES 2000
+
+static uint32_t rngState;
+
+static uint32_t rng()
+{
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+struct Stroke {
+    uint8_t cruise;
+    uint8_t end;
+    uint16_t accel;
+    uint16_t decel;
+    uint32_t duration;
+};
+
+static Stroke randomStroke(bool openEnded)
+{
+    Stroke s;
+    s.cruise = (uint8_t)(rng() % 256);
+    s.end = (uint8_t)(rng() % 256);
+    s.accel = (uint16_t)(rng() % 4 == 0 ? 0 : rng() % 800);
+    s.decel = (uint16_t)(rng() % 4 == 0 ? 0 : rng() % 800);
+    s.duration = openEnded ? MOTION_PROFILE_OPEN_ENDED : 1 + rng() % 2000;
+    return s;
+}
+
+/**
+ * @brief Largest duty change allowed between consecutive ms on a ramp
+ */
+static uint32_t rampStep(uint8_t span, uint16_t rampMs)
+{
+    return rampMs == 0 ? 255 : (span + rampMs - 1) / rampMs + 1;
+}
+
+static void checkStroke(const Stroke &s)
+{
+    const MotionProfile p(s.cruise, s.end, s.accel, s.decel, s.duration);
+    const uint8_t end = s.end < s.cruise ? s.end : s.cruise;
+    const bool open = s.duration == MOTION_PROFILE_OPEN_ENDED;
+    const uint32_t settled = (open || s.accel > s.duration) ? s.accel : s.duration;
+    const uint32_t horizon = settled + 200;
+    const uint32_t maxStep = rampStep(s.cruise, s.accel) > rampStep(s.cruise - end, s.decel)
+        ? rampStep(s.cruise, s.accel) : rampStep(s.cruise - end, s.decel);
+
+    TEST_ASSERT_EQUAL_UINT8(open ? s.cruise : end, p.finalPwm());
+    if (s.accel > 0)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0, p.pwmAt(0));
+    }
+
+    uint8_t previous = p.pwmAt(0);
+    for (uint32_t t = 0; t <= horizon; t++)
+    {
+        const uint8_t pwm = p.pwmAt(t);
+        TEST_ASSERT_TRUE(pwm <= s.cruise);
+        if (t > 0 && s.accel > 0 && (s.decel > 0 || open))
+        {
+            const uint32_t step = pwm > previous ? pwm - previous : previous - pwm;
+            TEST_ASSERT_TRUE(step <= maxStep);
+        }
+        if (!open && t >= s.duration)
+        {
+            TEST_ASSERT_TRUE(pwm <= end);   // Still ramping up if accelMs > durationMs
+            TEST_ASSERT_TRUE(p.segmentAt(t) == MotionSegment::HOLD);
+        }
+        if (t >= settled)
+        {
+            TEST_ASSERT_EQUAL_UINT8(p.finalPwm(), pwm);
+        }
+        if (p.finished(t))
+        {
+            TEST_ASSERT_EQUAL_UINT8(p.finalPwm(), pwm);
+            TEST_ASSERT_TRUE(p.finished(t + 1));
+        }
+        if (p.segmentAt(t) == MotionSegment::CRUISE)
+        {
+            TEST_ASSERT_EQUAL_UINT8(s.cruise, pwm);
+        }
+        previous = pwm;
+    }
+    TEST_ASSERT_TRUE(p.finished(horizon));
+}
+
+void setUp(void)
+{
+    rngState = 0x2545F491u;
+}
+
+void tearDown(void) {}
+
+void test_random_strokes(void)
+{
+    for (int i = 0; i < RANDOM_STROKES; i++)
+    {
+        checkStroke(randomStroke(false));
+    }
+}
+
+void test_random_open_ended_strokes(void)
+{
+    for (int i = 0; i < RANDOM_STROKES / 4; i++)
+    {
+        const Stroke s = randomStroke(true);
+        checkStroke(s);
+        const MotionProfile p(s.cruise, s.end, s.accel, s.decel, s.duration);
+        TEST_ASSERT_EQUAL_UINT8(s.cruise, p.pwmAt(s.accel + 100000));
+    }
+}
+
+void test_ramp_is_monotonic(void)
+{
+    const MotionProfile p(255, 40, 300, 250, 1500);
+    for (uint32_t t = 1; t <= 300; t++)
+    {
+        TEST_ASSERT_TRUE(p.pwmAt(t) >= p.pwmAt(t - 1));
+    }
+    for (uint32_t t = 1251; t <= 1500; t++)
+    {
+        TEST_ASSERT_TRUE(p.pwmAt(t) <= p.pwmAt(t - 1));
+    }
+    TEST_ASSERT_EQUAL_UINT8(40, p.pwmAt(1500));
+}
+
+void test_default_profile_is_stopped(void)
+{
+    const MotionProfile p;
+    TEST_ASSERT_EQUAL_UINT8(0, p.pwmAt(0));
+    TEST_ASSERT_EQUAL_UINT8(0, p.finalPwm());
+    TEST_ASSERT_TRUE(p.finished(0));
+}
+
+void test_segment_names(void)
+{
+    TEST_ASSERT_EQUAL_STRING("accel", motionSegmentName(MotionSegment::ACCEL));
+    TEST_ASSERT_EQUAL_STRING("cruise", motionSegmentName(MotionSegment::CRUISE));
+    TEST_ASSERT_EQUAL_STRING("decel", motionSegmentName(MotionSegment::DECEL));
+    TEST_ASSERT_EQUAL_STRING("hold", motionSegmentName(MotionSegment::HOLD));
+    TEST_ASSERT_EQUAL_STRING("unknown", motionSegmentName((MotionSegment)99));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_random_strokes);
+    RUN_TEST(test_random_open_ended_strokes);
+    RUN_TEST(test_ramp_is_monotonic);
+    RUN_TEST(test_default_profile_is_stopped);
+    RUN_TEST(test_segment_names);
+    return UNITY_END();
+}
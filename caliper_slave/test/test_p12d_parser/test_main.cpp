@@ -0,0 +1,250 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: randomized check of P12dParser against strtod()
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Generates random P12D position lines (sign, 1..6 integer digits, 0..6
+ * decimals, optional mm/in unit, blanks, CR/LF/CRLF) from a fixed seed.
+ * Every line must parse to the exact integer reference value and agree
+ * with strtod() to the micrometre, and replacing any single character by
+ * one outside the number alphabet (digits, blanks, sign, point) must make
+ * the line INVALID. The golden vectors stay as static_asserts in
+ * p12d_parser.cpp; cycle counts stay in benchP12dParser() on the target.
+ *
+ * Run: pio test -e native_sim -f test_p12d_parser
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../../src/sensors/p12d_parser.h"
+
+#define FUZZ_LINES 20000
+#define LINE_SIZE 40
+
+static uint32_t rngState;
+
+static uint32_t rng()
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct Line {
+    char text[LINE_SIZE];
+    size_t bodyLength;      /**< Characters before the terminator */
+    bool inch;
+    bool inRange;           /**< false: the parser must report OUT_OF_RANGE */
+    int32_t micrometers;    /**< Reference value (integer arithmetic) */
+};
+
+/**
+ * @brief Random line and its reference value, rounded half away from zero
+ */
+static Line randomLine()
+{
+    Line line = {};
+    const int intDigits = 1 + rng() % P12D_MAX_INT_DIGITS;
+    const int fracDigits = rng() % (P12D_MAX_FRAC_DIGITS + 1);
+    const int sign = rng() % 3;
+    const int unit = rng() % 5;
+
+    size_t n = 0;
+    for (int i = rng() % 3; i > 0; i--) line.text[n++] = ' ';
+    if (sign == 1) line.text[n++] = '+';
+    if (sign == 2) line.text[n++] = '-';
+
+    int64_t mantissa = 0;
+    for (int i = 0; i < intDigits; i++)
+    {
+        const int d = rng() % 10;
+        mantissa = mantissa * 10 + d;
+        line.text[n++] = (char)('0' + d);
+    }
+    if (fracDigits > 0)
+    {
+        line.text[n++] = '.';
+    }
+    for (int i = 0; i < fracDigits; i++)
+    {
+        const int d = rng() % 10;
+        mantissa = mantissa * 10 + d;
+        line.text[n++] = (char)('0' + d);
+    }
+
+    static const char *const UNITS[] = {"", " mm", "mm", " in", "in"};
+    n += snprintf(line.text + n, LINE_SIZE - n, "%s", UNITS[unit]);
+    for (int i = rng() % 3; i > 0; i--) line.text[n++] = ' ';
+    line.bodyLength = n;
+
+    static const char *const TERMINATORS[] = {"\r", "\n", "\r\n"};
+    snprintf(line.text + n, LINE_SIZE - n, "%s", TERMINATORS[rng() % 3]);
+
+    // mantissa * 10^(6 - fracDigits) is the value in 1e-6 units
+    int64_t scaled = mantissa;
+    for (int i = fracDigits; i < P12D_MAX_FRAC_DIGITS; i++)
+    {
+        scaled *= 10;
+    }
+    line.inch = unit >= 3;
+    const int64_t um = line.inch ? (scaled * 254 + 5000) / 10000 : (scaled + 500) / 1000;
+    line.inRange = um <= INT32_MAX;
+    line.micrometers = (int32_t)(sign == 2 ? -um : um);
+    return line;
+}
+
+/**
+ * @brief Feed a line and return the status of its terminator
+ */
+static P12dParseStatus parseLine(P12dParser &parser, const char *text)
+{
+    P12dParseStatus status = P12dParseStatus::PENDING;
+    for (const char *c = text; *c != '\0' && status == P12dParseStatus::PENDING; c++)
+    {
+        status = parser.feed(*c);
+    }
+    return status;
+}
+
+/**
+ * @brief Characters that can turn one valid line into another valid line
+ *        (e.g. "1234 mm" -> "12.4 mm"); not used as corruptions
+ */
+static bool mayBeValid(char c)
+{
+    return (c >= '0' && c <= '9') || c == ' ' || c == '+' || c == '-' || c == '.' || c == '\r' || c == '\n';
+}
+
+void setUp(void)
+{
+    rngState = 0x2545F491u;
+}
+
+void tearDown(void) {}
+
+void test_random_lines_match_reference(void)
+{
+    int outOfRange = 0;
+    for (int i = 0; i < FUZZ_LINES; i++)
+    {
+        const Line line = randomLine();
+        P12dParser parser;
+        const P12dParseStatus status = parseLine(parser, line.text);
+
+        if (!line.inRange)
+        {
+            TEST_ASSERT_EQUAL(P12dParseStatus::INVALID, status);
+            TEST_ASSERT_EQUAL(P12dParseError::OUT_OF_RANGE, parser.error());
+            outOfRange++;
+            continue;
+        }
+
+        TEST_ASSERT_EQUAL_MESSAGE(P12dParseStatus::VALUE, status, line.text);
+        TEST_ASSERT_EQUAL_INT32_MESSAGE(line.micrometers, parser.micrometers(), line.text);
+
+        // Legacy path: strtod() on the line, scaled to µm
+        const double legacy = strtod(line.text, nullptr) * (line.inch ? 25400.0 : 1000.0);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(1.0, legacy, (double)parser.micrometers(), line.text);
+    }
+    TEST_ASSERT_GREATER_THAN(0, outOfRange);
+}
+
+void test_single_character_corruption_is_rejected(void)
+{
+    for (int i = 0; i < FUZZ_LINES; i++)
+    {
+        const Line line = randomLine();
+        char corrupted[LINE_SIZE];
+        memcpy(corrupted, line.text, LINE_SIZE);
+
+        char replacement;
+        do
+        {
+            replacement = (char)(1 + rng() % 255);
+        } while (mayBeValid(replacement));
+
+        const size_t position = rng() % line.bodyLength;
+        if (corrupted[position] == replacement)
+        {
+            continue;
+        }
+        corrupted[position] = replacement;
+
+        P12dParser parser;
+        TEST_ASSERT_EQUAL_MESSAGE(P12dParseStatus::INVALID, parseLine(parser, corrupted), corrupted);
+    }
+}
+
+void test_parser_stays_aligned_after_garbage(void)
+{
+    // One parser for the whole run, as in onUartReceive(): a rejected line
+    // must not affect the next one
+    P12dParser parser;
+    for (int i = 0; i < FUZZ_LINES; i++)
+    {
+        char garbage[LINE_SIZE];
+        const size_t length = 1 + rng() % (LINE_SIZE - 2);
+        for (size_t k = 0; k < length; k++)
+        {
+            char c;
+            do
+            {
+                c = (char)(1 + rng() % 255);
+            } while (c == '\r' || c == '\n');
+            garbage[k] = c;
+        }
+        garbage[length] = '\r';
+        garbage[length + 1] = '\0';
+        parseLine(parser, garbage);
+
+        const Line line = randomLine();
+        if (!line.inRange)
+        {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_MESSAGE(P12dParseStatus::VALUE, parseLine(parser, line.text), line.text);
+        TEST_ASSERT_EQUAL_INT32(line.micrometers, parser.micrometers());
+        if (line.text[line.bodyLength] == '\r' && line.text[line.bodyLength + 1] == '\n')
+        {
+            TEST_ASSERT_EQUAL(P12dParseStatus::PENDING, parser.feed('\n')); // Blank line
+        }
+    }
+}
+
+void test_unterminated_line_finish(void)
+{
+    // readResponse() timeout path: finish() ends a line without terminator
+    for (int i = 0; i < FUZZ_LINES; i++)
+    {
+        const Line line = randomLine();
+        if (!line.inRange)
+        {
+            continue;
+        }
+        P12dParser parser;
+        for (size_t k = 0; k < line.bodyLength; k++)
+        {
+            TEST_ASSERT_EQUAL(P12dParseStatus::PENDING, parser.feed(line.text[k]));
+        }
+        TEST_ASSERT_EQUAL(P12dParseStatus::VALUE, parser.finish());
+        TEST_ASSERT_EQUAL_INT32(line.micrometers, parser.micrometers());
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_random_lines_match_reference);
+    RUN_TEST(test_single_character_corruption_is_rejected);
+    RUN_TEST(test_parser_stays_aligned_after_garbage);
+    RUN_TEST(test_unterminated_line_finish);
+    return UNITY_END();
+}
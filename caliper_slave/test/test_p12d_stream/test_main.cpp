@@ -0,0 +1,188 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: P12D continuous-output stream through P12dParser
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Streaming mode (RS485_CONTINUOUS_OUTPUT) hands every UART chunk to
+ * P12dParser byte by byte, exactly as onUartReceive() does. These tests
+ * replay a probe's continuous output with random chunk boundaries and
+ * check the guarantees of the streaming mode: lines split across chunks
+ * are parsed whole, output joined mid-line is skipped, and bad or
+ * overlong lines are counted without losing alignment.
+ *
+ * Run: pio test -e native_sim -f test_p12d_stream
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../src/sensors/p12d_parser.h"
+
+#define STREAM_SIZE 4096
+#define MAX_LINES 256
+
+static uint32_t rngState;
+
+static uint32_t rng()
+{
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+/**
+ * @brief Consumer side of the stream: values and bad lines in arrival order
+ */
+struct StreamSink {
+    P12dParser parser;
+    int32_t values[MAX_LINES];
+    int valueCount = 0;
+    int errors = 0;
+
+    void feed(const char *data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            const P12dParseStatus status = parser.feed(data[i]);
+            if (status == P12dParseStatus::VALUE && valueCount < MAX_LINES)
+            {
+                values[valueCount++] = parser.micrometers();
+            }
+            else if (status == P12dParseStatus::INVALID)
+            {
+                errors++;
+            }
+        }
+    }
+
+    /**
+     * @brief Deliver the stream in chunks of 1..maxChunk bytes
+     */
+    void feedChunked(const char *data, size_t length, size_t maxChunk)
+    {
+        while (length > 0)
+        {
+            size_t chunk = 1 + rng() % maxChunk;
+            if (chunk > length) chunk = length;
+            feed(data, chunk);
+            data += chunk;
+            length -= chunk;
+        }
+    }
+};
+
+/**
+ * @brief Continuous output of a moving probe: "±X.XXXX mm" lines, CR LF
+ * @param expected Receives the value of every line in µm
+ */
+static size_t buildStream(char *out, int32_t *expected, int lines)
+{
+    size_t length = 0;
+    int32_t um = 12345;
+    for (int i = 0; i < lines; i++)
+    {
+        um += (int32_t)(rng() % 201) - 100;
+        expected[i] = um;
+        const int32_t mag = um < 0 ? -um : um;
+        length += snprintf(out + length, STREAM_SIZE - length, "%c%d.%03d0 mm\r\n",
+            um < 0 ? '-' : '+', (int)(mag / 1000), (int)(mag % 1000));
+    }
+    return length;
+}
+
+void setUp(void)
+{
+    rngState = 0x2545F491u;
+}
+
+void tearDown(void) {}
+
+void test_chunk_boundaries_do_not_matter(void)
+{
+    static char stream[STREAM_SIZE];
+    int32_t expected[100];
+    const size_t length = buildStream(stream, expected, 100);
+
+    const size_t chunkSizes[] = {1, 3, 7, 64};
+    for (size_t maxChunk : chunkSizes)
+    {
+        StreamSink sink;
+        sink.feedChunked(stream, length, maxChunk);
+        TEST_ASSERT_EQUAL(100, sink.valueCount);
+        TEST_ASSERT_EQUAL(0, sink.errors);
+        for (int i = 0; i < 100; i++)
+        {
+            TEST_ASSERT_EQUAL_INT32(expected[i], sink.values[i]);
+        }
+    }
+}
+
+void test_join_in_the_middle_of_a_line(void)
+{
+    // startContinuous() skips up to the first terminator: a tail such as
+    // "45.6780 mm" must not be reported as 45.678 mm
+    static char stream[STREAM_SIZE];
+    int32_t expected[20];
+    const size_t length = buildStream(stream, expected, 20);
+
+    for (size_t offset = 1; offset < 12; offset++)
+    {
+        StreamSink sink;
+        sink.parser.skipLine();
+        sink.feedChunked(stream + offset, length - offset, 16);
+        TEST_ASSERT_EQUAL(0, sink.errors);
+        TEST_ASSERT_EQUAL(19, sink.valueCount);
+        TEST_ASSERT_EQUAL_INT32(expected[1], sink.values[0]);
+    }
+}
+
+void test_bad_lines_are_counted_and_realigned(void)
+{
+    const char stream[] =
+        "+1.0000 mm\r\n"
+        "+2.00#0 mm\r\n"                 // Corrupted character
+        "+123456789.0000 mm\r\n"         // Overlong
+        "+3.0000 mm\r\n"
+        "\r\n"                           // Blank line: no value, no error
+        "+4.0000 m\r\n"                  // Truncated unit
+        "+5.0000 mm\r\n";
+
+    StreamSink sink;
+    sink.feedChunked(stream, sizeof(stream) - 1, 5);
+
+    TEST_ASSERT_EQUAL(3, sink.valueCount);
+    TEST_ASSERT_EQUAL_INT32(1000, sink.values[0]);
+    TEST_ASSERT_EQUAL_INT32(3000, sink.values[1]);
+    TEST_ASSERT_EQUAL_INT32(5000, sink.values[2]);
+    TEST_ASSERT_EQUAL(3, sink.errors);
+}
+
+void test_long_garbage_burst(void)
+{
+    // Line noise without terminators for longer than any valid line
+    StreamSink sink;
+    char noise[300];
+    for (size_t i = 0; i < sizeof(noise); i++)
+    {
+        noise[i] = (char)(' ' + rng() % 90);
+    }
+    sink.feedChunked(noise, sizeof(noise), 32);
+    sink.feed("\r\n+7.5000 mm\r\n", 14);
+
+    TEST_ASSERT_EQUAL(1, sink.valueCount);
+    TEST_ASSERT_EQUAL_INT32(7500, sink.values[0]);
+    TEST_ASSERT_EQUAL(1, sink.errors);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_chunk_boundaries_do_not_matter);
+    RUN_TEST(test_join_in_the_middle_of_a_line);
+    RUN_TEST(test_bad_lines_are_counted_and_realigned);
+    RUN_TEST(test_long_garbage_burst);
+    return UNITY_END();
+}
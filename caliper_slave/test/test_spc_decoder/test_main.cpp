@@ -0,0 +1,131 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: golden vectors of the integer SPC decoder
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Frames are built from display digits and the flags nibble with the
+ * layout documented in spc_decoder.cpp, independently of the decoder's
+ * lookup table. Covers mm and inch mode, sign, header bits, full scale,
+ * non-BCD rejection and the float API boundary, plus a sweep over every
+ * displayable value.
+ *
+ * Run: pio test -e native_sim -f test_spc_decoder
+ */
+
+#include <unity.h>
+#include <math.h>
+
+#include "../../src/sensors/spc_decoder.h"
+
+static const int DIGIT0_BIT = CALIPER_FRAME_BITS - CALIPER_BIT_SHIFT - BITS_PER_NIBBLE;
+
+/**
+ * @brief Build a packed frame from display digits and the flags nibble
+ * @param counts Displayed value in thousandths (0..99999)
+ * @param flags Flags nibble (SPC_FLAG_NEGATIVE | SPC_FLAG_INCH)
+ * @param header Value for the 8 ignored header bits
+ */
+static uint64_t goldenFrame(uint32_t counts, uint8_t flags, uint8_t header = 0)
+{
+    uint64_t frame = (uint64_t)header << (CALIPER_FRAME_BITS - CALIPER_BIT_SHIFT);
+    for (int k = 0; k < CALIPER_DECIMAL_DIGITS; k++)
+    {
+        frame |= (uint64_t)(counts % 10) << (DIGIT0_BIT - k * BITS_PER_NIBBLE);
+        counts /= 10;
+    }
+    frame |= (uint64_t)flags << (DIGIT0_BIT - 6 * BITS_PER_NIBBLE);
+    return frame;
+}
+
+static uint64_t withDigit(uint64_t frame, int k, uint8_t nibble)
+{
+    const int shift = DIGIT0_BIT - k * BITS_PER_NIBBLE;
+    return (frame & ~(0x0FULL << shift)) | ((uint64_t)nibble << shift);
+}
+
+static void assertReading(uint64_t frame, int32_t micrometers, bool negative, bool inch)
+{
+    const SpcReading r = spcDecodeReading(frame);
+    TEST_ASSERT_TRUE(r.valid);
+    TEST_ASSERT_EQUAL_INT32(micrometers, r.micrometers);
+    TEST_ASSERT_EQUAL(negative, r.negative);
+    TEST_ASSERT_EQUAL(inch, r.inch);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_mm_values(void)
+{
+    assertReading(goldenFrame(0, 0), 0, false, false);
+    assertReading(goldenFrame(12345, 0), 12345, false, false);
+    assertReading(goldenFrame(99999, 0), 99999, false, false);
+}
+
+void test_header_bits_are_ignored(void)
+{
+    assertReading(goldenFrame(12345, 0, 0xFF), 12345, false, false);
+    assertReading(goldenFrame(12345, 0, 0xA5), 12345, false, false);
+}
+
+void test_negative_mm(void)
+{
+    assertReading(goldenFrame(12345, SPC_FLAG_NEGATIVE), -12345, true, false);
+    assertReading(goldenFrame(1, SPC_FLAG_NEGATIVE), -1, true, false);
+}
+
+void test_inch_is_rounded_to_um(void)
+{
+    assertReading(goldenFrame(1000, SPC_FLAG_INCH), 25400, false, true);
+    assertReading(goldenFrame(1234, SPC_FLAG_INCH), 31344, false, true);
+    assertReading(goldenFrame(99999, SPC_FLAG_INCH), 2539975, false, true);
+    assertReading(goldenFrame(500, SPC_FLAG_INCH | SPC_FLAG_NEGATIVE), -12700, true, true);
+}
+
+void test_non_bcd_digits_are_rejected(void)
+{
+    const uint64_t base = goldenFrame(12345, 0);
+    TEST_ASSERT_FALSE(spcDecodeReading(withDigit(base, 0, 0x0A)).valid);
+    TEST_ASSERT_FALSE(spcDecodeReading(withDigit(base, 1, 0x0B)).valid);
+    TEST_ASSERT_FALSE(spcDecodeReading(withDigit(base, 3, 0x0F)).valid);
+    TEST_ASSERT_FALSE(spcDecodeReading(withDigit(base, 4, 0x0C)).valid);
+    TEST_ASSERT_FALSE(spcDecodeReading(0xFFFFFFFFFFFFFULL).valid); // Line stuck high
+}
+
+void test_float_boundary(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(12.345f, spcDecodeFrame(goldenFrame(12345, 0)));
+    TEST_ASSERT_EQUAL_FLOAT(-0.001f, spcDecodeFrame(goldenFrame(1, SPC_FLAG_NEGATIVE)));
+    TEST_ASSERT_EQUAL_FLOAT(31.344f, spcDecodeFrame(goldenFrame(1234, SPC_FLAG_INCH)));
+    TEST_ASSERT_TRUE(isnan(spcDecodeFrame(withDigit(goldenFrame(0, 0), 2, 0x0E))));
+}
+
+void test_every_displayable_value(void)
+{
+    for (uint32_t counts = 0; counts <= 99999; counts++)
+    {
+        const SpcReading mm = spcDecodeReading(goldenFrame(counts, 0));
+        TEST_ASSERT_TRUE(mm.valid);
+        TEST_ASSERT_EQUAL_INT32((int32_t)counts, mm.micrometers);
+
+        const SpcReading in = spcDecodeReading(goldenFrame(counts, SPC_FLAG_INCH | SPC_FLAG_NEGATIVE));
+        TEST_ASSERT_TRUE(in.valid);
+        TEST_ASSERT_EQUAL_INT32(-(int32_t)lround(counts * 25.4), in.micrometers);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_mm_values);
+    RUN_TEST(test_header_bits_are_ignored);
+    RUN_TEST(test_negative_mm);
+    RUN_TEST(test_inch_is_rounded_to_um);
+    RUN_TEST(test_non_bcd_digits_are_rejected);
+    RUN_TEST(test_float_boundary);
+    RUN_TEST(test_every_displayable_value);
+    return UNITY_END();
+}
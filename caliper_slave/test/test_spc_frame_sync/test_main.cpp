@@ -0,0 +1,247 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: jitter and glitch harness for SpcFrameSync
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - Falling CLOCK edges, as sampled by clockISR()
+ *
+ * @details
+ * Generates CLOCK falling-edge timelines for random frames with a fixed
+ * seed and feeds them to SpcFrameSync the way clockISR() does. Timestamps
+ * are in µs, with the limits of the slave config.h (which needs Arduino.h
+ * and is not available on the host). Covers bit period jitter, glitches in
+ * both clock phases, truncated frames, surplus edges, capture started
+ * mid-frame and timestamp wrap-around.
+ *
+ * Run: pio test -e native_sim -f test_spc_frame_sync
+ */
+
+#include <unity.h>
+
+#include "../../src/sensors/spc_frame_sync.h"
+
+// SPC_MIN_BIT_PERIOD_US and SPC_FRAME_GAP_US of the slave config.h
+static const uint32_t SPC_MIN_BIT_PERIOD_US = 10;
+static const uint32_t SPC_FRAME_GAP_US = 2000;
+
+static const uint32_t BIT_PERIOD_US = 110;
+static const uint32_t FRAME_PAUSE_US = 80000;
+static const uint64_t FRAME_MASK = (1ULL << CALIPER_FRAME_BITS) - 1;
+
+static uint32_t rngState;
+
+static uint32_t rng()
+{
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+static uint64_t randomFrame()
+{
+    return (((uint64_t)rng() << 32) ^ rng()) & FRAME_MASK;
+}
+
+/**
+ * @brief Edge source: timeline of one capture session
+ */
+struct Line {
+    SpcFrameSync sync;
+    uint32_t now;
+    int frames;
+    uint64_t lastFrame;
+
+    /**
+     * @param start Time of reset(); the first edge follows one bit period later
+     */
+    explicit Line(uint32_t start, bool lineIdle = true) : now(start + BIT_PERIOD_US), frames(0), lastFrame(0)
+    {
+        sync.configure(SPC_MIN_BIT_PERIOD_US, SPC_FRAME_GAP_US);
+        sync.reset(start, lineIdle);
+    }
+
+    void fall(bool clockLow, bool dataHigh)
+    {
+        if (sync.onFalling(now, clockLow, dataHigh))
+        {
+            frames++;
+            lastFrame = sync.frameWord();
+        }
+    }
+
+    /**
+     * @brief Send bits first..last-1 of a frame, one falling edge each
+     * @param jitterUs Bit period varies by up to ±jitterUs
+     */
+    void send(uint64_t frame, int first = 0, int last = CALIPER_FRAME_BITS, uint32_t jitterUs = 0)
+    {
+        for (int n = first; n < last; n++)
+        {
+            fall(true, (frame >> n) & 1);
+            now += BIT_PERIOD_US;
+            if (jitterUs > 0)
+            {
+                now += rng() % (2 * jitterUs + 1);
+                now -= jitterUs;
+            }
+        }
+    }
+
+    void pause(uint32_t us = FRAME_PAUSE_US) { now += us; }
+};
+
+void setUp(void)
+{
+    rngState = 12345;
+}
+
+void tearDown(void) {}
+
+void test_nominal_frames(void)
+{
+    Line line(1000);
+    for (int i = 0; i < 100; i++)
+    {
+        const uint64_t frame = randomFrame();
+        line.pause(SPC_FRAME_GAP_US / 2); // Still shorter than the gap after TRIG
+        line.send(frame);
+        TEST_ASSERT_EQUAL(i + 1, line.frames);
+        TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+        line.pause();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, line.sync.glitches());
+    TEST_ASSERT_EQUAL_UINT32(0, line.sync.resyncs());
+}
+
+void test_bit_period_jitter(void)
+{
+    // Periods from 40 to 180 µs: well above the glitch limit, far below the gap
+    Line line(0);
+    for (int i = 0; i < 500; i++)
+    {
+        const uint64_t frame = randomFrame();
+        line.send(frame, 0, CALIPER_FRAME_BITS, 70);
+        TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+        line.pause(SPC_FRAME_GAP_US + 1 + rng() % FRAME_PAUSE_US);
+    }
+    TEST_ASSERT_EQUAL(500, line.frames);
+    TEST_ASSERT_EQUAL_UINT32(0, line.sync.glitches());
+}
+
+void test_high_glitch_in_low_phase(void)
+{
+    // A short high pulse while CLOCK is low produces an extra falling edge
+    // a few µs after the real one
+    Line line(0);
+    const uint64_t frame = randomFrame();
+    int glitches = 0;
+    for (int n = 0; n < CALIPER_FRAME_BITS; n++)
+    {
+        line.fall(true, (frame >> n) & 1);
+        if (n % 7 == 3)
+        {
+            const uint32_t edge = line.now;
+            line.now += 1 + rng() % (SPC_MIN_BIT_PERIOD_US - 1);
+            line.fall(true, rng() & 1);
+            line.now = edge;
+            glitches++;
+        }
+        line.now += BIT_PERIOD_US;
+    }
+
+    TEST_ASSERT_EQUAL(1, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+    TEST_ASSERT_EQUAL_UINT32(glitches, line.sync.glitches());
+}
+
+void test_low_glitch_in_high_phase(void)
+{
+    // A dip in the high phase is over before the ISR samples CLOCK
+    Line line(0);
+    const uint64_t frame = randomFrame();
+    for (int n = 0; n < CALIPER_FRAME_BITS; n++)
+    {
+        line.fall(true, (frame >> n) & 1);
+        line.now += BIT_PERIOD_US / 2;
+        line.fall(false, true);
+        line.now += BIT_PERIOD_US - BIT_PERIOD_US / 2;
+    }
+
+    TEST_ASSERT_EQUAL(1, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+    TEST_ASSERT_EQUAL_UINT32(CALIPER_FRAME_BITS, line.sync.glitches());
+}
+
+void test_truncated_frame_resyncs(void)
+{
+    Line line(0);
+    line.send(randomFrame(), 0, 30);
+    line.pause();
+    const uint64_t frame = randomFrame();
+    line.send(frame);
+
+    TEST_ASSERT_EQUAL(1, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+    TEST_ASSERT_EQUAL_UINT32(1, line.sync.resyncs());
+}
+
+void test_surplus_edges_wait_for_gap(void)
+{
+    // Extra edges after bit 51 must not start a shifted frame
+    Line line(0);
+    const uint64_t first = randomFrame();
+    line.send(first);
+    line.send(randomFrame(), 0, 20);
+    TEST_ASSERT_EQUAL(1, line.frames);
+    TEST_ASSERT_FALSE(line.sync.isSynced());
+
+    line.pause();
+    const uint64_t second = randomFrame();
+    line.send(second);
+    TEST_ASSERT_EQUAL(2, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(second, line.lastFrame);
+}
+
+void test_capture_started_mid_frame(void)
+{
+    Line line(0, false);
+    line.send(randomFrame(), 17, CALIPER_FRAME_BITS);
+    TEST_ASSERT_EQUAL(0, line.frames);
+
+    line.pause();
+    const uint64_t frame = randomFrame();
+    line.send(frame);
+    TEST_ASSERT_EQUAL(1, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(frame, line.lastFrame);
+}
+
+void test_timestamp_wrap(void)
+{
+    // The counter wraps in the middle of a frame and again in the pause
+    Line line(0xFFFFFFFFu - 20 * BIT_PERIOD_US);
+    const uint64_t first = randomFrame();
+    line.send(first);
+    TEST_ASSERT_EQUAL_HEX64(first, line.lastFrame);
+
+    line.now = 0xFFFFFFFFu - FRAME_PAUSE_US / 2;
+    line.pause();
+    const uint64_t second = randomFrame();
+    line.send(second);
+    TEST_ASSERT_EQUAL(2, line.frames);
+    TEST_ASSERT_EQUAL_HEX64(second, line.lastFrame);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_nominal_frames);
+    RUN_TEST(test_bit_period_jitter);
+    RUN_TEST(test_high_glitch_in_low_phase);
+    RUN_TEST(test_low_glitch_in_high_phase);
+    RUN_TEST(test_truncated_frame_resyncs);
+    RUN_TEST(test_surplus_edges_wait_for_gap);
+    RUN_TEST(test_capture_started_mid_frame);
+    RUN_TEST(test_timestamp_wrap);
+    return UNITY_END();
+}
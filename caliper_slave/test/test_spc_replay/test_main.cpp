@@ -0,0 +1,200 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: replay of SPC bitstreams through the capture path
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.1
+ *
+ * @version 1.1 - DATA sampled on the falling CLOCK edge
+ *
+ * @details
+ * Bitstreams are given in reception order, one character per bit, as they
+ * come off the DATA line. Each one is replayed through SpcFrameSync with the
+ * timing of a real caliper, exactly as clockISR() does, and the packed
+ * frame word is decoded with spcDecodeFrame(). The result must match the
+ * original array-based decoder (reverse, shift, nibbles, pow()).
+ *
+ * Run: pio test -e native_sim -f test_spc_replay
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+
+#include "../../src/sensors/spc_decoder.h"
+#include "../../src/sensors/spc_frame_sync.h"
+
+// Timestamps in µs: bit period and pause between frames of a real caliper
+static const uint32_t BIT_PERIOD = 100;
+static const uint32_t FRAME_PAUSE = 50000;
+
+struct Recording {
+    const char *bits;   /**< 52 characters, first received bit first */
+    float expectedMm;
+};
+
+static const Recording RECORDINGS[] = {
+    {"0000000000000000000000001000010011000010101000000000", 12.345f},
+    {"0000000000000000000100000000000000001000000000000000", -0.010f},
+    {"0000000000000000001000000000100001001100001000000000", 1.234f * 25.4f},
+    {"0000000000000000000000001010000000000000000000001111", 50.000f},
+    {"0000000000000000000000001001100110011001100111111111", 99.999f},
+};
+
+static const size_t RECORDING_COUNT = sizeof(RECORDINGS) / sizeof(RECORDINGS[0]);
+
+/**
+ * @brief The decoder before bit packing, kept as the reference
+ */
+static float legacyDecode(const char *bits)
+{
+    uint8_t buffer[CALIPER_FRAME_BITS];
+    for (int i = 0; i < CALIPER_FRAME_BITS; i++)
+    {
+        buffer[i] = bits[CALIPER_FRAME_BITS - 1 - i] == '1';
+    }
+
+    uint8_t shifted[CALIPER_FRAME_BITS];
+    for (int i = 0; i < CALIPER_FRAME_BITS; i++)
+    {
+        shifted[i] = i + CALIPER_BIT_SHIFT < CALIPER_FRAME_BITS ? buffer[i + CALIPER_BIT_SHIFT] : 0;
+    }
+
+    uint8_t nibbles[CALIPER_NIBBLE_COUNT];
+    for (int i = 0; i < CALIPER_NIBBLE_COUNT; i++)
+    {
+        nibbles[i] = 0;
+        for (int j = 0; j < BITS_PER_NIBBLE; j++)
+        {
+            nibbles[i] |= shifted[i * BITS_PER_NIBBLE + (BITS_PER_NIBBLE - 1 - j)] << j;
+        }
+    }
+
+    long value = 0;
+    for (int i = 0; i < CALIPER_DECIMAL_DIGITS; i++)
+    {
+        value += nibbles[i] * pow(10, i);
+    }
+    float measurement = value / CALIPER_VALUE_DIVISOR;
+    if (nibbles[6] & 0x08)
+    {
+        measurement = -measurement;
+    }
+    if (nibbles[6] & 0x04)
+    {
+        measurement *= INCH_TO_MM_FACTOR;
+    }
+    return measurement;
+}
+
+/**
+ * @brief Feed one recording to the synchroniser, one falling edge per bit
+ *
+ * The caliper changes DATA on the rising CLOCK edge, so the bit is stable
+ * when clockISR() reads it on the falling edge half a period later.
+ *
+ * @param t Timestamp of the first falling edge; advanced past the last edge
+ * @return Number of completed frames (the last one is in sync.frameWord())
+ */
+static int replay(SpcFrameSync &sync, const char *bits, uint32_t &t)
+{
+    int frames = 0;
+    for (size_t i = 0; bits[i] != '\0'; i++)
+    {
+        if (sync.onFalling(t, true, bits[i] == '1'))
+        {
+            frames++;
+        }
+        t += BIT_PERIOD;
+    }
+    return frames;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_recordings_are_complete(void)
+{
+    for (size_t i = 0; i < RECORDING_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(CALIPER_FRAME_BITS, strlen(RECORDINGS[i].bits));
+    }
+}
+
+void test_replay_matches_legacy_decoder(void)
+{
+    for (size_t i = 0; i < RECORDING_COUNT; i++)
+    {
+        SpcFrameSync sync;
+        sync.configure(BIT_PERIOD / 2, FRAME_PAUSE / 2);
+        uint32_t t = 1000;
+        sync.reset(0, true);
+
+        TEST_ASSERT_EQUAL(1, replay(sync, RECORDINGS[i].bits, t));
+
+        const float packed = spcDecodeFrame(sync.frameWord());
+        TEST_ASSERT_FLOAT_WITHIN(0.0005f, RECORDINGS[i].expectedMm, packed);
+        TEST_ASSERT_FLOAT_WITHIN(0.0005f, legacyDecode(RECORDINGS[i].bits), packed);
+    }
+}
+
+void test_bit_n_is_nth_received_bit(void)
+{
+    const char *bits = RECORDINGS[0].bits;
+    SpcFrameSync sync;
+    sync.reset(0, true);
+    uint32_t t = 0;
+    TEST_ASSERT_EQUAL(1, replay(sync, bits, t));
+
+    for (int n = 0; n < CALIPER_FRAME_BITS; n++)
+    {
+        TEST_ASSERT_EQUAL((bits[n] == '1') ? 1 : 0, (int)((sync.frameWord() >> n) & 1));
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, sync.frameWord() >> CALIPER_FRAME_BITS);
+}
+
+void test_continuous_stream(void)
+{
+    // Free-running mode: frames back to back, separated by the caliper pause
+    SpcFrameSync sync;
+    sync.configure(BIT_PERIOD / 2, FRAME_PAUSE / 2);
+    sync.reset(0, true);
+
+    uint32_t t = 1000;
+    for (int round = 0; round < 3; round++)
+    {
+        for (size_t i = 0; i < RECORDING_COUNT; i++)
+        {
+            TEST_ASSERT_EQUAL(1, replay(sync, RECORDINGS[i].bits, t));
+            TEST_ASSERT_FLOAT_WITHIN(0.0005f, RECORDINGS[i].expectedMm, spcDecodeFrame(sync.frameWord()));
+            t += FRAME_PAUSE;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, sync.glitches());
+    TEST_ASSERT_EQUAL_UINT32(0, sync.resyncs());
+}
+
+void test_capture_started_mid_frame(void)
+{
+    // Armed while a frame is on the wire: the tail is dropped, the next frame is exact
+    SpcFrameSync sync;
+    sync.configure(BIT_PERIOD / 2, FRAME_PAUSE / 2);
+    sync.reset(0, false);
+
+    uint32_t t = 1000;
+    TEST_ASSERT_EQUAL(0, replay(sync, RECORDINGS[0].bits + 20, t));
+    t += FRAME_PAUSE;
+    TEST_ASSERT_EQUAL(1, replay(sync, RECORDINGS[1].bits, t));
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, RECORDINGS[1].expectedMm, spcDecodeFrame(sync.frameWord()));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_recordings_are_complete);
+    RUN_TEST(test_replay_matches_legacy_decoder);
+    RUN_TEST(test_bit_n_is_nth_received_bit);
+    RUN_TEST(test_continuous_stream);
+    RUN_TEST(test_capture_started_mid_frame);
+    return UNITY_END();
+}
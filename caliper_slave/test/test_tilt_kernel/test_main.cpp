@@ -0,0 +1,156 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: single-precision tilt kernel against libm
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Golden atan2 values, then tiltFromCounts() against the double-precision
+ * atan2()/sqrt()/acos() angles for directions on a 1° grid over the full
+ * sphere (1 g, ±2 g full scale and a 32-sample window sum) and for random
+ * raw vectors. Cycle counts stay in benchTilt() on the target.
+ *
+ * Run: pio test -e native_sim -f test_tilt_kernel
+ */
+
+#include <unity.h>
+#include <math.h>
+
+#include "../../src/sensors/tilt_kernel.h"
+
+static const double MAX_ERROR_DEG = 0.002;  // Kernel: 0.001° plus input rounding
+static const double RAD_DEG = 180.0 / M_PI;
+
+struct GoldenAtan2 {
+    float y;
+    float x;
+    float degrees;
+};
+
+static const GoldenAtan2 GOLDEN[] = {
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 45.0f},
+    {1.0f, 0.0f, 90.0f},
+    {1.0f, -1.0f, 135.0f},
+    {0.0f, -1.0f, 180.0f},
+    {-1.0f, -1.0f, -135.0f},
+    {-1.0f, 0.0f, -90.0f},
+    {1.0f, 1.7320508f, 30.0f},
+    {1.7320508f, 1.0f, 60.0f},
+};
+
+/**
+ * @brief Largest error of tiltFromCounts() for one vector, roll wrapped at ±180°
+ */
+static double angleError(int32_t x, int32_t y, int32_t z)
+{
+    const TiltAngles fast = tiltFromCounts(x, y, z);
+    const double refX = atan2((double)y, (double)z) * RAD_DEG;
+    const double refY = atan2(-(double)x, sqrt((double)y * y + (double)z * z)) * RAD_DEG;
+    const double norm = sqrt((double)x * x + (double)y * y + (double)z * z);
+    const double refZ = acos(fabs((double)z) / norm) * RAD_DEG;
+
+    double errorX = fabs(fast.x - refX);
+    if (errorX > 180.0) errorX = 360.0 - errorX;
+    return fmax(errorX, fmax(fabs(fast.y - refY), fabs(fast.z - refZ)));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_golden_atan2(void)
+{
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, tiltAtan2Deg(0.0f, 0.0f));
+    for (const GoldenAtan2 &g : GOLDEN)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, g.degrees, tiltAtan2Deg(g.y, g.x));
+    }
+}
+
+void test_atan2_against_libm(void)
+{
+    for (int i = 0; i < 3600; i++)
+    {
+        const double a = i * 0.1 / RAD_DEG;
+        const float y = (float)sin(a);
+        const float x = (float)cos(a);
+        double error = fabs(tiltAtan2Deg(y, x) - atan2((double)y, (double)x) * RAD_DEG);
+        if (error > 180.0) error = 360.0 - error;
+        TEST_ASSERT_TRUE(error <= 0.001);
+    }
+}
+
+void test_full_sphere(void)
+{
+    // 1 g (16 counts per 0.98 mg), ±2 g full scale, 32-sample sum at 1 g
+    const int32_t magnitudes[] = {16327, 32767, 32 * 16327};
+    double maxError = 0.0;
+    for (int32_t magnitude : magnitudes)
+    {
+        for (int theta = 0; theta <= 180; theta++)
+        {
+            for (int phi = 0; phi < 360; phi++)
+            {
+                const double th = theta / RAD_DEG;
+                const double ph = phi / RAD_DEG;
+                const int32_t x = lround(magnitude * sin(th) * cos(ph));
+                const int32_t y = lround(magnitude * sin(th) * sin(ph));
+                const int32_t z = lround(magnitude * cos(th));
+                maxError = fmax(maxError, angleError(x, y, z));
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(maxError <= MAX_ERROR_DEG);
+}
+
+void test_random_raw_vectors(void)
+{
+    uint32_t rng = 0x2545F491u;
+    for (int i = 0; i < 100000; i++)
+    {
+        int32_t v[3];
+        for (int32_t &axis : v)
+        {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            axis = (int16_t)rng;
+        }
+        if (v[0] == 0 && v[1] == 0 && v[2] == 0)
+        {
+            continue;
+        }
+        TEST_ASSERT_TRUE(angleError(v[0], v[1], v[2]) <= MAX_ERROR_DEG);
+    }
+}
+
+void test_degenerate_vectors(void)
+{
+    const TiltAngles zero = tiltFromCounts(0, 0, 0);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, zero.x);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, zero.y);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, zero.z);
+
+    // Upside down: roll 180°, inclination from vertical 0° (|z| is used)
+    const TiltAngles flipped = tiltFromCounts(0, 0, -16327);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 180.0f, flipped.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, flipped.y);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, flipped.z);
+
+    // Lying on the side: inclination 90°
+    const TiltAngles side = tiltFromCounts(16327, 0, 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -90.0f, side.y);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 90.0f, side.z);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_atan2);
+    RUN_TEST(test_atan2_against_libm);
+    RUN_TEST(test_full_sphere);
+    RUN_TEST(test_random_raw_vectors);
+    RUN_TEST(test_degenerate_vectors);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_main.cpp
+ * @brief Host test: high-pass RMS / peak of VibrationMonitor
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Feeds synthetic accelerometer vectors at a fixed rate: a static tilt with
+ * gravity, sine vibration on top of it, and a vibration that stops. Checks
+ * the publication rule (full window only), the RMS and peak of a known
+ * sine, the window timestamps used by the forward-stroke gate, parameter
+ * clamping and reset().
+ *
+ * Run: pio test -e native_sim -f test_vibration_monitor
+ */
+
+#include <unity.h>
+#include <math.h>
+
+#include "../../src/sensors/vibration_monitor.h"
+
+static const float RATE_HZ = 400.0f;
+static const uint32_t PERIOD_MS = 5;     // Timestamps only; 1000 / RATE_HZ rounded
+static const float CUTOFF_HZ = 1.0f;
+static const uint16_t WINDOW = 64;
+
+// Static tilt: about 1 g, split over Y and Z (1 count = 1 mg)
+static const int16_t GX = 0;
+static const int16_t GY = 500;
+static const int16_t GZ = 866;
+
+/**
+ * @brief Feed samples [first, first + count) of a sine on X over the tilt
+ * @return Timestamp of the last sample
+ */
+static uint32_t feedSine(VibrationMonitor &monitor, int first, int count, float amplitude, float frequencyHz)
+{
+    uint32_t t = 0;
+    for (int n = first; n < first + count; n++)
+    {
+        const float v = amplitude * sinf(2.0f * (float)M_PI * frequencyHz * n / RATE_HZ);
+        t = (uint32_t)n * PERIOD_MS;
+        monitor.feed((int16_t)(GX + lroundf(v)), GY, GZ, t);
+    }
+    return t;
+}
+
+static void configure(VibrationMonitor &monitor, uint16_t window = WINDOW)
+{
+    monitor.configure(RATE_HZ, CUTOFF_HZ, window, 1.0f);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_level_needs_a_full_window(void)
+{
+    VibrationMonitor monitor;
+    configure(monitor);
+    VibrationLevel level;
+
+    // The first vector only primes the filter, then WINDOW filtered samples
+    feedSine(monitor, 0, WINDOW, 0.0f, 0.0f);
+    TEST_ASSERT_FALSE(monitor.level(level));
+
+    feedSine(monitor, WINDOW, 1, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(monitor.level(level));
+}
+
+void test_static_tilt_is_quiet(void)
+{
+    // Gravity is removed by the high-pass filter, not seen as a step
+    VibrationMonitor monitor;
+    configure(monitor);
+    feedSine(monitor, 0, 4 * WINDOW, 0.0f, 0.0f);
+
+    VibrationLevel level;
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, level.rmsMg);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, level.peakMg);
+}
+
+void test_sine_rms_and_peak(void)
+{
+    // 50 Hz is far above the cutoff: the filter passes it almost unchanged.
+    // 64 samples at 400 Hz are exactly 8 periods
+    VibrationMonitor monitor;
+    configure(monitor);
+    feedSine(monitor, 0, 800, 100.0f, 50.0f);
+
+    VibrationLevel level;
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 100.0f / sqrtf(2.0f), level.rmsMg);
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 100.0f, level.peakMg);
+}
+
+void test_window_timestamps(void)
+{
+    VibrationMonitor monitor;
+    configure(monitor);
+    const uint32_t last = feedSine(monitor, 0, 300, 20.0f, 50.0f);
+
+    VibrationLevel level;
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_EQUAL_UINT32(last, level.timestampMs);
+    TEST_ASSERT_EQUAL_UINT32(last - (WINDOW - 1) * PERIOD_MS, level.windowStartMs);
+}
+
+void test_vibration_stops(void)
+{
+    // Shaking, then still: quiet again once the window holds still samples
+    // only, and the window then starts after the end of the vibration
+    VibrationMonitor monitor;
+    configure(monitor);
+    const uint32_t stopMs = feedSine(monitor, 0, 400, 200.0f, 30.0f);
+
+    VibrationLevel level;
+    feedSine(monitor, 401, WINDOW / 2, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_TRUE(level.rmsMg > 8.0f);
+
+    feedSine(monitor, 401 + WINDOW / 2, 2 * WINDOW, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_TRUE(level.rmsMg < 8.0f);
+    TEST_ASSERT_TRUE(level.peakMg < 25.0f);
+    TEST_ASSERT_TRUE(level.windowStartMs > stopMs);
+}
+
+void test_window_is_clamped(void)
+{
+    VibrationLevel level;
+
+    VibrationMonitor single;
+    configure(single, 0);
+    feedSine(single, 0, 2, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(single.level(level));
+    TEST_ASSERT_EQUAL_UINT32(level.timestampMs, level.windowStartMs);
+
+    VibrationMonitor wide;
+    configure(wide, 1000);
+    feedSine(wide, 0, VIB_MAX_WINDOW, 0.0f, 0.0f);
+    TEST_ASSERT_FALSE(wide.level(level));
+    feedSine(wide, VIB_MAX_WINDOW, 1, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(wide.level(level));
+}
+
+void test_reset_forgets_the_level(void)
+{
+    VibrationMonitor monitor;
+    configure(monitor);
+    feedSine(monitor, 0, 200, 50.0f, 50.0f);
+
+    VibrationLevel level;
+    TEST_ASSERT_TRUE(monitor.level(level));
+    monitor.reset();
+    TEST_ASSERT_FALSE(monitor.level(level));
+
+    // Primed again by the next vector: no step from the old filter state
+    feedSine(monitor, 0, WINDOW + 1, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(monitor.level(level));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, level.peakMg);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_level_needs_a_full_window);
+    RUN_TEST(test_static_tilt_is_quiet);
+    RUN_TEST(test_sine_rms_and_peak);
+    RUN_TEST(test_window_timestamps);
+    RUN_TEST(test_vibration_stops);
+    RUN_TEST(test_window_is_clamped);
+    RUN_TEST(test_reset_forgets_the_level);
+    return UNITY_END();
+}
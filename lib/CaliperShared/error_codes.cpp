@@ -24,9 +24,11 @@ const char* getErrorCategoryName(ErrorCode code)
     case ERR_SERIAL_COMM_ERROR:
     case ERR_SERIAL_TIMEOUT:
     case ERR_RS485_INIT_FAILED:
+    case ERR_ESPNOW_CRC_MISMATCH:
     case ERR_RS485_TIMEOUT:
     case ERR_RS485_INVALID_RESPONSE:
     case ERR_RS485_OUT_OF_RANGE:
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
       return "COMMUNICATION";
 
     case ERR_CALIPER_TIMEOUT:
@@ -99,6 +101,8 @@ const char* getErrorModuleName(ErrorCode code)
     case ERR_ESPNOW_RECV_FAILED:
     case ERR_ESPNOW_PEER_ADD_FAILED:
     case ERR_ESPNOW_INVALID_LENGTH:
+    case ERR_ESPNOW_CRC_MISMATCH:
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
       return "ESPNOW";
 
     case ERR_SERIAL_COMM_ERROR:
@@ -205,12 +209,16 @@ const char* getErrorDescription(ErrorCode code)
       return "Serial operation timeout";
     case ERR_RS485_INIT_FAILED:
       return "RS485 interface initialization failed";
+    case ERR_ESPNOW_CRC_MISMATCH:
+      return "ESP-NOW frame CRC mismatch";
     case ERR_RS485_TIMEOUT:
       return "RS485 measurement timeout - no response from device";
     case ERR_RS485_INVALID_RESPONSE:
       return "RS485 invalid or unparseable response received";
     case ERR_RS485_OUT_OF_RANGE:
       return "RS485 measurement value out of valid range";
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
+      return "ESP-NOW unsupported protocol version";
 
     // Sensor Errors
     case ERR_CALIPER_TIMEOUT:
@@ -336,12 +344,16 @@ const char* getErrorRecoveryAction(ErrorCode code)
       return "Check serial connection, verify baud rate, reduce data rate";
     case ERR_RS485_INIT_FAILED:
       return "Check RS485 wiring, verify UART pins and DE/RE control, restart device";
+    case ERR_ESPNOW_CRC_MISMATCH:
+      return "Check signal strength and interference, frame is dropped";
     case ERR_RS485_TIMEOUT:
       return "Check RS485 connection, verify probe power and baud rate, retry measurement";
     case ERR_RS485_INVALID_RESPONSE:
       return "Check RS485 bus integrity, verify probe firmware, retry measurement";
     case ERR_RS485_OUT_OF_RANGE:
       return "Verify measurement value, check probe zero position, recalibrate if needed";
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
+      return "Update Master, Slave and RC firmware to the same release";
 
     // Sensor Errors
     case ERR_CALIPER_TIMEOUT:
@@ -450,6 +462,7 @@ bool isRecoverableError(ErrorCode code)
     case ERR_NONE:
     case ERR_ESPNOW_SEND_FAILED:
     case ERR_ESPNOW_RECV_FAILED:
+    case ERR_ESPNOW_CRC_MISMATCH:
     case ERR_SERIAL_COMM_ERROR:
     case ERR_SERIAL_TIMEOUT:
     case ERR_RS485_TIMEOUT:
@@ -484,6 +497,7 @@ bool isRecoverableError(ErrorCode code)
     case ERR_ESPNOW_INIT_FAILED:
     case ERR_ESPNOW_PEER_ADD_FAILED:
     case ERR_ESPNOW_INVALID_LENGTH:
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
     case ERR_ACCEL_INIT_FAILED:
     case ERR_BATTERY_LOW_VOLTAGE:
     case ERR_LITTLEFS_MOUNT_FAILED:
@@ -525,6 +539,7 @@ uint8_t getErrorSeverity(ErrorCode code)
     // Warning level (1)
     case ERR_ESPNOW_SEND_FAILED:
     case ERR_ESPNOW_RECV_FAILED:
+    case ERR_ESPNOW_CRC_MISMATCH:
     case ERR_SERIAL_TIMEOUT:
     case ERR_RS485_TIMEOUT:
     case ERR_CALIPER_TIMEOUT:
@@ -543,6 +558,7 @@ uint8_t getErrorSeverity(ErrorCode code)
     // Error level (2)
     case ERR_ESPNOW_PEER_ADD_FAILED:
     case ERR_ESPNOW_INVALID_LENGTH:
+    case ERR_ESPNOW_UNSUPPORTED_VERSION:
     case ERR_SERIAL_COMM_ERROR:
     case ERR_RS485_INVALID_RESPONSE:
     case ERR_RS485_OUT_OF_RANGE:
@@ -77,6 +77,9 @@ enum ErrorCode : uint16_t
   /** RS485 (MAX485) interface initialization failed */
   ERR_RS485_INIT_FAILED = 0x0108,
 
+  /** ESP-NOW v2 frame with a wrong CRC16 */
+  ERR_ESPNOW_CRC_MISMATCH = 0x0109,
+
   /** RS485 measurement / query timeout - no response from device */
   ERR_RS485_TIMEOUT = 0x010A,
 
@@ -86,6 +89,9 @@ enum ErrorCode : uint16_t
   /** RS485 measurement value out of valid range */
   ERR_RS485_OUT_OF_RANGE = 0x010C,
 
+  /** ESP-NOW frame with an unknown protocol version or message type */
+  ERR_ESPNOW_UNSUPPORTED_VERSION = 0x010D,
+
   // ============================================================================
   // Sensor Errors (0x02XX)
   // ============================================================================
@@ -3,8 +3,10 @@
  * @brief Error Handler System with Logging Macros
  * @author System Generated
  * @date 2026-01-04
- * @version 1.0
+ * @version 1.1
  * 
+ * @version 1.1 - millis() fallback for host builds (unit tests)
+ *
  * This file provides a comprehensive error handling system with:
  * - Error logging macros with automatic decoding
  * - Error tracking and statistics
@@ -18,6 +20,19 @@
 #include "error_codes.h"
 #include <MacroDebugger.h>
 
+#if !defined(ARDUINO)
+#include <chrono>
+
+/**
+ * @brief Host builds: millis() for the error timestamps
+ */
+inline uint32_t millis()
+{
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
 // ============================================================================
 // Error Statistics Structure
 // ============================================================================
@@ -3,9 +3,13 @@
  * @brief ESP-NOW Helper Functions Implementation
  * @author System Generated
  * @date 2026-01-04
- * @version 1.0
+ * @version 1.1
+ *
+ * @version 1.1 - Not compiled in host builds (no ESP-NOW)
  */
 
+#if defined(ARDUINO)
+
 #include "espnow_helper.h"
 #include "error_handler.h"
 #include <Arduino.h>
@@ -101,3 +105,5 @@ ErrorCode espnow_add_peer_with_retry(
 
     return ERR_ESPNOW_PEER_ADD_FAILED;
 }
+
+#endif // ARDUINO
@@ -0,0 +1,103 @@
+/**
+ * @file latency_histogram.h
+ * @brief Fixed-size logarithmic latency histogram
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Bucket 0 counts latencies below 2 us, bucket i (i >= 1) counts latencies
+ * in [2^i, 2^(i+1)) us, and the last bucket also collects everything above.
+ * Recording is O(1) and allocation-free. Min, max and mean are exact;
+ * percentiles are resolved to the bucket upper bound.
+ *
+ * No dependency on Arduino headers - builds on the host as well.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+#define LATENCY_HISTOGRAM_BUCKETS 20  // Last bucket starts at 2^19 us (~0.5 s)
+
+class LatencyHistogram
+{
+public:
+  /**
+   * @brief Add one sample
+   * @param us Latency in microseconds
+   */
+  void record(uint32_t us)
+  {
+    uint8_t bucket = 0;
+    for (uint32_t v = us >> 1; v != 0 && bucket < LATENCY_HISTOGRAM_BUCKETS - 1; v >>= 1)
+    {
+      bucket++;
+    }
+
+    buckets[bucket]++;
+    samples++;
+    sumUs += us;
+    if (us < minLatency) minLatency = us;
+    if (us > maxLatency) maxLatency = us;
+  }
+
+  void reset()
+  {
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+      buckets[i] = 0;
+    }
+    samples = 0;
+    sumUs = 0;
+    minLatency = UINT32_MAX;
+    maxLatency = 0;
+  }
+
+  uint32_t count() const { return samples; }
+  uint32_t minUs() const { return samples ? minLatency : 0; }
+  uint32_t maxUs() const { return maxLatency; }
+  uint32_t meanUs() const { return samples ? (uint32_t)(sumUs / samples) : 0; }
+  uint32_t bucketCount(uint8_t i) const { return i < LATENCY_HISTOGRAM_BUCKETS ? buckets[i] : 0; }
+
+  /**
+   * @brief Lower bound of bucket i in microseconds
+   */
+  static uint32_t bucketLowerUs(uint8_t i) { return i == 0 ? 0 : (1UL << i); }
+
+  /**
+   * @brief Upper bound (exclusive) of the bucket containing the p-th percentile
+   * @param percent 0..100
+   * @return Microseconds, capped at maxUs()
+   */
+  uint32_t percentileUs(uint8_t percent) const
+  {
+    if (samples == 0)
+    {
+      return 0;
+    }
+
+    const uint64_t target = ((uint64_t)samples * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+      seen += buckets[i];
+      if (seen >= target && seen > 0)
+      {
+        const uint32_t upper = 1UL << (i + 1);
+        return upper < maxLatency ? upper : maxLatency;
+      }
+    }
+    return maxLatency;
+  }
+
+private:
+  uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS] = {};
+  uint32_t samples = 0;
+  uint64_t sumUs = 0;
+  uint32_t minLatency = UINT32_MAX;
+  uint32_t maxLatency = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,108 @@
+/**
+ * @file overwrite_ring.h
+ * @brief Single-producer ring that always holds the newest N elements
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Unlike SpscRing, the producer never blocks and never drops: when the ring
+ * is full the oldest element is overwritten. The consumer does not remove
+ * anything, it reads "the n-th newest" element at any time. This suits a
+ * sensor stream where only recent samples matter and the reader may be idle
+ * for long periods.
+ *
+ * - Capacity must be a power of two.
+ * - push() is called only by the producer; latest()/pushed() from any reader.
+ * - A read that races with the producer overwriting the same slot is
+ *   detected (sequence check after the copy) and reported as a miss, so a
+ *   torn element is never returned. Keep T small (a few words).
+ * - No dependency on Arduino headers - builds on the host as well.
+ */
+
+#ifndef OVERWRITE_RING_H
+#define OVERWRITE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "spsc_ring.h" // SPSC_INLINE
+
+template <typename T, size_t N>
+class OverwriteRing
+{
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "OverwriteRing capacity must be a power of two");
+
+public:
+  /**
+   * @brief Append an element, overwriting the oldest one when full (producer side)
+   */
+  SPSC_INLINE void push(const T &item)
+  {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    // Invalidate readers of the slot before its contents change
+    writing_.store(head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    buffer_[head & MASK] = item;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copy the n-th newest element (0 = newest)
+   * @param n Age of the element, 0..N-1
+   * @param out Receives the element
+   * @param seq Optional: receives the element's sequence number (1 = first push)
+   * @return false if fewer than n + 1 elements were pushed, n is out of
+   *         range, or the slot was overwritten during the copy
+   */
+  SPSC_INLINE bool latest(uint32_t n, T &out, uint32_t *seq = nullptr) const
+  {
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    if (n >= head || n >= N)
+    {
+      return false;
+    }
+
+    const uint32_t index = head - 1 - n;
+    out = buffer_[index & MASK];
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The slot is reused by the push with sequence index + N + 1
+    if (writing_.load(std::memory_order_relaxed) - (index + 1) >= N)
+    {
+      return false;
+    }
+
+    if (seq != nullptr)
+    {
+      *seq = index + 1;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Total number of elements pushed (sequence number of the newest)
+   */
+  SPSC_INLINE uint32_t pushed() const { return head_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Forget all elements (only while the producer is stopped)
+   */
+  void clear()
+  {
+    head_.store(0, std::memory_order_release);
+    writing_.store(0, std::memory_order_release);
+  }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  static constexpr uint32_t MASK = (uint32_t)(N - 1);
+
+  T buffer_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> writing_{0};
+};
+
+#endif // OVERWRITE_RING_H
@@ -3,7 +3,7 @@
  * @brief Shared definitions and structures for ESP32 Caliper System
  * @author System Generated
  * @date 2025-12-26
- * @version 3.0
+ * @version 3.9
  *
  * This is the unified common header file for both Master and Slave devices.
  * Use build flags to enable device-specific features:
@@ -11,6 +11,15 @@
  * - CALIPER_SLAVE: Enables Slave-specific structures
  *
  * @version 3.0 - Added comprehensive error code system integration
+ * @version 3.1 - MessageSlaveMulti for multi-drop RS485 probes
+ * @version 3.2 - Vibration RMS at capture in the slave messages
+ * @version 3.3 - Trapezoidal motion profile in MessageMaster
+ * @version 3.4 - Detected settle time in the slave messages
+ * @version 3.5 - CMD_BURST and MessageSlaveBurst
+ * @version 3.6 - CMD_STREAM and MessageSlaveStream
+ * @version 3.7 - Messages are sent through wire_protocol.h (v2 header, v1 fallback)
+ * @version 3.8 - requestId in MessageMaster, echoed in every slave reply
+ * @version 3.9 - BurstSample packed to 7 bytes, 32 samples per MessageSlaveBurst
  */
 
 #ifndef SHARED_COMMON_H
@@ -18,6 +27,7 @@
 
 #include <stdint.h>
 #include "error_codes.h"
+#include "shared_config.h"
 
 /**
  * @brief Command types for ESP-NOW communication
@@ -27,6 +37,8 @@ enum CommandType : char
   CMD_MEASURE = 'M',     /**< Request measurement from slave */
   CMD_UPDATE = 'U',      /**< Request update status from slave */
   CMD_MOTORTEST = 'T',   /**< Generic motor control command (uses motorState/motorSpeed/motorTorque) */
+  CMD_BURST = 'B',       /**< Request burstCount samples in MessageSlaveBurst frames, without motor */
+  CMD_STREAM = 'S',      /**< Subscribe to MessageSlaveStream telemetry (streamPeriodMs 0 = unsubscribe) */
   CMD_OTA = 'O',         /**< Request OTA update mode */
   CMD_TRIG_MEAS = 'R',   /**< RC: trigger measurement on master (same as serial 'm') */
   CMD_DROP_MEAS = 'D',   /**< RC: drop last measurement in GUI */
@@ -89,6 +101,42 @@ struct MessageSlave
   float batteryVoltage;    /**< Battery voltage in voltage */
   CommandType command;     /**< Command type */
   uint8_t angleZ;            /**< Angle Z from accelerometer IIS328DQ (0-90 degrees, inclination from vertical) */
+  uint16_t vibrationRms;     /**< Vibration RMS at capture in mg (0 = not available) */
+  uint16_t settleMs;         /**< Jaw settled this long after the forward stroke began (0 = not detected) */
+  uint8_t requestId;         /**< MessageMaster::requestId of the request answered (0 = slave without request IDs) */
+};
+
+/**
+ * @brief Status of one channel in MessageSlaveMulti
+ */
+enum ChannelStatus : uint8_t
+{
+  CHANNEL_OK = 0,           /**< Value valid */
+  CHANNEL_TIMEOUT = 1,      /**< Probe did not answer */
+  CHANNEL_INVALID = 2,      /**< Answer could not be parsed */
+  CHANNEL_OUT_OF_RANGE = 3, /**< Value outside MEASUREMENT_MIN_VALUE..MEASUREMENT_MAX_VALUE */
+  CHANNEL_NO_CONSENSUS = 4, /**< Readings valid but never agreed before the timeout */
+  CHANNEL_DISABLED = 5      /**< No probe configured on this channel */
+};
+
+/**
+ * @brief Slave reply with all probes of a multi-drop RS485 bus
+ *
+ * Sent instead of MessageSlave when the slave has more than one probe.
+ * WIRE_SLAVE_MULTI in protocol v2, told apart by its length in v1.
+ * Channels >= channelCount are CHANNEL_DISABLED.
+ */
+struct MessageSlaveMulti
+{
+  float measurement[RS485_MAX_PROBES]; /**< Measurement value of each channel in mm */
+  float batteryVoltage;                /**< Battery voltage in voltage */
+  CommandType command;                 /**< Command type */
+  uint8_t angleZ;                      /**< Angle Z from accelerometer (0-90 degrees) */
+  uint16_t vibrationRms;               /**< Vibration RMS at capture in mg (0 = not available) */
+  uint16_t settleMs;                   /**< Jaw settle time in ms (0 = not detected) */
+  uint8_t channelCount;                /**< Probes configured on the bus */
+  uint8_t status[RS485_MAX_PROBES];    /**< ChannelStatus of each channel */
+  uint8_t requestId;                   /**< MessageMaster::requestId of the request answered (0 = unknown) */
 };
 
 struct MessageMaster
@@ -98,6 +146,49 @@ struct MessageMaster
   MotorState motorState;  /**< Current motor state */
   uint8_t motorSpeed;    /**< Motor speed (PWM value 0-255) */
   uint8_t motorTorque;   /**< Motor torque (PWM value 0-255) */
+  uint16_t rampUpMs;     /**< Acceleration ramp 0 -> motorSpeed of each stroke (ms, 0 = step) */
+  uint16_t rampDownMs;   /**< Deceleration ramp at the end of each stroke (ms, 0 = step) */
+  uint8_t holdPercent;   /**< Forward stroke ends at motorSpeed * holdPercent / 100 (probe pressure) */
+  uint8_t burstCount;    /**< CMD_BURST: samples to take (1..BURST_MAX_SAMPLES) */
+  uint16_t burstIntervalMs; /**< CMD_BURST: time between samples (0 = back to back) */
+  uint16_t streamPeriodMs; /**< CMD_STREAM: sampling period (STREAM_MIN_PERIOD_MS.., 0 = stop) */
+  uint8_t streamBatch;     /**< CMD_STREAM: samples per packet (1..STREAM_SAMPLES_PER_FRAME, raised by the slave at high rates) */
+  uint8_t requestId;       /**< Echoed in the reply, new for every request (never 0) */
+};
+
+/**
+ * @brief One sample of a burst
+ *
+ * Packed to 7 bytes, so BURST_SAMPLES_PER_FRAME samples fit one frame.
+ */
+struct __attribute__((packed)) BurstSample
+{
+  float measurement;     /**< Measurement value in mm (INVALID_MEASUREMENT_VALUE unless status is CHANNEL_OK) */
+  uint16_t offsetMs;     /**< Capture time after the first sample of the burst */
+  uint8_t status;        /**< ChannelStatus of the sample */
+};
+
+/**
+ * @brief Slave reply to CMD_BURST, one of frameCount frames
+ *
+ * Samples firstSample .. firstSample + sampleCount - 1 of a burst of
+ * totalSamples. Protocol v2 sends only the used samples; in v1 every frame
+ * has the full size (unused samples are zero), so it is told apart by its
+ * length. Battery and angle are taken once after the last sample and
+ * repeated in every frame.
+ */
+struct MessageSlaveBurst
+{
+  CommandType command;       /**< CMD_BURST */
+  uint8_t requestId;         /**< MessageMaster::requestId of the CMD_BURST, same in all frames */
+  uint8_t frameIndex;        /**< 0 .. frameCount - 1 */
+  uint8_t frameCount;        /**< Frames of this burst */
+  uint8_t firstSample;       /**< Index of samples[0] in the burst */
+  uint8_t sampleCount;       /**< Valid entries in samples[] */
+  uint8_t totalSamples;      /**< Samples of the whole burst */
+  uint8_t angleZ;            /**< Angle Z from accelerometer (0-90 degrees) */
+  float batteryVoltage;      /**< Battery voltage in voltage */
+  BurstSample samples[BURST_SAMPLES_PER_FRAME];
 };
 
 struct MessageRC
@@ -105,6 +196,45 @@ struct MessageRC
   CommandType command;
 };
 
+/**
+ * @brief One telemetry sample
+ */
+struct StreamSample
+{
+  float measurement;     /**< Measurement value in mm (INVALID_MEASUREMENT_VALUE unless status is CHANNEL_OK) */
+  uint16_t offsetMs;     /**< Capture time after firstTimestampMs */
+  uint8_t angleZ;        /**< Angle Z from accelerometer (0-90 degrees) */
+  uint8_t status;        /**< ChannelStatus of the sample */
+};
+
+/**
+ * @brief Telemetry packet, sent unsolicited while subscribed (CMD_STREAM)
+ *
+ * sampleCount entries are valid (v2 sends only those, v1 the full struct).
+ * sequence counts packets of the subscription, so the receiver can tell
+ * lost packets from samples dropped by the slave's flow control.
+ */
+struct MessageSlaveStream
+{
+  CommandType command;       /**< CMD_STREAM */
+  uint8_t sampleCount;       /**< Valid entries in samples[] */
+  uint16_t sequence;         /**< Packet number since the subscription started */
+  uint16_t droppedSamples;   /**< Samples discarded by flow control since the previous packet */
+  uint16_t periodMs;         /**< Sampling period in use */
+  uint32_t firstTimestampMs; /**< Slave millis() of samples[0] */
+  float batteryVoltage;      /**< Battery voltage in voltage */
+  StreamSample samples[STREAM_SAMPLES_PER_FRAME];
+};
+
+// Protocol v1 frames are told apart by their length; the v1 layouts and
+// sizes are in wire_protocol.h
+static_assert(sizeof(MessageSlaveBurst) <= ESPNOW_MAX_PAYLOAD, "MessageSlaveBurst exceeds the ESP-NOW payload");
+static_assert(sizeof(MessageSlaveStream) <= ESPNOW_MAX_PAYLOAD, "MessageSlaveStream exceeds the ESP-NOW payload");
+static_assert((uint32_t)STREAM_MAX_PERIOD_MS * (STREAM_SAMPLES_PER_FRAME - 1) <= UINT16_MAX,
+  "StreamSample offsets of one packet fit uint16_t");
+static_assert(BURST_MAX_SAMPLES <= UINT8_MAX && BURST_MAX_SAMPLES >= BURST_SAMPLES_PER_FRAME,
+  "burst sample indices are uint8_t");
+
 #ifdef CALIPER_MASTER
 /**
  * @brief System status structure (Master only)
@@ -116,6 +246,15 @@ struct SystemStatus
   struct MessageSlave msgSlave;
   struct MessageMaster msgMaster;
 
+  // All channels of a multi-probe slave; channelCount == 0 when the last
+  // reply was a single-probe MessageSlave. Channel 0 is mirrored in msgSlave.
+  struct MessageSlaveMulti msgSlaveMulti;
+
+  // Samples of the last CMD_BURST, reassembled from its MessageSlaveBurst
+  // frames; burstCount is 0 until all frames have arrived
+  struct BurstSample burst[BURST_MAX_SAMPLES];
+  uint8_t burstCount;
+
   // Offset kalibracji utrzymywany lokalnie na Master.
   // UI (WWW/GUI) wysyła go osobno, a korekcja jest liczona po stronie klienta:
   // corrected = msgSlave.measurement - calibrationOffset + reference
@@ -21,6 +21,33 @@
 #define ESPNOW_WIFI_CHANNEL 1
 #define ESPNOW_RETRY_DELAY_MS 100
 #define ESPNOW_MAX_RETRIES 3
+#define ESPNOW_MAX_PAYLOAD 250        // ESP-NOW v1 frame payload limit (bytes)
+
+// ============================================================================
+// Wire Protocol (wire_protocol.h)
+// ============================================================================
+#define WIRE_MAGIC 0xCA                // First byte of every v2 frame
+#define WIRE_VERSION_1 1               // Bare message struct, told apart by length
+#define WIRE_VERSION 2                 // WireHeader + payload, sent when the peer speaks it
+#define WIRE_PROBE_MAX_UNANSWERED 2    // Requests lost while probing v2 before falling back to v1
+#define WIRE_V1_REPROBE_REQUESTS 16    // Requests in v1 before v2 is probed again
+
+// ============================================================================
+// Burst Measurement (CMD_BURST, MessageSlaveBurst)
+// ============================================================================
+#define BURST_MAX_SAMPLES 64          // Largest burstCount accepted by the slave
+#define BURST_SAMPLES_PER_FRAME 32    // Samples in one MessageSlaveBurst (fits ESPNOW_MAX_PAYLOAD with WireHeader)
+#define BURST_MAX_INTERVAL_MS 1000    // Largest burstIntervalMs (0 = back to back)
+
+// ============================================================================
+// Telemetry Streaming (CMD_STREAM, MessageSlaveStream)
+// ============================================================================
+#define STREAM_SAMPLES_PER_FRAME 16       // Samples in one MessageSlaveStream
+#define STREAM_MIN_PERIOD_MS 10           // Fastest sampling period (100 Hz)
+#define STREAM_MAX_PERIOD_MS 4000         // Slowest period (offsets of a frame fit uint16_t ms)
+#define STREAM_MIN_PACKET_INTERVAL_MS 50  // Slave batches more samples rather than exceed 20 packets/s
+#define STREAM_KEEPALIVE_MS 1000          // Master renews the subscription this often
+#define STREAM_KEEPALIVE_TIMEOUT_MS 3000  // Slave stops streaming without a renewal
 
 // ============================================================================
 // Timing Configuration
@@ -88,6 +115,15 @@
 #define RS485_CR 0x0D
 #define RS485_RESPONSE_TIMEOUT_MS 200
 #define RS485_RESPONSE_BUFFER_SIZE 64
+#define RS485_RX_TIMEOUT_SYMBOLS 2       // UART RX idle time (in characters) that flushes the FIFO to onReceive
+#define RS485_LATENCY_LOG_INTERVAL 100   // Successful reads between latency histogram printouts (0 = off)
+#define RS485_STREAM_START_CMD "OUT1"    // Probe command: continuous position output on
+#define RS485_STREAM_STOP_CMD "OUT0"     // Probe command: continuous position output off
+#define RS485_STREAM_RING_SIZE 64        // Newest streamed positions kept (power of two)
+#define RS485_MAX_PROBES 8               // Channels in MessageSlaveMulti (multi-drop bus)
+#define RS485_PROBE_ADDRESSES {1, 2, 3, 4, 5, 6, 7, 8} // Bus address of channel 0..RS485_MAX_PROBES-1
+#define RS485_ADDRESSED_QUERY_FORMAT "%u?" // Position query of one addressed probe (CR appended)
+#define RS485_POLL_GUARD_MS 20           // After a channel timeout: late replies dropped before the next query
 
 // ============================================================================
 // Pin Definitions - LED indicator
@@ -125,13 +161,15 @@
 // ============================================================================
 // Caliper Configuration
 // ============================================================================
-#define CALIPER_BIT_BUFFER_SIZE 52
+#define CALIPER_FRAME_BITS 52
 #define CALIPER_BIT_SHIFT 8
 #define CALIPER_NIBBLE_COUNT 13
 #define BITS_PER_NIBBLE 4
 #define CALIPER_DECIMAL_DIGITS 5
 #define CALIPER_VALUE_DIVISOR 1000.0f
 #define INCH_TO_MM_FACTOR 25.4f
+#define CALIPER_FRAME_RING_SIZE 8      // Frames buffered between ISR and consumer (power of two)
+#define CALIPER_HISTORY_SIZE 8         // Decoded frames kept for reliable-read queries
 
 // ============================================================================
 // Motor Configuration
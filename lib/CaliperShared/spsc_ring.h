@@ -0,0 +1,105 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.0
+ *
+ * @details
+ * Fixed-capacity FIFO that is safe to use between exactly one producer and
+ * exactly one consumer running concurrently (e.g. an ISR and a task, or two
+ * tasks on different cores) without locks or critical sections.
+ *
+ * - Capacity must be a power of two; one slot is NOT wasted (indices are
+ *   free-running counters and are masked on access).
+ * - push() is called only by the producer, pop()/peek()/clear() only by the
+ *   consumer. size()/empty() may be called from either side.
+ * - Methods are force-inlined so that calls from an IRAM_ATTR ISR do not
+ *   end up as out-of-line code in flash.
+ * - No dependency on Arduino headers - builds on the host as well.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#if defined(__GNUC__)
+  #define SPSC_INLINE inline __attribute__((always_inline))
+#else
+  #define SPSC_INLINE inline
+#endif
+
+template <typename T, size_t N>
+class SpscRing
+{
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+  /**
+   * @brief Append an element (producer side)
+   * @param item Element to copy into the ring
+   * @return false if the ring is full (element is dropped)
+   */
+  SPSC_INLINE bool push(const T &item)
+  {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= N)
+    {
+      return false;
+    }
+    buffer_[head & MASK] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest element (consumer side)
+   * @param out Receives the element
+   * @return false if the ring is empty
+   */
+  SPSC_INLINE bool pop(T &out)
+  {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail)
+    {
+      return false;
+    }
+    out = buffer_[tail & MASK];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Drop all queued elements (consumer side)
+   */
+  SPSC_INLINE void clear()
+  {
+    tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  /**
+   * @brief Number of queued elements (snapshot)
+   */
+  SPSC_INLINE size_t size() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  SPSC_INLINE bool empty() const { return size() == 0; }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  static constexpr uint32_t MASK = (uint32_t)(N - 1);
+
+  T buffer_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,364 @@
+/**
+ * @file wire_protocol.cpp
+ * @brief Versioned ESP-NOW wire format implementation
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.2
+ *
+ * @version 1.1 - wire_encode() and v2 re-probing; builds on the host
+ *                without wire_send()
+ * @version 1.2 - v1 MessageMaster and MessageSlave in the layout of the
+ *                firmware before v2
+ */
+
+#include "wire_protocol.h"
+#include "error_handler.h"
+#include <string.h>
+
+#if defined(ARDUINO)
+#include "espnow_helper.h"
+#include <Arduino.h>
+#include <esp_random.h>
+
+static uint32_t wire_random() { return esp_random(); }
+#else
+#include <stdlib.h>
+
+static uint32_t wire_random() { return (uint32_t)rand(); }
+#endif
+
+static const uint16_t CRC16_NIBBLE_TABLE[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t wire_crc16(const uint8_t *data, size_t len, uint16_t crc)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    crc = (uint16_t)((crc << 4) ^ CRC16_NIBBLE_TABLE[(crc >> 12) ^ (data[i] >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ CRC16_NIBBLE_TABLE[(crc >> 12) ^ (data[i] & 0x0F)]);
+  }
+  return crc;
+}
+
+/**
+ * @brief CRC of a v2 frame, computed with the crc field as zero
+ */
+static uint16_t wire_frame_crc(const uint8_t *frame, size_t len)
+{
+  static const uint8_t zeroCrc[sizeof(uint16_t)] = {0, 0};
+  uint16_t crc = wire_crc16(frame, offsetof(WireHeader, crc));
+  crc = wire_crc16(zeroCrc, sizeof(zeroCrc), crc);
+  return wire_crc16(frame + sizeof(WireHeader), len - sizeof(WireHeader), crc);
+}
+
+/**
+ * @brief Size of the message struct of a type (0 = unknown type)
+ */
+static size_t wire_message_size(uint8_t type)
+{
+  switch (type)
+  {
+  case WIRE_MASTER:
+    return sizeof(MessageMaster);
+  case WIRE_SLAVE:
+    return sizeof(MessageSlave);
+  case WIRE_SLAVE_MULTI:
+    return sizeof(MessageSlaveMulti);
+  case WIRE_SLAVE_BURST:
+    return sizeof(MessageSlaveBurst);
+  case WIRE_SLAVE_STREAM:
+    return sizeof(MessageSlaveStream);
+  case WIRE_RC:
+    return sizeof(MessageRC);
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Bytes of a message sent in v2: up to the last used sample
+ *
+ * Reads the sample count as a byte, so message may be an unaligned
+ * receive buffer.
+ *
+ * @return 0 for an unknown type or a sample count above the maximum
+ */
+static size_t wire_used_size(uint8_t type, const uint8_t *message)
+{
+  if (type == WIRE_SLAVE_BURST)
+  {
+    const uint8_t count = message[offsetof(MessageSlaveBurst, sampleCount)];
+    return count <= BURST_SAMPLES_PER_FRAME ? offsetof(MessageSlaveBurst, samples) + count * sizeof(BurstSample) : 0;
+  }
+  if (type == WIRE_SLAVE_STREAM)
+  {
+    const uint8_t count = message[offsetof(MessageSlaveStream, sampleCount)];
+    return count <= STREAM_SAMPLES_PER_FRAME ? offsetof(MessageSlaveStream, samples) + count * sizeof(StreamSample) : 0;
+  }
+  return wire_message_size(type);
+}
+
+/**
+ * @brief Bytes of a message in v1
+ */
+static size_t wire_v1_size(uint8_t type)
+{
+  switch (type)
+  {
+  case WIRE_MASTER:
+    return WIRE_V1_MASTER_SIZE;
+  case WIRE_SLAVE:
+    return WIRE_V1_SLAVE_SIZE;
+  default:
+    return wire_message_size(type);
+  }
+}
+
+/**
+ * @brief v1: the message is identified by its length alone
+ *
+ * The case labels fail to compile if two messages ever get the same size.
+ *
+ * @param used Set to the bytes that hold fields (without padding)
+ */
+static bool wire_v1_type(int len, WireType &type, size_t &used)
+{
+  used = (size_t)len;
+  switch (len)
+  {
+  case WIRE_V1_MASTER_SIZE:
+    type = WIRE_MASTER;
+    return true;
+  case WIRE_V1_SLAVE_SIZE:
+    type = WIRE_SLAVE;
+    used = offsetof(MessageSlave, vibrationRms);
+    return true;
+  case sizeof(MessageSlaveMulti):
+    type = WIRE_SLAVE_MULTI;
+    return true;
+  case sizeof(MessageSlaveBurst):
+    type = WIRE_SLAVE_BURST;
+    return true;
+  case sizeof(MessageSlaveStream):
+    type = WIRE_SLAVE_STREAM;
+    return true;
+  case sizeof(MessageRC):
+    type = WIRE_RC;
+    return true;
+  default:
+    return false;
+  }
+}
+
+void wire_peer_reset(WirePeer &peer, uint8_t version)
+{
+  peer.version = version;
+  peer.confirmed = false;
+  peer.unanswered = 0;
+  peer.v1Requests = 0;
+  // Random start, so the first frame after a reboot is not taken for a repeat
+  peer.txSequence = (uint16_t)wire_random();
+  peer.rxSequence = 0;
+  peer.rxSequenceValid = false;
+}
+
+bool wire_peer_accept(WirePeer &peer, uint8_t version, uint16_t sequence)
+{
+  if (version == WIRE_VERSION_1)
+  {
+    if (peer.version != WIRE_VERSION_1)
+    {
+      DEBUG_I("Peer sent protocol v1 - answering in v1");
+    }
+    peer.version = WIRE_VERSION_1;
+    peer.confirmed = false;
+    peer.unanswered = 0;
+    return true;
+  }
+
+  if (peer.rxSequenceValid && sequence == peer.rxSequence)
+  {
+    return false;
+  }
+  peer.rxSequence = sequence;
+  peer.rxSequenceValid = true;
+
+  if (!peer.confirmed)
+  {
+    DEBUG_I("Peer speaks protocol v%u", (unsigned)WIRE_VERSION);
+  }
+  peer.version = WIRE_VERSION;
+  peer.confirmed = true;
+  peer.unanswered = 0;
+  return true;
+}
+
+void wire_peer_request(WirePeer &peer)
+{
+  if (peer.version != WIRE_VERSION_1 || ++peer.v1Requests < WIRE_V1_REPROBE_REQUESTS)
+  {
+    return;
+  }
+
+  DEBUG_I("Re-probing protocol v%u after %u requests in v1", (unsigned)WIRE_VERSION, (unsigned)peer.v1Requests);
+  peer.version = WIRE_VERSION;
+  peer.confirmed = false;
+  peer.unanswered = WIRE_PROBE_MAX_UNANSWERED - 1;
+  peer.v1Requests = 0;
+}
+
+void wire_peer_no_reply(WirePeer &peer)
+{
+  if (peer.version != WIRE_VERSION || peer.confirmed)
+  {
+    return;
+  }
+
+  if (++peer.unanswered >= WIRE_PROBE_MAX_UNANSWERED)
+  {
+    LOG_WARNING(ERR_ESPNOW_UNSUPPORTED_VERSION, "No reply to %u protocol v%u requests - falling back to v1",
+      (unsigned)peer.unanswered, (unsigned)WIRE_VERSION);
+    peer.version = WIRE_VERSION_1;
+    peer.unanswered = 0;
+    peer.v1Requests = 0;
+  }
+}
+
+ErrorCode wire_decode(const uint8_t *data, int len, WireFrame &frame)
+{
+  if (data == nullptr || len <= 0)
+  {
+    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Empty ESP-NOW frame");
+    return ERR_ESPNOW_INVALID_LENGTH;
+  }
+
+  WireType v1Type = WIRE_MASTER;
+  size_t v1Used = 0;
+  const bool v1Length = wire_v1_type(len, v1Type, v1Used);
+
+  // A v1 message may start with the magic byte by chance: it is v2 only if
+  // the CRC agrees, otherwise a v1 length still decides
+  if (len >= (int)sizeof(WireHeader) && data[0] == WIRE_MAGIC)
+  {
+    WireHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.version == WIRE_VERSION && wire_frame_crc(data, len) == header.crc)
+    {
+      const size_t payloadLen = len - sizeof(WireHeader);
+      const size_t fullLen = wire_message_size(header.type);
+      if (fullLen == 0)
+      {
+        RECORD_ERROR(ERR_ESPNOW_UNSUPPORTED_VERSION, "Unknown v2 message type %u", (unsigned)header.type);
+        return ERR_ESPNOW_UNSUPPORTED_VERSION;
+      }
+
+      const size_t samplesOffset = header.type == WIRE_SLAVE_BURST ? offsetof(MessageSlaveBurst, samples)
+        : header.type == WIRE_SLAVE_STREAM ? offsetof(MessageSlaveStream, samples) : fullLen;
+      if (payloadLen < samplesOffset
+        || payloadLen != wire_used_size(header.type, data + sizeof(WireHeader)))
+      {
+        RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "v2 message type %u with %u payload bytes",
+          (unsigned)header.type, (unsigned)payloadLen);
+        return ERR_ESPNOW_INVALID_LENGTH;
+      }
+
+      frame.type = (WireType)header.type;
+      frame.version = WIRE_VERSION;
+      frame.flags = header.flags;
+      frame.sequence = header.sequence;
+      frame.payload = data + sizeof(WireHeader);
+      frame.length = (uint8_t)payloadLen;
+      return ERR_NONE;
+    }
+
+    if (!v1Length)
+    {
+      if (header.version != WIRE_VERSION)
+      {
+        RECORD_ERROR(ERR_ESPNOW_UNSUPPORTED_VERSION, "Protocol v%u frame, supported: v%u and v%u",
+          (unsigned)header.version, (unsigned)WIRE_VERSION_1, (unsigned)WIRE_VERSION);
+        return ERR_ESPNOW_UNSUPPORTED_VERSION;
+      }
+      RECORD_ERROR(ERR_ESPNOW_CRC_MISMATCH, "v2 frame of %d bytes, CRC 0x%04X != 0x%04X",
+        len, (unsigned)wire_frame_crc(data, len), (unsigned)header.crc);
+      return ERR_ESPNOW_CRC_MISMATCH;
+    }
+  }
+
+  if (!v1Length)
+  {
+    RECORD_ERROR(ERR_ESPNOW_INVALID_LENGTH, "Received packet length: %d (no v1 message, no v2 header)", len);
+    return ERR_ESPNOW_INVALID_LENGTH;
+  }
+
+  frame.type = v1Type;
+  frame.version = WIRE_VERSION_1;
+  frame.flags = 0;
+  frame.sequence = 0;
+  frame.payload = data;
+  frame.length = (uint8_t)v1Used;
+  return ERR_NONE;
+}
+
+size_t wire_encode(
+  WirePeer &peer,
+  WireType type,
+  uint8_t flags,
+  const void *message,
+  uint8_t *frame)
+{
+  const size_t usedLen = message != nullptr ? wire_used_size(type, (const uint8_t *)message) : 0;
+  if (usedLen == 0 || frame == nullptr)
+  {
+    RECORD_ERROR(ERR_VALIDATION_INVALID_PARAM, "Cannot encode message type %u", (unsigned)type);
+    return 0;
+  }
+
+  if (peer.version == WIRE_VERSION_1)
+  {
+    // The padding of the v1 MessageSlave is sent as zero
+    const size_t len = wire_v1_size(type);
+    const size_t fields = type == WIRE_SLAVE ? offsetof(MessageSlave, vibrationRms) : len;
+    memset(frame, 0, len);
+    memcpy(frame, message, fields);
+    return len;
+  }
+
+  WireHeader header{};
+  header.magic = WIRE_MAGIC;
+  header.version = WIRE_VERSION;
+  header.type = type;
+  header.flags = flags;
+  header.sequence = peer.txSequence++;
+  memcpy(frame, &header, sizeof(header));
+  memcpy(frame + sizeof(header), message, usedLen);
+
+  const size_t frameLen = sizeof(header) + usedLen;
+  header.crc = wire_frame_crc(frame, frameLen);
+  memcpy(frame + offsetof(WireHeader, crc), &header.crc, sizeof(header.crc));
+  return frameLen;
+}
+
+#if defined(ARDUINO)
+ErrorCode wire_send(
+  WirePeer &peer,
+  const uint8_t *mac,
+  WireType type,
+  uint8_t flags,
+  const void *message,
+  int max_retries,
+  int retry_delay_ms)
+{
+  uint8_t frame[WIRE_MAX_FRAME_SIZE];
+  const size_t frameLen = wire_encode(peer, type, flags, message, frame);
+  if (frameLen == 0)
+  {
+    return ERR_VALIDATION_INVALID_PARAM;
+  }
+
+  return espnow_send_with_retry(mac, frame, frameLen, max_retries, retry_delay_ms);
+}
+#endif
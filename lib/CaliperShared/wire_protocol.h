@@ -0,0 +1,237 @@
+/**
+ * @file wire_protocol.h
+ * @brief Versioned ESP-NOW wire format (v2) with v1 fallback
+ * @author System Generated
+ * @date 2026-10-16
+ * @version 1.2
+ *
+ * @version 1.1 - v2 re-probed during the v1 fallback, wire_encode() without ESP-NOW
+ * @version 1.2 - v1 is the message layout of the firmware before v2
+ *
+ * @details
+ * v1 (WIRE_VERSION_1) is what firmware before v2 sends: a bare struct,
+ * told apart by its length. Its MessageMaster (WIRE_V1_MASTER_SIZE bytes)
+ * and MessageSlave (WIRE_V1_SLAVE_SIZE bytes) end before every field added
+ * since; those fields are zero in a decoded v1 frame. Messages that old
+ * firmware does not know (multi, burst, stream) are sent as the bare
+ * struct. v2 (WIRE_VERSION) prefixes a packed WireHeader:
+ *
+ * | Byte | Field    | Notes                                           |
+ * |------|----------|-------------------------------------------------|
+ * | 0    | magic    | WIRE_MAGIC                                      |
+ * | 1    | version  | WIRE_VERSION                                    |
+ * | 2    | type     | WireType of the payload                         |
+ * | 3    | flags    | WireFlag bits, unknown bits are ignored         |
+ * | 4-5  | sequence | Per sender, +1 per frame, little endian         |
+ * | 6-7  | crc      | CRC-16/CCITT-FALSE of header (crc = 0) + payload|
+ *
+ * The payload is the message struct, cut after the last used sample for
+ * MessageSlaveBurst and MessageSlaveStream, so a short batch is a short
+ * frame. The layouts of the structs are pinned by the static_asserts below
+ * (every field is naturally aligned, so both ESP32 compilers agree; only
+ * BurstSample is packed).
+ *
+ * Negotiation (WirePeer): a receiver accepts both versions and answers in
+ * the version of the last frame it got from the peer. The master probes v2
+ * and falls back to v1 after WIRE_PROBE_MAX_UNANSWERED requests without
+ * reply, so a slave or RC with old firmware keeps working. The requests may
+ * just as well have been lost (slave out of range, still booting), and a v2
+ * slave answers the v1 fallback in v1, so every WIRE_V1_REPROBE_REQUESTS
+ * requests in v1 one is sent in v2 again (wire_peer_request()).
+ *
+ * Everything except wire_send() is plain C++ and builds on the host.
+ */
+
+#ifndef WIRE_PROTOCOL_H
+#define WIRE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "shared_common.h"
+#include "shared_config.h"
+#include "error_codes.h"
+
+/**
+ * @brief Message carried by a frame
+ */
+enum WireType : uint8_t
+{
+  WIRE_MASTER = 1,        /**< MessageMaster */
+  WIRE_SLAVE = 2,         /**< MessageSlave */
+  WIRE_SLAVE_MULTI = 3,   /**< MessageSlaveMulti */
+  WIRE_SLAVE_BURST = 4,   /**< MessageSlaveBurst, variable length */
+  WIRE_SLAVE_STREAM = 5,  /**< MessageSlaveStream, variable length */
+  WIRE_RC = 6             /**< MessageRC */
+};
+
+/**
+ * @brief WireHeader::flags bits
+ */
+enum WireFlag : uint8_t
+{
+  WIRE_FLAG_MORE = 0x01,        /**< More frames of the same reply follow (CMD_BURST) */
+  WIRE_FLAG_BEST_EFFORT = 0x02  /**< Sent once, never retried (telemetry) */
+};
+
+struct __attribute__((packed)) WireHeader
+{
+  uint8_t magic;
+  uint8_t version;
+  uint8_t type;
+  uint8_t flags;
+  uint16_t sequence;
+  uint16_t crc;
+};
+
+/**
+ * @brief A received frame, pointing into the receive buffer
+ *
+ * payload holds length bytes of the message struct; copy them into a
+ * zero-initialised struct (fields past length are unused samples).
+ */
+struct WireFrame
+{
+  WireType type;
+  uint8_t version;     /**< WIRE_VERSION_1 or WIRE_VERSION */
+  uint8_t flags;       /**< 0 for v1 */
+  uint16_t sequence;   /**< 0 for v1 */
+  const uint8_t *payload;
+  uint8_t length;
+};
+
+/**
+ * @brief Protocol state of one peer
+ */
+struct WirePeer
+{
+  uint8_t version;       /**< Version used when sending to the peer */
+  bool confirmed;        /**< A v2 frame was received from the peer */
+  uint8_t unanswered;    /**< Requests without reply while probing v2 */
+  uint8_t v1Requests;    /**< Requests sent in v1 since the fallback or the last re-probe */
+  uint16_t txSequence;   /**< Sequence of the next v2 frame sent */
+  uint16_t rxSequence;   /**< Sequence of the last v2 frame received */
+  bool rxSequenceValid;
+};
+
+/**
+ * @brief v1 MessageMaster: timeout .. motorTorque
+ */
+static constexpr size_t WIRE_V1_MASTER_SIZE = 8;
+
+/**
+ * @brief v1 MessageSlave: measurement .. angleZ and 2 padding bytes
+ */
+static constexpr size_t WIRE_V1_SLAVE_SIZE = 12;
+
+// Wire layout of the messages; a change here is a protocol change
+static_assert(sizeof(WireHeader) == 8, "WireHeader is 8 bytes on the wire");
+// The v1 layouts are prefixes of the current structs
+static_assert(offsetof(MessageMaster, rampUpMs) == WIRE_V1_MASTER_SIZE, "v1 MessageMaster layout");
+static_assert(offsetof(MessageSlave, vibrationRms) + 2 == WIRE_V1_SLAVE_SIZE, "v1 MessageSlave layout");
+static_assert(sizeof(MessageMaster) == 20 && offsetof(MessageMaster, requestId) == 19, "MessageMaster layout");
+static_assert(sizeof(MessageSlave) == 16 && offsetof(MessageSlave, requestId) == 14, "MessageSlave layout");
+static_assert(offsetof(MessageSlaveMulti, status) == 4 * RS485_MAX_PROBES + 11
+  && offsetof(MessageSlaveMulti, requestId) == 5 * RS485_MAX_PROBES + 11, "MessageSlaveMulti layout");
+static_assert(sizeof(BurstSample) == 7 && offsetof(BurstSample, status) == 6
+  && offsetof(MessageSlaveBurst, samples) == 12, "MessageSlaveBurst layout");
+static_assert(sizeof(StreamSample) == 8 && offsetof(MessageSlaveStream, samples) == 16, "MessageSlaveStream layout");
+static_assert(sizeof(MessageRC) == 1, "MessageRC layout");
+static_assert(sizeof(WireHeader) + sizeof(MessageSlaveBurst) <= ESPNOW_MAX_PAYLOAD
+  && sizeof(WireHeader) + sizeof(MessageSlaveStream) <= ESPNOW_MAX_PAYLOAD
+  && sizeof(WireHeader) + sizeof(MessageSlaveMulti) <= ESPNOW_MAX_PAYLOAD,
+  "v2 frames exceed the ESP-NOW payload");
+
+/**
+ * @brief Largest encoded frame (MessageSlaveBurst is the largest message)
+ */
+static constexpr size_t WIRE_MAX_FRAME_SIZE = sizeof(WireHeader) + sizeof(MessageSlaveBurst);
+static_assert(sizeof(MessageSlaveBurst) >= sizeof(MessageSlaveStream)
+  && sizeof(MessageSlaveBurst) >= sizeof(MessageSlaveMulti)
+  && sizeof(MessageSlaveBurst) >= sizeof(MessageMaster), "WIRE_MAX_FRAME_SIZE fits every message");
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), nibble table
+ */
+uint16_t wire_crc16(const uint8_t *data, size_t len, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Start over with a peer (boot, new pairing)
+ * @param version Version to send until the peer answers
+ */
+void wire_peer_reset(WirePeer &peer, uint8_t version);
+
+/**
+ * @brief Record a frame received from the peer
+ *
+ * The peer is answered in the version of this frame from now on.
+ *
+ * @return false for a v2 frame repeating the previous sequence (drop it)
+ */
+bool wire_peer_accept(WirePeer &peer, uint8_t version, uint16_t sequence);
+
+/**
+ * @brief A request is about to be sent to the peer (requester side only)
+ *
+ * After WIRE_V1_REPROBE_REQUESTS requests in v1 the next one goes out in
+ * v2; without a reply to it the peer is back on v1 (one lost request).
+ */
+void wire_peer_request(WirePeer &peer);
+
+/**
+ * @brief A request to the peer got no reply
+ *
+ * While v2 is not confirmed, WIRE_PROBE_MAX_UNANSWERED of these in a row
+ * switch the peer to v1.
+ */
+void wire_peer_no_reply(WirePeer &peer);
+
+/**
+ * @brief Parse a received ESP-NOW frame (v2 header or v1 length)
+ *
+ * Records the error itself, the caller only drops the frame.
+ *
+ * @return ERR_NONE, ERR_ESPNOW_CRC_MISMATCH, ERR_ESPNOW_UNSUPPORTED_VERSION
+ *         or ERR_ESPNOW_INVALID_LENGTH
+ */
+ErrorCode wire_decode(const uint8_t *data, int len, WireFrame &frame);
+
+/**
+ * @brief Encode a message in the peer's version
+ *
+ * @param peer Protocol state of the receiver (txSequence advances in v2)
+ * @param type Message type, selects the struct message points to
+ * @param flags WireFlag bits (v2 only)
+ * @param message The message struct
+ * @param frame Receives the frame, WIRE_MAX_FRAME_SIZE bytes
+ * @return Frame length, 0 for an unknown type or too many samples
+ */
+size_t wire_encode(
+  WirePeer &peer,
+  WireType type,
+  uint8_t flags,
+  const void *message,
+  uint8_t *frame
+);
+
+/**
+ * @brief Encode a message in the peer's version and send it
+ *
+ * @param peer Protocol state of the receiver (txSequence advances)
+ * @param mac Receiver address (may be the broadcast address)
+ * @param type Message type, selects the struct message points to
+ * @param flags WireFlag bits (v2 only)
+ * @param message The message struct
+ * @param max_retries esp_now_send() attempts (see espnow_send_with_retry)
+ * @return ERR_NONE or the error of espnow_send_with_retry
+ */
+ErrorCode wire_send(
+  WirePeer &peer,
+  const uint8_t *mac,
+  WireType type,
+  uint8_t flags,
+  const void *message,
+  int max_retries = ESPNOW_MAX_RETRIES,
+  int retry_delay_ms = ESPNOW_RETRY_DELAY_MS
+);
+
+#endif // WIRE_PROTOCOL_H